@@ -9,6 +9,9 @@
 
 #include <xaudio2.h>
 #include <assert.h>
+#include <mutex>
+#include <string>
+#include <vector>
 #include "audio.h"
 
 static IXAudio2* g_Xaudio{};
@@ -48,77 +51,153 @@ static AUDIO g_Audio[AUDIO_MAX]{};
 
 
 
-int LoadAudio(const char *FileName)
+// wav ǂŔg` new[] ŕԂBJȂ false
+static bool ReadWave(const char* FileName, WAVEFORMATEX* wfx, BYTE** data, int* length)
 {
-	int index = -1;
+	HMMIO hmmio = NULL;
+	MMIOINFO mmioinfo = { 0 };
+	MMCKINFO riffchunkinfo = { 0 };
+	MMCKINFO datachunkinfo = { 0 };
+	MMCKINFO mmckinfo = { 0 };
+	UINT32 buflen;
+	LONG readlen;
 
-	for (int i = 0; i < AUDIO_MAX; i++)
+
+	hmmio = mmioOpen((LPSTR)FileName, &mmioinfo, MMIO_READ);
+	if (!hmmio)
+		return false;
+
+	riffchunkinfo.fccType = mmioFOURCC('W', 'A', 'V', 'E');
+	mmioDescend(hmmio, &riffchunkinfo, NULL, MMIO_FINDRIFF);
+
+	mmckinfo.ckid = mmioFOURCC('f', 'm', 't', ' ');
+	mmioDescend(hmmio, &mmckinfo, &riffchunkinfo, MMIO_FINDCHUNK);
+
+	if (mmckinfo.cksize >= sizeof(WAVEFORMATEX))
 	{
-		if (g_Audio[i].SourceVoice == nullptr)
-		{
-			index = i;
-			break;
-		}
+		mmioRead(hmmio, (HPSTR)wfx, sizeof(*wfx));
 	}
+	else
+	{
+		PCMWAVEFORMAT pcmwf = { 0 };
+		mmioRead(hmmio, (HPSTR)&pcmwf, sizeof(pcmwf));
+		memset(wfx, 0x00, sizeof(*wfx));
+		memcpy(wfx, &pcmwf, sizeof(pcmwf));
+		wfx->cbSize = 0;
+	}
+	mmioAscend(hmmio, &mmckinfo, 0);
 
-	if (index == -1)
-		return -1;
+	datachunkinfo.ckid = mmioFOURCC('d', 'a', 't', 'a');
+	mmioDescend(hmmio, &datachunkinfo, &riffchunkinfo, MMIO_FINDCHUNK);
 
 
 
+	buflen = datachunkinfo.cksize;
+	*data = new unsigned char[buflen];
+	readlen = mmioRead(hmmio, (HPSTR)*data, buflen);
+	*length = readlen;
 
-	// TEhf[^Ǎ
-	WAVEFORMATEX wfx = { 0 };
 
-	{
-		HMMIO hmmio = NULL;
-		MMIOINFO mmioinfo = { 0 };
-		MMCKINFO riffchunkinfo = { 0 };
-		MMCKINFO datachunkinfo = { 0 };
-		MMCKINFO mmckinfo = { 0 };
-		UINT32 buflen;
-		LONG readlen;
+	mmioClose(hmmio, 0);
+	return true;
+}
 
 
-		hmmio = mmioOpen((LPSTR)FileName, &mmioinfo, MMIO_READ);
-		assert(hmmio);
+// ǂݍ݃Xbhœǂł waviLoadAudio {CX邾j
+struct PREFETCHED_WAVE
+{
+	std::string		FileName;
+	WAVEFORMATEX	Format{};
+	BYTE*			SoundData{};
+	int				Length{};
+};
+static std::vector<PREFETCHED_WAVE> g_Prefetched;
+static std::mutex g_PrefetchMutex;
 
-		riffchunkinfo.fccType = mmioFOURCC('W', 'A', 'V', 'E');
-		mmioDescend(hmmio, &riffchunkinfo, NULL, MMIO_FINDRIFF);
+static bool TakePrefetchedWave(const char* FileName, PREFETCHED_WAVE* out)
+{
+	std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+	for (size_t i = 0; i < g_Prefetched.size(); i++)
+	{
+		if (g_Prefetched[i].FileName != FileName)
+			continue;
+		*out = g_Prefetched[i];
+		g_Prefetched.erase(g_Prefetched.begin() + i);
+		return true;
+	}
+	return false;
+}
 
-		mmckinfo.ckid = mmioFOURCC('f', 'm', 't', ' ');
-		mmioDescend(hmmio, &mmckinfo, &riffchunkinfo, MMIO_FINDCHUNK);
 
-		if (mmckinfo.cksize >= sizeof(WAVEFORMATEX))
-		{
-			mmioRead(hmmio, (HPSTR)&wfx, sizeof(wfx));
-		}
-		else
+void PrefetchAudio(const char* FileName)
+{
+	if (!FileName)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+		for (const PREFETCHED_WAVE& w : g_Prefetched)
 		{
-			PCMWAVEFORMAT pcmwf = { 0 };
-			mmioRead(hmmio, (HPSTR)&pcmwf, sizeof(pcmwf));
-			memset(&wfx, 0x00, sizeof(wfx));
-			memcpy(&wfx, &pcmwf, sizeof(pcmwf));
-			wfx.cbSize = 0;
+			if (w.FileName == FileName)
+				return;
 		}
-		mmioAscend(hmmio, &mmckinfo, 0);
+	}
 
-		datachunkinfo.ckid = mmioFOURCC('d', 'a', 't', 'a');
-		mmioDescend(hmmio, &datachunkinfo, &riffchunkinfo, MMIO_FINDCHUNK);
+	PREFETCHED_WAVE wave;
+	wave.FileName = FileName;
+	if (!ReadWave(FileName, &wave.Format, &wave.SoundData, &wave.Length))
+		return;	// LoadAudio ǂǂ
 
+	std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+	g_Prefetched.push_back(wave);
+}
 
 
-		buflen = datachunkinfo.cksize;
-		g_Audio[index].SoundData = new unsigned char[buflen];
-		readlen = mmioRead(hmmio, (HPSTR)g_Audio[index].SoundData, buflen);
+void DiscardPrefetchedAudio()
+{
+	std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+	for (PREFETCHED_WAVE& w : g_Prefetched)
+	{
+		delete[] w.SoundData;
+	}
+	g_Prefetched.clear();
+}
 
 
-		g_Audio[index].Length = readlen;
-		g_Audio[index].PlayLength = readlen / wfx.nBlockAlign;
+int LoadAudio(const char *FileName)
+{
+	int index = -1;
+
+	for (int i = 0; i < AUDIO_MAX; i++)
+	{
+		if (g_Audio[i].SourceVoice == nullptr)
+		{
+			index = i;
+			break;
+		}
+	}
+
+	if (index == -1)
+		return -1;
+
 
 
-		mmioClose(hmmio, 0);
+
+	// TEhf[^Ǎiœǂł΂gj
+	WAVEFORMATEX wfx = { 0 };
+
+	PREFETCHED_WAVE wave;
+	if (TakePrefetchedWave(FileName, &wave))
+	{
+		wfx = wave.Format;
+		g_Audio[index].SoundData = wave.SoundData;
+		g_Audio[index].Length = wave.Length;
 	}
+	else
+	{
+		const bool read = ReadWave(FileName, &wfx, &g_Audio[index].SoundData, &g_Audio[index].Length);
+		assert(read);
+	}
+	g_Audio[index].PlayLength = g_Audio[index].Length / wfx.nBlockAlign;
 
 
 	// TEh\[X
@@ -202,4 +281,27 @@ void PlayAudio(int Index, bool Loop)
 }
 
 
+void StopAudio(int Index)
+{
+	if (Index < 0 || Index >= AUDIO_MAX)
+	{
+		return;
+	}
+
+	if (g_Audio[Index].SourceVoice == nullptr)
+	{
+		return;
+	}
+	g_Audio[Index].SourceVoice->Stop();
+	g_Audio[Index].SourceVoice->FlushSourceBuffers();
+}
+
 
+int GetAudioBytes(int Index)
+{
+	if (Index < 0 || Index >= AUDIO_MAX)
+	{
+		return 0;
+	}
+	return g_Audio[Index].Length;
+}
@@ -19,5 +19,11 @@ void UninitAudio();
 int LoadAudio(const char* FileName);
 void UnloadAudio(int Index);
 void PlayAudio(int Index, bool Loop = false);
+void StopAudio(int Index);
+int GetAudioBytes(int Index);	// g`f[^̃oCgiǂ߂ĂȂ 0j
+
+//  wav ǂłiǂ̃XbhłjBLoadAudio ͓t@Ĉ̂΂g
+void PrefetchAudio(const char* FileName);
+void DiscardPrefetchedAudio();	// gȂ̂̂Ă
 
 #endif//AUDIO_H
@@ -358,17 +358,13 @@ namespace
 
 
     //---------------------------------------------------------------------------------
-    HRESULT CreateTextureFromWIC(_In_ ID3D11Device* d3dDevice,
-        _In_opt_ ID3D11DeviceContext* d3dContext,
+    // Format selection, conversion and resize (no device context use, safe on any thread)
+    HRESULT DecodeFrame(_In_ ID3D11Device* d3dDevice,
+        _In_ bool mipAutogen,
         _In_ IWICBitmapFrameDecode* frame,
         _In_ size_t maxsize,
-        _In_ D3D11_USAGE usage,
-        _In_ unsigned int bindFlags,
-        _In_ unsigned int cpuAccessFlags,
-        _In_ unsigned int miscFlags,
         _In_ WIC_LOADER_FLAGS loadFlags,
-        _Outptr_opt_ ID3D11Resource** texture,
-        _Outptr_opt_ ID3D11ShaderResourceView** textureView) noexcept
+        _Out_ WICDecodedImage& image) noexcept
     {
         UINT width, height;
         HRESULT hr = frame->GetSize(&width, &height);
@@ -491,7 +487,7 @@ namespace
             bpp = WICBitsPerPixel(pixelFormat);
         }
 
-        if ((format == DXGI_FORMAT_R32G32B32_FLOAT) && d3dContext && textureView)
+        if ((format == DXGI_FORMAT_R32G32B32_FLOAT) && mipAutogen)
         {
             // Special case test for optional device support for autogen mipchains for R32G32B32_FLOAT
             UINT fmtSupport = 0;
@@ -681,6 +677,34 @@ namespace
                 return hr;
         }
 
+        image.width = twidth;
+        image.height = theight;
+        image.format = format;
+        image.rowPitch = rowPitch;
+        image.imageSize = imageSize;
+        image.pixels = std::move(temp);
+        return S_OK;
+    }
+
+    HRESULT CreateTextureFromImage(_In_ ID3D11Device* d3dDevice,
+        _In_opt_ ID3D11DeviceContext* d3dContext,
+        _In_ const WICDecodedImage& image,
+        _In_ D3D11_USAGE usage,
+        _In_ unsigned int bindFlags,
+        _In_ unsigned int cpuAccessFlags,
+        _In_ unsigned int miscFlags,
+        _Outptr_opt_ ID3D11Resource** texture,
+        _Outptr_opt_ ID3D11ShaderResourceView** textureView) noexcept
+    {
+        if (!image.pixels)
+            return E_INVALIDARG;
+
+        const DXGI_FORMAT format = image.format;
+        const size_t rowPitch = image.rowPitch;
+        const size_t imageSize = image.imageSize;
+        const uint8_t* temp = image.pixels.get();
+        HRESULT hr;
+
         // See if format is supported for auto-gen mipmaps (varies by feature level)
         bool autogen = false;
         if (d3dContext && textureView) // Must have context and shader-view to auto generate mipmaps
@@ -695,8 +719,8 @@ namespace
 
         // Create texture
         D3D11_TEXTURE2D_DESC desc = {};
-        desc.Width = twidth;
-        desc.Height = theight;
+        desc.Width = image.width;
+        desc.Height = image.height;
         desc.MipLevels = (autogen) ? 0u : 1u;
         desc.ArraySize = 1;
         desc.Format = format;
@@ -717,7 +741,7 @@ namespace
         }
 
         D3D11_SUBRESOURCE_DATA initData;
-        initData.pSysMem = temp.get();
+        initData.pSysMem = temp;
         initData.SysMemPitch = static_cast<UINT>(rowPitch);
         initData.SysMemSlicePitch = static_cast<UINT>(imageSize);
 
@@ -743,7 +767,7 @@ namespace
                 if (autogen)
                 {
                     assert(d3dContext != nullptr);
-                    d3dContext->UpdateSubresource(tex, 0, nullptr, temp.get(), static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize));
+                    d3dContext->UpdateSubresource(tex, 0, nullptr, temp, static_cast<UINT>(rowPitch), static_cast<UINT>(imageSize));
                     d3dContext->GenerateMips(*textureView);
                 }
             }
@@ -762,6 +786,29 @@ namespace
         return hr;
     }
 
+    HRESULT CreateTextureFromWIC(_In_ ID3D11Device* d3dDevice,
+        _In_opt_ ID3D11DeviceContext* d3dContext,
+        _In_ IWICBitmapFrameDecode* frame,
+        _In_ size_t maxsize,
+        _In_ D3D11_USAGE usage,
+        _In_ unsigned int bindFlags,
+        _In_ unsigned int cpuAccessFlags,
+        _In_ unsigned int miscFlags,
+        _In_ WIC_LOADER_FLAGS loadFlags,
+        _Outptr_opt_ ID3D11Resource** texture,
+        _Outptr_opt_ ID3D11ShaderResourceView** textureView) noexcept
+    {
+        WICDecodedImage image;
+        HRESULT hr = DecodeFrame(d3dDevice, d3dContext && textureView, frame, maxsize, loadFlags, image);
+        if (FAILED(hr))
+            return hr;
+
+        return CreateTextureFromImage(d3dDevice, d3dContext,
+            image,
+            usage, bindFlags, cpuAccessFlags, miscFlags,
+            texture, textureView);
+    }
+
 
     //--------------------------------------------------------------------------------------
     void SetDebugTextureInfo(
@@ -1074,3 +1121,124 @@ HRESULT DirectX::CreateWICTextureFromFileEx(
 
     return hr;
 }
+
+//--------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::DecodeWICImageFromFile(
+    ID3D11Device* d3dDevice,
+    const wchar_t* fileName,
+    WICDecodedImage& image) noexcept
+{
+    image = WICDecodedImage();
+
+    if (!d3dDevice || !fileName)
+        return E_INVALIDARG;
+
+    auto pWIC = GetWIC();
+    if (!pWIC)
+        return E_NOINTERFACE;
+
+    ComPtr<IWICBitmapDecoder> decoder;
+    HRESULT hr = pWIC->CreateDecoderFromFilename(fileName,
+        nullptr,
+        GENERIC_READ,
+        WICDecodeMetadataCacheOnDemand,
+        decoder.GetAddressOf());
+    if (FAILED(hr))
+        return hr;
+
+    ComPtr<IWICBitmapFrameDecode> frame;
+    hr = decoder->GetFrame(0, frame.GetAddressOf());
+    if (FAILED(hr))
+        return hr;
+
+    return DecodeFrame(d3dDevice, true, frame.Get(), 0, WIC_LOADER_DEFAULT, image);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::DecodeWICImageFromMemory(
+    ID3D11Device* d3dDevice,
+    const uint8_t* wicData,
+    size_t wicDataSize,
+    WICDecodedImage& image) noexcept
+{
+    image = WICDecodedImage();
+
+    if (!d3dDevice || !wicData)
+        return E_INVALIDARG;
+
+    if (!wicDataSize)
+        return E_FAIL;
+
+    if (wicDataSize > UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
+
+    auto pWIC = GetWIC();
+    if (!pWIC)
+        return E_NOINTERFACE;
+
+    ComPtr<IWICStream> stream;
+    HRESULT hr = pWIC->CreateStream(stream.GetAddressOf());
+    if (FAILED(hr))
+        return hr;
+
+    hr = stream->InitializeFromMemory(const_cast<uint8_t*>(wicData), static_cast<DWORD>(wicDataSize));
+    if (FAILED(hr))
+        return hr;
+
+    ComPtr<IWICBitmapDecoder> decoder;
+    hr = pWIC->CreateDecoderFromStream(stream.Get(), nullptr, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf());
+    if (FAILED(hr))
+        return hr;
+
+    ComPtr<IWICBitmapFrameDecode> frame;
+    hr = decoder->GetFrame(0, frame.GetAddressOf());
+    if (FAILED(hr))
+        return hr;
+
+    // The stream only borrows wicData, so finish the decode before returning
+    return DecodeFrame(d3dDevice, true, frame.Get(), 0, WIC_LOADER_DEFAULT, image);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::CreateWICTextureFromDecoded(
+    ID3D11Device* d3dDevice,
+    ID3D11DeviceContext* d3dContext,
+    const WICDecodedImage& image,
+    ID3D11Resource** texture,
+    ID3D11ShaderResourceView** textureView) noexcept
+{
+    if (texture)
+    {
+        *texture = nullptr;
+    }
+    if (textureView)
+    {
+        *textureView = nullptr;
+    }
+
+    if (!d3dDevice || (!texture && !textureView))
+    {
+        return E_INVALIDARG;
+    }
+
+    HRESULT hr = CreateTextureFromImage(d3dDevice, d3dContext,
+        image,
+        D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0,
+        texture, textureView);
+
+    if (SUCCEEDED(hr))
+    {
+        if (texture && *texture)
+        {
+            SetDebugObjectName(*texture, "WICTextureLoader");
+        }
+
+        if (textureView && *textureView)
+        {
+            SetDebugObjectName(*textureView, "WICTextureLoader");
+        }
+    }
+
+    return hr;
+}
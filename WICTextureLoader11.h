@@ -30,6 +30,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 namespace DirectX
 {
@@ -146,4 +147,34 @@ namespace DirectX
         _In_ WIC_LOADER_FLAGS loadFlags,
         _Outptr_opt_ ID3D11Resource** texture,
         _Outptr_opt_ ID3D11ShaderResourceView** textureView) noexcept;
+
+    // Two-step version: decode on any thread (no context use), create the texture later
+    // on the thread that owns d3dContext. Same format rules as CreateWICTextureFromFile.
+    struct WICDecodedImage
+    {
+        UINT width = 0;
+        UINT height = 0;
+        DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+        size_t rowPitch = 0;
+        size_t imageSize = 0;
+        std::unique_ptr<uint8_t[]> pixels;
+    };
+
+    HRESULT DecodeWICImageFromFile(
+        _In_ ID3D11Device* d3dDevice,
+        _In_z_ const wchar_t* szFileName,
+        _Out_ WICDecodedImage& image) noexcept;
+
+    HRESULT DecodeWICImageFromMemory(
+        _In_ ID3D11Device* d3dDevice,
+        _In_reads_bytes_(wicDataSize) const uint8_t* wicData,
+        _In_ size_t wicDataSize,
+        _Out_ WICDecodedImage& image) noexcept;
+
+    HRESULT CreateWICTextureFromDecoded(
+        _In_ ID3D11Device* d3dDevice,
+        _In_opt_ ID3D11DeviceContext* d3dContext,
+        _In_ const WICDecodedImage& image,
+        _Outptr_opt_ ID3D11Resource** texture,
+        _Outptr_opt_ ID3D11ShaderResourceView** textureView) noexcept;
 }
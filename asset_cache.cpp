@@ -0,0 +1,345 @@
+/*==============================================================================
+
+@@  AZbg̋L[asset_cache.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/18
+--------------------------------------------------------------------------------
+
+==============================================================================*/
+#include "asset_cache.h"
+#include "texture.h"
+#include "model.h"
+#include "model_skinned_fixed.h"
+#include "Audio.h"
+#include <Windows.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct AssetSlot
+    {
+        AssetType type = ASSET_TEXTURE;
+        std::string path;           // eNX`ȊO
+        std::wstring wpath;         // eNX`
+        float scale = 1.0f;
+        bool isBrender = false;
+
+        int refCount = 0;
+        unsigned int generation = 0;
+        bool used = false;
+
+        int index = -1;             // eNX`E̊Ǘԍ
+        MODEL* model = nullptr;
+        SKINNED_MODEL* skinned = nullptr;
+        size_t bytes = 0;
+    };
+
+    // \Ȃ̂Ő`ɒTiTexture_Load Ɠj
+    std::vector<AssetSlot> g_slots;
+    std::vector<unsigned int> g_freeSlots;
+    AssetStats g_stats[ASSET_TYPE_MAX];
+
+    AssetSlot* Resolve(AssetHandle h)
+    {
+        if (h.slot >= g_slots.size()) return nullptr;
+        AssetSlot& s = g_slots[h.slot];
+        if (!s.used || s.generation != h.generation) return nullptr;
+        return &s;
+    }
+
+    AssetHandle MakeHandle(unsigned int slot)
+    {
+        AssetHandle h;
+        h.slot = slot;
+        h.generation = g_slots[slot].generation;
+        return h;
+    }
+
+    // ΎQƂ𑫂ĕԂ
+    bool FindLoaded(AssetType type, const std::string& path, const std::wstring& wpath,
+        float scale, bool isBrender, AssetHandle* out)
+    {
+        for (unsigned int i = 0; i < (unsigned int)g_slots.size(); i++)
+        {
+            AssetSlot& s = g_slots[i];
+            if (!s.used || s.type != type) continue;
+            if (s.path != path || s.wpath != wpath) continue;
+            if (s.scale != scale || s.isBrender != isBrender) continue;
+
+            if (s.refCount == 0) g_stats[type].unused--;
+            s.refCount++;
+            g_stats[type].hits++;
+            *out = MakeHandle(i);
+            return true;
+        }
+        return false;
+    }
+
+    unsigned int AllocSlot()
+    {
+        if (!g_freeSlots.empty())
+        {
+            const unsigned int slot = g_freeSlots.back();
+            g_freeSlots.pop_back();
+            return slot;
+        }
+        g_slots.emplace_back();
+        return (unsigned int)g_slots.size() - 1;
+    }
+
+    AssetHandle AddSlot(AssetSlot&& loaded)
+    {
+        const unsigned int slot = AllocSlot();
+        const unsigned int generation = g_slots[slot].generation;
+
+        AssetSlot& s = g_slots[slot];
+        s = std::move(loaded);
+        s.generation = generation;
+        s.used = true;
+        s.refCount = 1;
+
+        AssetStats& st = g_stats[s.type];
+        st.resident++;
+        st.residentBytes += s.bytes;
+        return MakeHandle(slot);
+    }
+
+    void Unload(unsigned int slot)
+    {
+        AssetSlot& s = g_slots[slot];
+
+        switch (s.type)
+        {
+        case ASSET_TEXTURE:       Texture_Release(s.index); break;
+        case ASSET_MODEL:         ModelRelease(s.model); break;
+        case ASSET_SKINNED_MODEL: SkinnedModel_Release(s.skinned); break;
+        case ASSET_AUDIO:         UnloadAudio(s.index); break;
+        default: break;
+        }
+
+        AssetStats& st = g_stats[s.type];
+        st.resident--;
+        st.residentBytes -= s.bytes;
+        if (s.refCount == 0) st.unused--;
+
+        // i߂āAcĂnh𖳌ɂ
+        const unsigned int generation = s.generation + 1;
+        s = AssetSlot();
+        s.generation = generation;
+        g_freeSlots.push_back(slot);
+    }
+}
+
+void Asset_Finalize()
+{
+    for (unsigned int i = 0; i < (unsigned int)g_slots.size(); i++)
+    {
+        if (g_slots[i].used) Unload(i);
+    }
+    g_slots.clear();
+    g_freeSlots.clear();
+}
+
+AssetHandle Asset_LoadTexture(const wchar_t* path)
+{
+    AssetHandle h;
+    if (!path) return h;
+    if (FindLoaded(ASSET_TEXTURE, std::string(), path, 1.0f, false, &h)) return h;
+
+    g_stats[ASSET_TEXTURE].misses++;
+    const int texid = Texture_Load(path);
+    if (texid < 0) return h;
+
+    AssetSlot s;
+    s.type = ASSET_TEXTURE;
+    s.wpath = path;
+    s.index = texid;
+    s.bytes = Texture_GetBytes(texid);
+    return AddSlot(std::move(s));
+}
+
+AssetHandle Asset_LoadModel(const char* path, float scale, bool isBrender)
+{
+    AssetHandle h;
+    if (!path) return h;
+    if (FindLoaded(ASSET_MODEL, path, std::wstring(), scale, isBrender, &h)) return h;
+
+    g_stats[ASSET_MODEL].misses++;
+    MODEL* model = ModelLoad(path, scale, isBrender);
+    if (!model) return h;
+
+    AssetSlot s;
+    s.type = ASSET_MODEL;
+    s.path = path;
+    s.scale = scale;
+    s.isBrender = isBrender;
+    s.model = model;
+    s.bytes = Model_GetBytes(model);
+    return AddSlot(std::move(s));
+}
+
+AssetHandle Asset_LoadSkinnedModel(const char* path, float scale, bool isBrender)
+{
+    AssetHandle h;
+    if (!path) return h;
+    if (FindLoaded(ASSET_SKINNED_MODEL, path, std::wstring(), scale, isBrender, &h)) return h;
+
+    g_stats[ASSET_SKINNED_MODEL].misses++;
+    SKINNED_MODEL* model = SkinnedModel_Load(path, scale, isBrender);
+    if (!model) return h;
+
+    AssetSlot s;
+    s.type = ASSET_SKINNED_MODEL;
+    s.path = path;
+    s.scale = scale;
+    s.isBrender = isBrender;
+    s.skinned = model;
+    s.bytes = SkinnedModel_GetBytes(model);
+    return AddSlot(std::move(s));
+}
+
+AssetHandle Asset_LoadAudio(const char* path)
+{
+    AssetHandle h;
+    if (!path) return h;
+    if (FindLoaded(ASSET_AUDIO, path, std::wstring(), 1.0f, false, &h)) return h;
+
+    g_stats[ASSET_AUDIO].misses++;
+    const int index = LoadAudio(path);
+    if (index < 0) return h;
+
+    AssetSlot s;
+    s.type = ASSET_AUDIO;
+    s.path = path;
+    s.index = index;
+    s.bytes = (size_t)GetAudioBytes(index);
+    return AddSlot(std::move(s));
+}
+
+void Asset_Release(AssetHandle* handle)
+{
+    if (!handle) return;
+    AssetSlot* s = Resolve(*handle);
+    *handle = AssetHandle();
+    if (!s || s->refCount <= 0) return;
+
+    if (--s->refCount > 0) return;
+    g_stats[s->type].unused++;
+
+    // BGM ͒NĂȂΖ炳Ȃî CollectUnused ܂ő҂j
+    if (s->type == ASSET_AUDIO) StopAudio(s->index);
+}
+
+bool Asset_IsValid(AssetHandle handle)
+{
+    return Resolve(handle) != nullptr;
+}
+
+int Asset_GetTexture(AssetHandle handle)
+{
+    const AssetSlot* s = Resolve(handle);
+    return (s && s->type == ASSET_TEXTURE) ? s->index : -1;
+}
+
+MODEL* Asset_GetModel(AssetHandle handle)
+{
+    const AssetSlot* s = Resolve(handle);
+    return (s && s->type == ASSET_MODEL) ? s->model : nullptr;
+}
+
+SKINNED_MODEL* Asset_GetSkinnedModel(AssetHandle handle)
+{
+    const AssetSlot* s = Resolve(handle);
+    return (s && s->type == ASSET_SKINNED_MODEL) ? s->skinned : nullptr;
+}
+
+int Asset_GetAudio(AssetHandle handle)
+{
+    const AssetSlot* s = Resolve(handle);
+    return (s && s->type == ASSET_AUDIO) ? s->index : -1;
+}
+
+void Asset_CollectUnused()
+{
+    for (unsigned int i = 0; i < (unsigned int)g_slots.size(); i++)
+    {
+        if (!g_slots[i].used || g_slots[i].refCount > 0) continue;
+        g_stats[g_slots[i].type].evictions++;
+        Unload(i);
+    }
+}
+
+namespace
+{
+    bool IsResident(AssetType type, const std::string& path, const std::wstring& wpath)
+    {
+        for (const AssetSlot& s : g_slots)
+        {
+            if (s.used && s.type == type && s.path == path && s.wpath == wpath) return true;
+        }
+        return false;
+    }
+}
+
+void Asset_SkipResident(AssetPrefetchList* list)
+{
+    if (!list) return;
+
+    auto& tex = list->textures;
+    tex.erase(std::remove_if(tex.begin(), tex.end(), [](const std::wstring& p)
+        {
+            return Texture_IsLoaded(p.c_str());
+        }), tex.end());
+
+    auto& models = list->models;
+    models.erase(std::remove_if(models.begin(), models.end(), [](const std::string& p)
+        {
+            return IsResident(ASSET_MODEL, p, std::wstring()) || IsResident(ASSET_SKINNED_MODEL, p, std::wstring());
+        }), models.end());
+
+    auto& audio = list->audio;
+    audio.erase(std::remove_if(audio.begin(), audio.end(), [](const std::string& p)
+        {
+            return IsResident(ASSET_AUDIO, p, std::wstring());
+        }), audio.end());
+}
+
+void Asset_Prefetch(const AssetPrefetchList& list)
+{
+    // WIC ĝŁÃXbhł COM g悤ɂĂ
+    const HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+    for (const std::wstring& p : list.textures) Texture_Prefetch(p.c_str());
+    for (const std::string& p : list.models) Model_Prefetch(p.c_str());
+    for (const std::string& p : list.audio) PrefetchAudio(p.c_str());
+
+    if (SUCCEEDED(hr)) CoUninitialize();
+}
+
+void Asset_DiscardPrefetched()
+{
+    Texture_DiscardPrefetched();
+    Model_DiscardPrefetched();
+    DiscardPrefetchedAudio();
+}
+
+const AssetStats& Asset_GetStats(AssetType type)
+{
+    static const AssetStats kEmpty;
+    if (type < 0 || type >= ASSET_TYPE_MAX) return kEmpty;
+    return g_stats[type];
+}
+
+const char* Asset_GetTypeName(AssetType type)
+{
+    switch (type)
+    {
+    case ASSET_TEXTURE:       return "tex";
+    case ASSET_MODEL:         return "model";
+    case ASSET_SKINNED_MODEL: return "skin";
+    case ASSET_AUDIO:         return "audio";
+    default:                  return "?";
+    }
+}
@@ -0,0 +1,95 @@
+/*==============================================================================
+
+@@  AZbg̋L[asset_cache.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/18
+--------------------------------------------------------------------------------
+@@eNX`EfEXLfEpXňċLB
+@@Load ŎQ +1ARelease  -1B0 ɂȂĂɂ͏A
+@@Asset_CollectUnusediVXe[W̏IƂŌĂԁjŏB
+@@Ȃ̂ŃXe[W؂ւĂAŎĝ͓ǂݒȂB
+@@nh̓Xbgԍ{BAZbg̃nh͖ɂȂB
+@@CXbh炾ĂԂƁiAsset_Prefetch ͓ǂݍ݃XbhjB
+==============================================================================*/
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct MODEL;
+struct SKINNED_MODEL;
+
+enum AssetType
+{
+    ASSET_TEXTURE = 0,
+    ASSET_MODEL,
+    ASSET_SKINNED_MODEL,
+    ASSET_AUDIO,
+
+    ASSET_TYPE_MAX
+};
+
+// l͏ɖ
+struct AssetHandle
+{
+    unsigned int slot = 0xffffffffu;
+    unsigned int generation = 0;
+};
+
+inline bool operator==(const AssetHandle& a, const AssetHandle& b)
+{
+    return a.slot == b.slot && a.generation == b.generation;
+}
+inline bool operator!=(const AssetHandle& a, const AssetHandle& b) { return !(a == b); }
+
+struct AssetStats
+{
+    unsigned int hits = 0;          // ǂݍݍς݂̂̂Ԃ
+    unsigned int misses = 0;        // t@Cǂ񂾉
+    unsigned int evictions = 0;     // Asset_CollectUnused ŏ
+    unsigned int resident = 0;      // Ă鐔iQ 0 ŎcĂ̂܂ށj
+    unsigned int unused = 0;        // ̂Q 0 ̂
+    size_t residentBytes = 0;       // Ă镪̂悻̃oCg
+};
+
+void Asset_Finalize();              // QƂɊ֌WȂSiTexture_FinalizeEUninitAudio Oj
+
+// ǂ߂ȂΖȃnhBf scaleEisBrender ႦΕʕƂĎ
+AssetHandle Asset_LoadTexture(const wchar_t* path);
+AssetHandle Asset_LoadModel(const char* path, float scale, bool isBrender = false);
+AssetHandle Asset_LoadSkinnedModel(const char* path, float scale, bool isBrender = false);
+AssetHandle Asset_LoadAudio(const char* path);
+
+// QƂ 1  *handle 𖳌ɂB͎Q 0 Ŏ~߂
+void Asset_Release(AssetHandle* handle);
+bool Asset_IsValid(AssetHandle handle);
+
+// ȃnhE^ႢȂ -1 / nullptr
+int            Asset_GetTexture(AssetHandle handle);
+MODEL*         Asset_GetModel(AssetHandle handle);
+SKINNED_MODEL* Asset_GetSkinnedModel(AssetHandle handle);
+int            Asset_GetAudio(AssetHandle handle);
+
+// Q 0 ̂̂
+void Asset_CollectUnused();
+
+// ̃Xe[Wœǂރt@CBt@C̃fR[hɗōς܂Ă
+struct AssetPrefetchList
+{
+    std::vector<std::wstring> textures;
+    std::vector<std::string> models;        // ModelLoad / SkinnedModel_Load ̂ǂł
+    std::vector<std::string> audio;
+};
+// CXbhŁBẮiLoad t@Cǂ܂Ȃ́jO
+void Asset_SkipResident(AssetPrefetchList* list);
+// ǂ̃XbhłBfR[hʂ Texture_Load / ModelLoad / LoadAudio Ȃǂg
+void Asset_Prefetch(const AssetPrefetchList& list);
+// gȂfR[hʂ̂ĂiCXbhj
+void Asset_DiscardPrefetched();
+
+const AssetStats& Asset_GetStats(AssetType type);
+const char* Asset_GetTypeName(AssetType type);
+
+#endif // ASSET_CACHE_H
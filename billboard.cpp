@@ -111,21 +111,21 @@ void Billboard_Draw(int texId, const DirectX::XMFLOAT3& position,
 	const DirectX::XMFLOAT2& scale, const DirectX::XMUINT4& tex_cut, const DirectX::XMFLOAT4& color,
 	const DirectX::XMFLOAT2& pivot )
 {
-	float uv_x = (float)tex_cut.x / Texture_Width(texId);
-	float uv_y = (float)tex_cut.y / Texture_Height(texId);
-	float uv_w = (float)tex_cut.z / Texture_Width(texId);
-	float uv_h = (float)tex_cut.w / Texture_Height(texId);
+	Billboard_BeginPipeline();
 
-	ShaderBillboard_SetUVParameter({ { 1.0f ,1.0f },{0.0f,0.0f} });
+	//eNX`ݒ
+	Texture_SetTexture(texId);
 
+	Billboard_DrawBound(texId, position, scale, tex_cut, color, pivot);
+}
+
+void Billboard_BeginPipeline()
+{
 	ShaderBillboard_Begin();
 
 	// VF[_[`pCvCɐݒ
 	Shader3D_Begin();
 
-	//sNZVF[_ɐFݒ
-	Shader3d_SetColor(color);
-
 	// _obt@`pCvCɐݒ
 	UINT stride = sizeof(Vertex3d);
 	UINT offset = 0;
@@ -134,13 +134,23 @@ void Billboard_Draw(int texId, const DirectX::XMFLOAT3& position,
 	// CfbNXobt@`pCvCɐݒ
 	Direct3D_GetContext()->IASetIndexBuffer(g_pIndexBuffer, DXGI_FORMAT_R16_UINT, 0);//unsigned shortR16Aunsigned intR32
 
-
-	//eNX`ݒ
-	Texture_SetTexture(texId);
-
 	// v~eBug|Wݒ
 	Direct3D_GetContext()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+void Billboard_DrawBound(int texId, const DirectX::XMFLOAT3& position,
+	const DirectX::XMFLOAT2& scale, const DirectX::XMUINT4& tex_cut, const DirectX::XMFLOAT4& color,
+	const DirectX::XMFLOAT2& pivot)
+{
+	float uv_x = (float)tex_cut.x / Texture_Width(texId);
+	float uv_y = (float)tex_cut.y / Texture_Height(texId);
+	float uv_w = (float)tex_cut.z / Texture_Width(texId);
+	float uv_h = (float)tex_cut.w / Texture_Height(texId);
 
+	ShaderBillboard_SetUVParameter({ { 1.0f ,1.0f },{0.0f,0.0f} });
+
+	//sNZVF[_ɐFݒ
+	Shader3d_SetColor(color);
 
 	//Js̉]ts
 	//XMMATRIX iv = XMMatrixInverse(nullptr, XMLoadFloat4x4(&mtxCamera));  //ts̐͂Ȃd
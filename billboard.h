@@ -21,5 +21,12 @@ void Billboard_Draw(int texId, const DirectX::XMFLOAT3& position,
 	const DirectX::XMFLOAT4& color = { 1.0f,1.0f,1.0f,1.0f },
 	const DirectX::XMFLOAT2& pivot = { 0.0f,0.0f });
 
+// `L[pFpCvC̐ݒƃeNX`̐ݒ͍ς܂ĂOŕ`
+void Billboard_BeginPipeline();
+void Billboard_DrawBound(int texId, const DirectX::XMFLOAT3& position,
+	const DirectX::XMFLOAT2& scale, const DirectX::XMUINT4& tex_cut,
+	const DirectX::XMFLOAT4& color = { 1.0f,1.0f,1.0f,1.0f },
+	const DirectX::XMFLOAT2& pivot = { 0.0f,0.0f });
+
 void Billboard_SetViewMatrix(const DirectX::XMFLOAT4X4& view);
 #endif//BILLBOARD_H
\ No newline at end of file
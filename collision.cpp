@@ -8,31 +8,21 @@
 ==============================================================================*/
 
 #include"collision.h"
-#include"direct3d.h"
-#include"texture.h"
-#include"shader2d.h"
 #include<algorithm>
+#include<cfloat>
+#include<cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define COLLISION_USE_SSE 1
+#include<emmintrin.h>
+#if defined(__AVX2__)
+#define COLLISION_USE_AVX2 1
+#include<immintrin.h>
+#endif
+#endif
 
 using namespace DirectX;
 
-static constexpr int NUM_VERTEX = 5000; // _
-static ID3D11Buffer* g_pVertexBuffer = nullptr; // _obt@
-
-// ӁIŊOݒ肳́BReleasesvB
-static ID3D11Device* g_pDevice = nullptr;
-static ID3D11DeviceContext* g_pContext = nullptr;
-
-static int g_WhiteTexId = -1;
-
-// _\
-struct Vertex
-{
-	XMFLOAT3 position; // _W
-	XMFLOAT4  color;
-	XMFLOAT2 uv;//eNX`W
-	XMFLOAT2 texcoord;
-};
-
 bool Collision_IsOverlapSphere(const Sphere& a, const Sphere& b)
 {
 	XMVECTOR ac = XMLoadFloat3(&a.center);
@@ -179,137 +169,650 @@ Hit Collision_IsHitAABB(const AABB& a, const AABB& b)
 		return hit;*/
 }
 
+bool Collision_IntersectRayAABB(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir,
+	const AABB& box, float maxT, float* outT)
+{
+	float tmin = 0.0f;
+	float tmax = maxT;
+
+	const float o[3] = { origin.x, origin.y, origin.z };
+	const float d[3] = { dir.x, dir.y, dir.z };
+	const float mn[3] = { box.min.x, box.min.y, box.min.z };
+	const float mx[3] = { box.max.x, box.max.y, box.max.z };
+
+	for (int a = 0; a < 3; ++a)
+	{
+		if (std::fabs(d[a]) < 1.0e-8f)
+		{
+			// ɕsFXůOȂ瓖Ȃ
+			if (o[a] < mn[a] || o[a] > mx[a]) return false;
+			continue;
+		}
 
+		const float inv = 1.0f / d[a];
+		float t1 = (mn[a] - o[a]) * inv;
+		float t2 = (mx[a] - o[a]) * inv;
+		if (t1 > t2) std::swap(t1, t2);
 
+		tmin = std::max(tmin, t1);
+		tmax = std::min(tmax, t2);
+		if (tmin > tmax) return false;
+	}
+
+	if (outT) *outT = tmin;
+	return true;
+}
+
+
+// ===== SoA AABBɑ΂܂Ƃߔ =====
+namespace
+{
+	inline bool OverlapOne(const AABB& box, const AABBSoAView& soa, int i)
+	{
+		return box.min.x < soa.maxX[i] && box.max.x > soa.minX[i]
+			&& box.min.y < soa.maxY[i] && box.max.y > soa.minY[i]
+			&& box.min.z < soa.maxZ[i] && box.max.z > soa.minZ[i];
+	}
+
+#if defined(COLLISION_USE_AVX2)
+	constexpr int OVERLAP_LANES = 8;
+
+	// lanes ̏dȂrbgŕԂibit k = indices[k] ܂ base+kj
+	inline int OverlapMask(const AABB& box, const AABBSoAView& soa, const int* indices, int base)
+	{
+		__m256 mnX, mnY, mnZ, mxX, mxY, mxZ;
+		if (indices)
+		{
+			const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + base));
+			mnX = _mm256_i32gather_ps(soa.minX, idx, 4); mxX = _mm256_i32gather_ps(soa.maxX, idx, 4);
+			mnY = _mm256_i32gather_ps(soa.minY, idx, 4); mxY = _mm256_i32gather_ps(soa.maxY, idx, 4);
+			mnZ = _mm256_i32gather_ps(soa.minZ, idx, 4); mxZ = _mm256_i32gather_ps(soa.maxZ, idx, 4);
+		}
+		else
+		{
+			mnX = _mm256_loadu_ps(soa.minX + base); mxX = _mm256_loadu_ps(soa.maxX + base);
+			mnY = _mm256_loadu_ps(soa.minY + base); mxY = _mm256_loadu_ps(soa.maxY + base);
+			mnZ = _mm256_loadu_ps(soa.minZ + base); mxZ = _mm256_loadu_ps(soa.maxZ + base);
+		}
+
+		__m256 m = _mm256_and_ps(_mm256_cmp_ps(_mm256_set1_ps(box.min.x), mxX, _CMP_LT_OQ),
+			_mm256_cmp_ps(_mm256_set1_ps(box.max.x), mnX, _CMP_GT_OQ));
+		m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(box.min.y), mxY, _CMP_LT_OQ));
+		m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(box.max.y), mnY, _CMP_GT_OQ));
+		m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(box.min.z), mxZ, _CMP_LT_OQ));
+		m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_set1_ps(box.max.z), mnZ, _CMP_GT_OQ));
+		return _mm256_movemask_ps(m);
+	}
+#elif defined(COLLISION_USE_SSE)
+	constexpr int OVERLAP_LANES = 4;
+
+	inline __m128 Gather4(const float* a, const int* idx)
+	{
+		return _mm_set_ps(a[idx[3]], a[idx[2]], a[idx[1]], a[idx[0]]);
+	}
+
+	inline int OverlapMask(const AABB& box, const AABBSoAView& soa, const int* indices, int base)
+	{
+		__m128 mnX, mnY, mnZ, mxX, mxY, mxZ;
+		if (indices)
+		{
+			const int* idx = indices + base;
+			mnX = Gather4(soa.minX, idx); mxX = Gather4(soa.maxX, idx);
+			mnY = Gather4(soa.minY, idx); mxY = Gather4(soa.maxY, idx);
+			mnZ = Gather4(soa.minZ, idx); mxZ = Gather4(soa.maxZ, idx);
+		}
+		else
+		{
+			mnX = _mm_loadu_ps(soa.minX + base); mxX = _mm_loadu_ps(soa.maxX + base);
+			mnY = _mm_loadu_ps(soa.minY + base); mxY = _mm_loadu_ps(soa.maxY + base);
+			mnZ = _mm_loadu_ps(soa.minZ + base); mxZ = _mm_loadu_ps(soa.maxZ + base);
+		}
+
+		__m128 m = _mm_and_ps(_mm_cmplt_ps(_mm_set1_ps(box.min.x), mxX), _mm_cmpgt_ps(_mm_set1_ps(box.max.x), mnX));
+		m = _mm_and_ps(m, _mm_cmplt_ps(_mm_set1_ps(box.min.y), mxY));
+		m = _mm_and_ps(m, _mm_cmpgt_ps(_mm_set1_ps(box.max.y), mnY));
+		m = _mm_and_ps(m, _mm_cmplt_ps(_mm_set1_ps(box.min.z), mxZ));
+		m = _mm_and_ps(m, _mm_cmpgt_ps(_mm_set1_ps(box.max.z), mnZ));
+		return _mm_movemask_ps(m);
+	}
+#else
+	constexpr int OVERLAP_LANES = 1;
+
+	inline int OverlapMask(const AABB& box, const AABBSoAView& soa, const int* indices, int base)
+	{
+		return OverlapOne(box, soa, indices ? indices[base] : base) ? 1 : 0;
+	}
+#endif
+}
 
-void Collision_DebugInitialize(ID3D11Device* pDevice, ID3D11DeviceContext* pContext)
+int Collision_FindFirstOverlapAABB(const AABB& box, const AABBSoAView& soa,
+	const int* indices, int start, int count)
 {
-	// foCXƃfoCXReLXg̕ۑ
-	g_pDevice = pDevice;
-	g_pContext = pContext;
+	int k = (start < 0) ? 0 : start;
 
-	
-	// _obt@
-	D3D11_BUFFER_DESC bd = {};
-	bd.Usage = D3D11_USAGE_DYNAMIC;
-	bd.ByteWidth = sizeof(Vertex) * NUM_VERTEX;
-	bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	for (; k + OVERLAP_LANES <= count; k += OVERLAP_LANES)
+	{
+		const int mask = OverlapMask(box, soa, indices, k);
+		if (mask == 0) continue;
 
-	g_pDevice->CreateBuffer(&bd, NULL, &g_pVertexBuffer);
+		// ΂񉺂̃rbg΂Ǒ
+		int lane = 0;
+		while (((mask >> lane) & 1) == 0) ++lane;
+		return k + lane;
+	}
 
-	g_WhiteTexId = Texture_Load(L"white.png");
+	for (; k < count; ++k)
+	{
+		if (OverlapOne(box, soa, indices ? indices[k] : k)) return k;
+	}
+	return -1;
 }
 
-void Collision_DebugFinalize()
+int Collision_OverlapAABBBatch(const AABB& box, const AABBSoAView& soa,
+	const int* indices, int count, unsigned char* outHit)
 {
-	SAFE_RELEASE(g_pVertexBuffer);//_obt@̌Еt
+	if (!outHit) return 0;
+
+	int hits = 0;
+	int k = 0;
+
+	for (; k + OVERLAP_LANES <= count; k += OVERLAP_LANES)
+	{
+		const int mask = OverlapMask(box, soa, indices, k);
+		for (int lane = 0; lane < OVERLAP_LANES; ++lane)
+		{
+			const unsigned char h = (unsigned char)((mask >> lane) & 1);
+			outHit[k + lane] = h;
+			hits += h;
+		}
+	}
+
+	for (; k < count; ++k)
+	{
+		const unsigned char h = OverlapOne(box, soa, indices ? indices[k] : k) ? 1 : 0;
+		outHit[k] = h;
+		hits += h;
+	}
+	return hits;
 }
 
 
-//Փ˔͈͂o
-void Collision_DebugDraw(const Circle& circle, const DirectX::XMFLOAT4& color)
+// ===== XC[viAj =====
+namespace
 {
-	//_̐Zo
-  int numVertex = (int)(circle.radius * 2.0f * XM_PI);//~̒=_̐
+	//  aiamn..amxj d Ԃɔ b ɓ鎞߂iXu@jB
+	// Ȃ outT ɓAoutAxis ɍŌɓ
+	bool SweepInterval(const float amn[3], const float amx[3], const float d[3],
+		const float bmn[3], const float bmx[3], float* outT, int* outAxis)
+	{
+		float tEnter = -FLT_MAX;
+		float tExit = FLT_MAX;
+		int axis = -1;
+
+		for (int a = 0; a < 3; ++a)
+		{
+			if (std::fabs(d[a]) < 1.0e-8f)
+			{
+				// ĂȂFŏdȂĂȂΓȂiڂ邾͏j
+				if (!(amn[a] < bmx[a] && amx[a] > bmn[a])) return false;
+				continue;
+			}
+
+			const float inv = 1.0f / d[a];
+			float t1 = (bmn[a] - amx[a]) * inv;
+			float t2 = (bmx[a] - amn[a]) * inv;
+			if (t1 > t2) std::swap(t1, t2);
+
+			if (t1 > tEnter) { tEnter = t1; axis = a; }
+			tExit = std::min(tExit, t2);
+		}
 
-  // VF[_[`pCvCɐݒ
-  Shader2D_Begin();
+		// SĂȂiŏdȂĂjAOɏoA͈͊O
+		if (axis < 0) return false;
+		if (tEnter >= tExit) return false;
+		if (tEnter < 0.0f || tEnter > 1.0f) return false;
 
-  Shader2D_SetWorldMatrix(XMMatrixIdentity());
+		*outT = tEnter;
+		*outAxis = axis;
+		return true;
+	}
 
-  // _obt@bN
-  D3D11_MAPPED_SUBRESOURCE msr;
-  g_pContext->Map(g_pVertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &msr);
+	inline XMFLOAT3 SweepNormal(int axis, const float d[3])
+	{
+		XMFLOAT3 n{ 0.0f, 0.0f, 0.0f };
+		const float s = (d[axis] > 0.0f) ? -1.0f : 1.0f;
+		if (axis == 0) n.x = s;
+		else if (axis == 1) n.y = s;
+		else n.z = s;
+		return n;
+	}
+}
 
-  // _obt@ւ̉z|C^擾
-  Vertex* v = (Vertex*)msr.pData;
+bool Collision_SweepAABB(const AABB& box, const XMFLOAT3& delta, const AABB& target,
+	float* outT, XMFLOAT3* outNormal)
+{
+	const float amn[3] = { box.min.x, box.min.y, box.min.z };
+	const float amx[3] = { box.max.x, box.max.y, box.max.z };
+	const float d[3] = { delta.x, delta.y, delta.z };
+	const float bmn[3] = { target.min.x, target.min.y, target.min.z };
+	const float bmx[3] = { target.max.x, target.max.y, target.max.z };
+
+	float t = 1.0f;
+	int axis = -1;
+	if (!SweepInterval(amn, amx, d, bmn, bmx, &t, &axis)) return false;
+
+	if (outT) *outT = t;
+	if (outNormal) *outNormal = SweepNormal(axis, d);
+	return true;
+}
 
-  // _
-  const float SCREEN_WIDTH = (float)Direct3D_GetBackBufferWidth();
-  const float SCREEN_HEIGHT = (float)Direct3D_GetBackBufferHeight();
+SweepHit Collision_SweepAABB(const AABB& box, const XMFLOAT3& delta, const AABBSoAView& soa,
+	const int* indices, int count)
+{
+	SweepHit best;
+
+	const float amn[3] = { box.min.x, box.min.y, box.min.z };
+	const float amx[3] = { box.max.x, box.max.y, box.max.z };
+	const float d[3] = { delta.x, delta.y, delta.z };
+
+	float bestT = FLT_MAX;
+	int bestAxis = -1;
+
+	for (int k = 0; k < count; ++k)
+	{
+		const int i = indices ? indices[k] : k;
+		const float bmn[3] = { soa.minX[i], soa.minY[i], soa.minZ[i] };
+		const float bmx[3] = { soa.maxX[i], soa.maxY[i], soa.maxZ[i] };
+
+		float t;
+		int axis;
+		if (!SweepInterval(amn, amx, d, bmn, bmx, &t, &axis)) continue;
+		if (t >= bestT) continue;
+
+		bestT = t;
+		bestAxis = axis;
+		best.index = i;
+		if (t <= 0.0f) break; // 葁͖̂
+	}
 
-  const float rad = XM_2PI / numVertex;//1radPIŕ\
+	if (best.index >= 0)
+	{
+		best.hit = true;
+		best.t = bestT;
+		best.normal = SweepNormal(bestAxis, d);
+	}
+	return best;
+}
 
-  for (int i = 0;i < numVertex;i++) {
-	  v[i].position.x = cosf(rad * i) * circle.radius + circle.center.x;//x=cos*a+SW
-	  v[i].position.y = sinf(rad * i) * circle.radius + circle.center.y;
-	  v[i].position.z = 0;
-	  v[i].color = color;
-	  v[i].texcoord = { 0.0f,0.0f };
-  }
 
-  // _obt@̃bN
-  g_pContext->Unmap(g_pVertexBuffer, 0);
+// ===== IAABBc[ =====
+namespace
+{
+	inline AABB CombineAABB(const AABB& a, const AABB& b)
+	{
+		AABB r;
+		r.min = { std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z) };
+		r.max = { std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z) };
+		return r;
+	}
 
-  // _obt@`pCvCɐݒ
-  UINT stride = sizeof(Vertex);
-  UINT offset = 0;
-  g_pContext->IASetVertexBuffers(0, 1, &g_pVertexBuffer, &stride, &offset);
+	// \ʐς̔i}IԃRXgɎgj
+	inline float HalfArea(const AABB& a)
+	{
+		const float dx = a.max.x - a.min.x;
+		const float dy = a.max.y - a.min.y;
+		const float dz = a.max.z - a.min.z;
+		return dx * dy + dy * dz + dz * dx;
+	}
 
-  // _VF[_[ɕϊsݒ
-  Shader2D_SetProjectionMatrix(XMMatrixOrthographicOffCenterLH(0.0f, SCREEN_WIDTH, SCREEN_HEIGHT, 0.0f, 0.0f, 1.0f));
+	inline bool ContainsAABB(const AABB& outer, const AABB& inner)
+	{
+		return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z
+			&& inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+	}
 
-  // v~eBug|Wݒ
-  g_pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
+	// ڂĂ̂dȂ舵iXe[W̃u[htF[YƑj
+	inline bool TouchAABB(const AABB& a, const AABB& b)
+	{
+		return a.min.x <= b.max.x && a.max.x >= b.min.x
+			&& a.min.y <= b.max.y && a.max.y >= b.min.y
+			&& a.min.z <= b.max.z && a.max.z >= b.min.z;
+	}
 
-  //eNX`ݒ
-  //g_pContext->PSSetShaderResources(0, 1, &g_pTexture);
+	// TpX^bNBi͌Œ蒷őAꂽq[vɓ
+	class TreeStack
+	{
+	public:
+		void Push(int v)
+		{
+			if (m_count < FIXED) { m_fixed[m_count++] = v; return; }
+			m_heap.push_back(v);
+			++m_count;
+		}
+		int Pop()
+		{
+			--m_count;
+			if (m_count < FIXED) return m_fixed[m_count];
+			const int v = m_heap.back();
+			m_heap.pop_back();
+			return v;
+		}
+		bool Empty() const { return m_count == 0; }
+
+	private:
+		static constexpr int FIXED = 128;
+		int m_fixed[FIXED];
+		int m_count = 0;
+		std::vector<int> m_heap;
+	};
+}
 
-  // |S`施ߔs
-  g_pContext->Draw(numVertex, 0);
+DynamicAABBTree::DynamicAABBTree(float margin)
+	: m_margin(margin)
+{
 }
 
+int DynamicAABBTree::allocateNode()
+{
+	if (m_freeList < 0)
+	{
+		m_nodes.emplace_back();
+		return (int)m_nodes.size() - 1;
+	}
 
+	const int node = m_freeList;
+	m_freeList = m_nodes[node].parent;
+	m_nodes[node] = Node{};
+	return node;
+}
 
-void Collision_DebugDraw(const Box& box, const DirectX::XMFLOAT4& color)
+void DynamicAABBTree::freeNode(int node)
 {
+	m_nodes[node].parent = m_freeList;
+	m_nodes[node].height = -1;
+	m_freeList = node;
+}
+
+void DynamicAABBTree::Clear()
+{
+	m_nodes.clear();
+	m_root = -1;
+	m_freeList = -1;
+	m_proxyCount = 0;
+}
 
-	// VF[_[`pCvCɐݒ
-	Shader2D_Begin();
+int DynamicAABBTree::CreateProxy(const AABB& aabb, int userData)
+{
+	const int proxy = allocateNode();
 
-	Shader2D_SetWorldMatrix(XMMatrixIdentity());
+	Node& n = m_nodes[proxy];
+	n.aabb.min = { aabb.min.x - m_margin, aabb.min.y - m_margin, aabb.min.z - m_margin };
+	n.aabb.max = { aabb.max.x + m_margin, aabb.max.y + m_margin, aabb.max.z + m_margin };
+	n.userData = userData;
+	n.height = 0;
 
-	// _obt@bN
-	D3D11_MAPPED_SUBRESOURCE msr;
-	g_pContext->Map(g_pVertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &msr);
+	insertLeaf(proxy);
+	++m_proxyCount;
+	return proxy;
+}
 
-	// _obt@ւ̉z|C^擾
-	Vertex* v = (Vertex*)msr.pData;
+void DynamicAABBTree::DestroyProxy(int proxy)
+{
+	if (proxy < 0 || proxy >= (int)m_nodes.size() || !m_nodes[proxy].IsLeaf()) return;
 
-	// _
-	 // _
-	const float SCREEN_WIDTH = (float)Direct3D_GetBackBufferWidth();
-	const float SCREEN_HEIGHT = (float)Direct3D_GetBackBufferHeight();
+	removeLeaf(proxy);
+	freeNode(proxy);
+	--m_proxyCount;
+}
 
-	v[0].position = { box.center.x - box.half_width, box.center.y - box.half_height,0.0f };
-	v[1].position = { box.center.x - box.half_width, box.center.y - box.half_height,0.0f };
-	v[2].position = { box.center.x - box.half_width, box.center.y - box.half_height,0.0f };
-	v[3].position = { box.center.x - box.half_width, box.center.y - box.half_height,0.0f };
-	v[4].position = { box.center.x - box.half_width, box.center.y - box.half_height,0.0f };
+bool DynamicAABBTree::MoveProxy(int proxy, const AABB& aabb, const DirectX::XMFLOAT3& displacement)
+{
+	if (proxy < 0 || proxy >= (int)m_nodes.size() || !m_nodes[proxy].IsLeaf()) return false;
+
+	if (ContainsAABB(m_nodes[proxy].aabb, aabb)) return false;
+
+	removeLeaf(proxy);
+
+	// ]{isɈړʂ2{Ԃ肵đ点
+	AABB fat;
+	fat.min = { aabb.min.x - m_margin, aabb.min.y - m_margin, aabb.min.z - m_margin };
+	fat.max = { aabb.max.x + m_margin, aabb.max.y + m_margin, aabb.max.z + m_margin };
+
+	const float dx = 2.0f * displacement.x;
+	const float dy = 2.0f * displacement.y;
+	const float dz = 2.0f * displacement.z;
+	if (dx < 0.0f) fat.min.x += dx; else fat.max.x += dx;
+	if (dy < 0.0f) fat.min.y += dy; else fat.max.y += dy;
+	if (dz < 0.0f) fat.min.z += dz; else fat.max.z += dz;
+
+	m_nodes[proxy].aabb = fat;
+	insertLeaf(proxy);
+	return true;
+}
 
-	for (int i = 0;i < 5;i++) {
-		v[i].color = color;
-		v[i].uv = { 0.0f,0.0f };
+void DynamicAABBTree::insertLeaf(int leaf)
+{
+	if (m_root < 0)
+	{
+		m_root = leaf;
+		m_nodes[leaf].parent = -1;
+		return;
 	}
 
-	// _obt@̃bN
-	g_pContext->Unmap(g_pVertexBuffer, 0);
+	// \ʐςԑȂZT
+	const AABB leafAabb = m_nodes[leaf].aabb;
+	int index = m_root;
+	while (!m_nodes[index].IsLeaf())
+	{
+		const Node& n = m_nodes[index];
+		const int c1 = n.child1;
+		const int c2 = n.child2;
+
+		const float area = HalfArea(n.aabb);
+		const float combinedArea = HalfArea(CombineAABB(n.aabb, leafAabb));
+
+		// ɐVeRXgƁAƂɑ镪
+		const float cost = 2.0f * combinedArea;
+		const float inheritance = 2.0f * (combinedArea - area);
+
+		auto descendCost = [&](int c)
+			{
+				const AABB merged = CombineAABB(leafAabb, m_nodes[c].aabb);
+				if (m_nodes[c].IsLeaf()) return HalfArea(merged) + inheritance;
+				return (HalfArea(merged) - HalfArea(m_nodes[c].aabb)) + inheritance;
+			};
+
+		const float cost1 = descendCost(c1);
+		const float cost2 = descendCost(c2);
+
+		if (cost < cost1 && cost < cost2) break;
+
+		index = (cost1 < cost2) ? c1 : c2;
+	}
 
-	// _obt@`pCvCɐݒ
-	UINT stride = sizeof(Vertex);
-	UINT offset = 0;
-	g_pContext->IASetVertexBuffers(0, 1, &g_pVertexBuffer, &stride, &offset);
+	const int sibling = index;
+
+	// ZƐVt܂Ƃ߂e
+	const int oldParent = m_nodes[sibling].parent;
+	const int newParent = allocateNode();
+	m_nodes[newParent].parent = oldParent;
+	m_nodes[newParent].aabb = CombineAABB(leafAabb, m_nodes[sibling].aabb);
+	m_nodes[newParent].height = m_nodes[sibling].height + 1;
+	m_nodes[newParent].child1 = sibling;
+	m_nodes[newParent].child2 = leaf;
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf].parent = newParent;
+
+	if (oldParent >= 0)
+	{
+		if (m_nodes[oldParent].child1 == sibling) m_nodes[oldParent].child1 = newParent;
+		else m_nodes[oldParent].child2 = newParent;
+	}
+	else
+	{
+		m_root = newParent;
+	}
 
-	// _VF[_[ɕϊsݒ
-	Shader2D_SetProjectionMatrix(XMMatrixOrthographicOffCenterLH(0.0f, SCREEN_WIDTH, SCREEN_HEIGHT, 0.0f, 0.0f, 1.0f));
+	// ɌčAABB𒼂]Œނ荇킹
+	index = m_nodes[leaf].parent;
+	while (index >= 0)
+	{
+		index = balance(index);
 
-	// v~eBug|Wݒ
-	g_pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP);
+		Node& n = m_nodes[index];
+		n.height = 1 + std::max(m_nodes[n.child1].height, m_nodes[n.child2].height);
+		n.aabb = CombineAABB(m_nodes[n.child1].aabb, m_nodes[n.child2].aabb);
 
-	//eNX`ݒ
-	//g_pContext->PSSetShaderResources(0, 1, &g_pTexture);
+		index = n.parent;
+	}
+}
 
-	// |S`施ߔs
-	g_pContext->Draw(5, 0);
-};
\ No newline at end of file
+void DynamicAABBTree::removeLeaf(int leaf)
+{
+	if (leaf == m_root)
+	{
+		m_root = -1;
+		return;
+	}
+
+	const int parent = m_nodes[leaf].parent;
+	const int grandParent = m_nodes[parent].parent;
+	const int sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	if (grandParent >= 0)
+	{
+		// eČZcɒڂȂ
+		if (m_nodes[grandParent].child1 == parent) m_nodes[grandParent].child1 = sibling;
+		else m_nodes[grandParent].child2 = sibling;
+		m_nodes[sibling].parent = grandParent;
+		freeNode(parent);
+
+		int index = grandParent;
+		while (index >= 0)
+		{
+			index = balance(index);
+
+			Node& n = m_nodes[index];
+			n.height = 1 + std::max(m_nodes[n.child1].height, m_nodes[n.child2].height);
+			n.aabb = CombineAABB(m_nodes[n.child1].aabb, m_nodes[n.child2].aabb);
+
+			index = n.parent;
+		}
+	}
+	else
+	{
+		m_root = sibling;
+		m_nodes[sibling].parent = -1;
+		freeNode(parent);
+	}
+
+	m_nodes[leaf].parent = -1;
+}
+
+// a ̍E̍2ȏジĂ]B] a ̈ʒuɗm[hԂ
+int DynamicAABBTree::balance(int iA)
+{
+	Node& A = m_nodes[iA];
+	if (A.IsLeaf() || A.height < 2) return iA;
+
+	const int iB = A.child1;
+	const int iC = A.child2;
+	const int diff = m_nodes[iC].height - m_nodes[iB].height;
+
+	// q iUp グAЕ̎q iKeep Ƌ A  iUp ̉։
+	auto rotateUp = [&](int iUp, bool upIsChild2)->int
+		{
+			Node& U = m_nodes[iUp];
+			const int iF = U.child1;
+			const int iG = U.child2;
+
+			U.child1 = iA;
+			U.parent = m_nodes[iA].parent;
+			m_nodes[iA].parent = iUp;
+
+			if (U.parent >= 0)
+			{
+				if (m_nodes[U.parent].child1 == iA) m_nodes[U.parent].child1 = iUp;
+				else m_nodes[U.parent].child2 = iUp;
+			}
+			else
+			{
+				m_root = iUp;
+			}
+
+			const int iKeep = upIsChild2 ? m_nodes[iA].child1 : m_nodes[iA].child2;
+
+			// ̑ U ɎcAႢ A ɓn
+			int iHigh = iF, iLow = iG;
+			if (m_nodes[iF].height < m_nodes[iG].height) { iHigh = iG; iLow = iF; }
+
+			U.child2 = iHigh;
+			if (upIsChild2) m_nodes[iA].child2 = iLow;
+			else m_nodes[iA].child1 = iLow;
+			m_nodes[iLow].parent = iA;
+
+			m_nodes[iA].aabb = CombineAABB(m_nodes[iKeep].aabb, m_nodes[iLow].aabb);
+			m_nodes[iA].height = 1 + std::max(m_nodes[iKeep].height, m_nodes[iLow].height);
+
+			U.aabb = CombineAABB(m_nodes[iA].aabb, m_nodes[iHigh].aabb);
+			U.height = 1 + std::max(m_nodes[iA].height, m_nodes[iHigh].height);
+			return iUp;
+		};
+
+	if (diff > 1) return rotateUp(iC, true);
+	if (diff < -1) return rotateUp(iB, false);
+	return iA;
+}
+
+void DynamicAABBTree::Query(const AABB& aabb, QueryFunc func, void* user) const
+{
+	if (m_root < 0 || !func) return;
+
+	TreeStack stack;
+	stack.Push(m_root);
+
+	while (!stack.Empty())
+	{
+		const int index = stack.Pop();
+		const Node& n = m_nodes[index];
+		if (!TouchAABB(n.aabb, aabb)) continue;
+
+		if (n.IsLeaf())
+		{
+			if (!func(n.userData, user)) return;
+		}
+		else
+		{
+			stack.Push(n.child1);
+			stack.Push(n.child2);
+		}
+	}
+}
+
+void DynamicAABBTree::Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir, float maxT,
+	RaycastFunc func, void* user) const
+{
+	if (m_root < 0 || !func) return;
+
+	TreeStack stack;
+	stack.Push(m_root);
+
+	while (!stack.Empty())
+	{
+		const int index = stack.Pop();
+		const Node& n = m_nodes[index];
+		if (!Collision_IntersectRayAABB(origin, dir, n.aabb, maxT)) continue;
+
+		if (n.IsLeaf())
+		{
+			const float t = func(n.userData, maxT, user);
+			if (t < 0.0f) return;
+			maxT = std::min(maxT, t);
+		}
+		else
+		{
+			stack.Push(n.child1);
+			stack.Push(n.child2);
+		}
+	}
+}
@@ -10,8 +10,9 @@
 #ifndef COLLISION_H
 #define COLLISION_H
 
-#include<d3d11.h>
 #include<DirectXMath.h>
+#include<vector>
+#include<type_traits>
 
 struct Sphere {
 	DirectX::XMFLOAT3 center;
@@ -64,11 +65,135 @@ bool Collision_IsOverlapAABB(const AABB& a, const AABB& b);
 //âǂ̖ʂbՓ˂H
 Hit Collision_IsHitAABB(const AABB& a, const AABB& b);
 
-//{debugcollision.cpp
-void Collision_DebugInitialize(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
-void Collision_DebugFinalize();
-void Collision_DebugDraw(const Circle& circle, const DirectX::XMFLOAT4& color={1.0f,0.0f,0.0f,1.0f});
-void Collision_DebugDraw(const Box& box, const DirectX::XMFLOAT4& color = { 1.0f,0.0f,0.0f,1.0f });
+// C(origin + dir * t, 0 <= t <= maxT)AABB̌iXu@jBʒu t Ԃ
+// n_̒Ȃ t = 0
+bool Collision_IntersectRayAABB(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir,
+	const AABB& box, float maxT, float* outT = nullptr);
+
+
+// ===== SoA AABB =====
+// minX[] ... maxZ[] ʁX̔zŎi͕ʁB͌邾j
+struct AABBSoAView {
+	const float* minX = nullptr;
+	const float* minY = nullptr;
+	const float* minZ = nullptr;
+	const float* maxX = nullptr;
+	const float* maxY = nullptr;
+	const float* maxZ = nullptr;
+	int count = 0;
+};
+
+// box ƏdȂiCollision_IsOverlapAABB Ɠjŏ̌TB
+// indices[start..count) ̏ɌāAʒuiindices ̈ʒujԂB -1B
+// indices  nullptr Ȃ soa  [start, count) ̂܂܌B
+// SSE  4 iAVX2 ŃrhƂ 8 j肷
+int Collision_FindFirstOverlapAABB(const AABB& box, const AABBSoAView& soa,
+	const int* indices, int start, int count);
+
+// indices[0..count) ꂼɂďdȂ outHit  1/0 ŏB߂l͏dȂ
+int Collision_OverlapAABBBatch(const AABB& box, const AABBSoAView& soa,
+	const int* indices, int count, unsigned char* outHit);
+
+
+// ===== XC[viAj =====
+//  delta ƂɁA~܂Ă锠֍ŏɐG鎞߂B
+// t  delta ɑ΂銄i0..1jBڂĂ邾̔́A֐iނƂ t = 0 œB
+// ŏdȂĂ锠͓ɂȂi߂ Collision_IsHitAABB ̎dj
+struct SweepHit {
+	bool hit = false;
+	float t = 1.0f;
+	DirectX::XMFLOAT3 normal{ 0.0f, 0.0f, 0.0f }; // ʂ̖@i̔Oj
+	int index = -1;                               // isoa ̃CfbNXj
+};
+
+bool Collision_SweepAABB(const AABB& box, const DirectX::XMFLOAT3& delta, const AABB& target,
+	float* outT = nullptr, DirectX::XMFLOAT3* outNormal = nullptr);
+
+// indices[0..count) ̒ňԑ锠Ԃi t Ȃ̌jB
+// indices  nullptr Ȃ soa  [0, count) ̂܂܌
+SweepHit Collision_SweepAABB(const AABB& box, const DirectX::XMFLOAT3& delta, const AABBSoAView& soa,
+	const int* indices, int count);
+
+
+// ===== IAABBc[ =====
+// pBVHBtɂ͏点AABBĂA
+// 点͈͂̒œĂԂ̓c[gݑւȂB
+// ₢킹͑AABBɑ΂čŝŁAĂяoŖ{AABBƔ肵ƁB
+class DynamicAABBTree
+{
+public:
+	// false ԂƑł؂
+	typedef bool (*QueryFunc)(int userData, void* user);
+	// ߂lFȂł؂AȊO͈ȍ~̒TɎg maxTik߂ΎOTj
+	typedef float (*RaycastFunc)(int userData, float maxT, void* user);
+
+	explicit DynamicAABBTree(float margin = 0.1f);
+
+	int  CreateProxy(const AABB& aabb, int userData);
+	void DestroyProxy(int proxy);
+
+	// AABB͂ݏoƂ꒼ true ԂB
+	// displacement ͂̃t[̈ړʁiisɗ]ɑ点j
+	bool MoveProxy(int proxy, const AABB& aabb, const DirectX::XMFLOAT3& displacement);
+
+	void Clear();
+
+	int  GetUserData(int proxy) const { return m_nodes[proxy].userData; }
+	void SetUserData(int proxy, int userData) { m_nodes[proxy].userData = userData; }
+	const AABB& GetFatAABB(int proxy) const { return m_nodes[proxy].aabb; }
+	int  GetProxyCount() const { return m_proxyCount; }
+	int  GetHeight() const { return (m_root < 0) ? 0 : m_nodes[m_root].height; }
+
+	void Query(const AABB& aabb, QueryFunc func, void* user) const;
+	void Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir, float maxT,
+		RaycastFunc func, void* user) const;
+
+	// _
+	template<class Fn>
+	void Query(const AABB& aabb, Fn&& fn) const
+	{
+		using FnType = std::remove_reference_t<Fn>;
+		Query(aabb, [](int userData, void* user)->bool {
+			return (*static_cast<FnType*>(user))(userData);
+			}, const_cast<void*>(static_cast<const void*>(&fn)));
+	}
+
+	template<class Fn>
+	void Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir, float maxT, Fn&& fn) const
+	{
+		using FnType = std::remove_reference_t<Fn>;
+		Raycast(origin, dir, maxT, [](int userData, float t, void* user)->float {
+			return (*static_cast<FnType*>(user))(userData, t);
+			}, const_cast<void*>(static_cast<const void*>(&fn)));
+	}
+
+private:
+	struct Node
+	{
+		AABB aabb{};
+		int parent = -1;     // 󂫃m[ĥƂ͎̋󂫃m[h
+		int child1 = -1;
+		int child2 = -1;
+		int height = -1;     // t0A󂫂-1
+		int userData = -1;
+
+		bool IsLeaf() const { return child1 < 0; }
+	};
+
+	int  allocateNode();
+	void freeNode(int node);
+	void insertLeaf(int leaf);
+	void removeLeaf(int leaf);
+	int  balance(int a);
+
+	std::vector<Node> m_nodes;
+	int m_root = -1;
+	int m_freeList = -1;
+	int m_proxyCount = 0;
+	float m_margin = 0.1f;
+};
+
+// fobO\ collision_debug.h
 
 
 
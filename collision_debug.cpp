@@ -0,0 +1,165 @@
+/*==============================================================================
+
+@@@Փ˔̃fobO\[collision_debug.cpp]
+														 Author : Tanaka Kouki
+														 Date   : 2025/11/05
+--------------------------------------------------------------------------------
+@@@collision.cpp `敔́i{̂D3DɈˑȂj
+==============================================================================*/
+
+#include"collision_debug.h"
+#include"direct3d.h"
+#include"texture.h"
+#include"shader2d.h"
+
+using namespace DirectX;
+
+static constexpr int NUM_VERTEX = 5000; // _
+static ID3D11Buffer* g_pVertexBuffer = nullptr; // _obt@
+
+// ӁIŊOݒ肳́BReleasesvB
+static ID3D11Device* g_pDevice = nullptr;
+static ID3D11DeviceContext* g_pContext = nullptr;
+
+static int g_WhiteTexId = -1;
+
+// _\
+struct Vertex
+{
+	XMFLOAT3 position; // _W
+	XMFLOAT4  color;
+	XMFLOAT2 uv;//eNX`W
+	XMFLOAT2 texcoord;
+};
+
+void Collision_DebugInitialize(ID3D11Device* pDevice, ID3D11DeviceContext* pContext)
+{
+	// foCXƃfoCXReLXg̕ۑ
+	g_pDevice = pDevice;
+	g_pContext = pContext;
+
+	
+	// _obt@
+	D3D11_BUFFER_DESC bd = {};
+	bd.Usage = D3D11_USAGE_DYNAMIC;
+	bd.ByteWidth = sizeof(Vertex) * NUM_VERTEX;
+	bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+	g_pDevice->CreateBuffer(&bd, NULL, &g_pVertexBuffer);
+
+	g_WhiteTexId = Texture_Load(L"white.png");
+}
+
+void Collision_DebugFinalize()
+{
+	SAFE_RELEASE(g_pVertexBuffer);//_obt@̌Еt
+}
+
+
+//Փ˔͈͂o
+void Collision_DebugDraw(const Circle& circle, const DirectX::XMFLOAT4& color)
+{
+	//_̐Zo
+  int numVertex = (int)(circle.radius * 2.0f * XM_PI);//~̒=_̐
+
+  // VF[_[`pCvCɐݒ
+  Shader2D_Begin();
+
+  Shader2D_SetWorldMatrix(XMMatrixIdentity());
+
+  // _obt@bN
+  D3D11_MAPPED_SUBRESOURCE msr;
+  g_pContext->Map(g_pVertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &msr);
+
+  // _obt@ւ̉z|C^擾
+  Vertex* v = (Vertex*)msr.pData;
+
+  // _
+  const float SCREEN_WIDTH = (float)Direct3D_GetBackBufferWidth();
+  const float SCREEN_HEIGHT = (float)Direct3D_GetBackBufferHeight();
+
+  const float rad = XM_2PI / numVertex;//1radPIŕ\
+
+  for (int i = 0;i < numVertex;i++) {
+	  v[i].position.x = cosf(rad * i) * circle.radius + circle.center.x;//x=cos*a+SW
+	  v[i].position.y = sinf(rad * i) * circle.radius + circle.center.y;
+	  v[i].position.z = 0;
+	  v[i].color = color;
+	  v[i].texcoord = { 0.0f,0.0f };
+  }
+
+  // _obt@̃bN
+  g_pContext->Unmap(g_pVertexBuffer, 0);
+
+  // _obt@`pCvCɐݒ
+  UINT stride = sizeof(Vertex);
+  UINT offset = 0;
+  g_pContext->IASetVertexBuffers(0, 1, &g_pVertexBuffer, &stride, &offset);
+
+  // _VF[_[ɕϊsݒ
+  Shader2D_SetProjectionMatrix(XMMatrixOrthographicOffCenterLH(0.0f, SCREEN_WIDTH, SCREEN_HEIGHT, 0.0f, 0.0f, 1.0f));
+
+  // v~eBug|Wݒ
+  g_pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
+
+  //eNX`ݒ
+  //g_pContext->PSSetShaderResources(0, 1, &g_pTexture);
+
+  // |S`施ߔs
+  g_pContext->Draw(numVertex, 0);
+}
+
+
+
+void Collision_DebugDraw(const Box& box, const DirectX::XMFLOAT4& color)
+{
+
+	// VF[_[`pCvCɐݒ
+	Shader2D_Begin();
+
+	Shader2D_SetWorldMatrix(XMMatrixIdentity());
+
+	// _obt@bN
+	D3D11_MAPPED_SUBRESOURCE msr;
+	g_pContext->Map(g_pVertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &msr);
+
+	// _obt@ւ̉z|C^擾
+	Vertex* v = (Vertex*)msr.pData;
+
+	// _
+	 // _
+	const float SCREEN_WIDTH = (float)Direct3D_GetBackBufferWidth();
+	const float SCREEN_HEIGHT = (float)Direct3D_GetBackBufferHeight();
+
+	v[0].position = { box.center.x - box.half_width, box.center.y - box.half_height,0.0f };
+	v[1].position = { box.center.x - box.half_width, box.center.y - box.half_height,0.0f };
+	v[2].position = { box.center.x - box.half_width, box.center.y - box.half_height,0.0f };
+	v[3].position = { box.center.x - box.half_width, box.center.y - box.half_height,0.0f };
+	v[4].position = { box.center.x - box.half_width, box.center.y - box.half_height,0.0f };
+
+	for (int i = 0;i < 5;i++) {
+		v[i].color = color;
+		v[i].uv = { 0.0f,0.0f };
+	}
+
+	// _obt@̃bN
+	g_pContext->Unmap(g_pVertexBuffer, 0);
+
+	// _obt@`pCvCɐݒ
+	UINT stride = sizeof(Vertex);
+	UINT offset = 0;
+	g_pContext->IASetVertexBuffers(0, 1, &g_pVertexBuffer, &stride, &offset);
+
+	// _VF[_[ɕϊsݒ
+	Shader2D_SetProjectionMatrix(XMMatrixOrthographicOffCenterLH(0.0f, SCREEN_WIDTH, SCREEN_HEIGHT, 0.0f, 0.0f, 1.0f));
+
+	// v~eBug|Wݒ
+	g_pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP);
+
+	//eNX`ݒ
+	//g_pContext->PSSetShaderResources(0, 1, &g_pTexture);
+
+	// |S`施ߔs
+	g_pContext->Draw(5, 0);
+};
\ No newline at end of file
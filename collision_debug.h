@@ -0,0 +1,22 @@
+/*==============================================================================
+
+@@@Փ˔̃fobO\[collision_debug.h]
+														 Author : Tanaka Kouki
+														 Date   : 2025/11/05
+--------------------------------------------------------------------------------
+
+==============================================================================*/
+
+#ifndef COLLISION_DEBUG_H
+#define COLLISION_DEBUG_H
+
+#include<d3d11.h>
+#include<DirectXMath.h>
+#include"collision.h"
+
+void Collision_DebugInitialize(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
+void Collision_DebugFinalize();
+void Collision_DebugDraw(const Circle& circle, const DirectX::XMFLOAT4& color={1.0f,0.0f,0.0f,1.0f});
+void Collision_DebugDraw(const Box& box, const DirectX::XMFLOAT4& color = { 1.0f,0.0f,0.0f,1.0f });
+
+#endif//COLLISION_DEBUG_H
@@ -0,0 +1,448 @@
+/*==============================================================================
+
+@@  Xe[Wւ̃CE`LXg[collision_query.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/11
+--------------------------------------------------------------------------------
+
+==============================================================================*/
+#include "collision_query.h"
+#include "stage01_manage.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace
+{
+    enum class CastShape
+    {
+        Ray,
+        Sphere,
+        Box,
+    };
+
+    enum class CastMode
+    {
+        Closest,
+        Any,
+        All,
+    };
+
+    struct CastParams
+    {
+        CastShape shape = CastShape::Ray;
+        XMFLOAT3 origin{ 0,0,0 };
+        XMFLOAT3 dir{ 0,0,0 };      // Kς
+        float radius = 0.0f;        // Sphere
+        XMFLOAT3 half{ 0,0,0 };     // Box
+    };
+
+    inline float Dot3(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    inline XMFLOAT3 Sub3(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        return { a.x - b.x, a.y - b.y, a.z - b.z };
+    }
+
+    inline XMFLOAT3 PointAt(const CastParams& c, float t)
+    {
+        return { c.origin.x + c.dir.x * t, c.origin.y + c.dir.y * t, c.origin.z + c.dir.z * t };
+    }
+
+    // Cid ͐Kς݁jƔ [mn, mx]B t Ɠin_Ȃ -1jB
+    // ĂȂ͐ڂ邾ȂOAoĂriڂėjO
+    bool RaySlab(const float o[3], const float d[3], const float mn[3], const float mx[3], float maxT,
+        float* outT, int* outAxis)
+    {
+        float tmin = 0.0f;
+        float texit = FLT_MAX;
+        int axis = -1;
+
+        for (int a = 0; a < 3; ++a)
+        {
+            if (std::fabs(d[a]) < 1.0e-8f)
+            {
+                if (o[a] <= mn[a] || o[a] >= mx[a]) return false;
+                continue;
+            }
+
+            const float inv = 1.0f / d[a];
+            float t1 = (mn[a] - o[a]) * inv;
+            float t2 = (mx[a] - o[a]) * inv;
+            if (t1 > t2) std::swap(t1, t2);
+
+            if (t1 >= tmin) { tmin = t1; axis = a; }
+            texit = std::min(texit, t2);
+            if (tmin > texit || tmin > maxT) return false;
+        }
+
+        if (texit <= 0.0f) return false;
+
+        *outT = tmin;
+        *outAxis = axis;
+        return true;
+    }
+
+    inline XMFLOAT3 AxisNormal(int axis, const XMFLOAT3& d)
+    {
+        if (axis < 0) return { -d.x, -d.y, -d.z };
+
+        const float dv = (axis == 0) ? d.x : (axis == 1) ? d.y : d.z;
+        const float s = (dv > 0.0f) ? -1.0f : 1.0f;
+        if (axis == 0) return { s, 0.0f, 0.0f };
+        if (axis == 1) return { 0.0f, s, 0.0f };
+        return { 0.0f, 0.0f, s };
+    }
+
+    // CƋBn_Ȃ t = 0
+    bool RaySphere(const XMFLOAT3& o, const XMFLOAT3& d, const XMFLOAT3& center, float r, float maxT, float* outT)
+    {
+        const XMFLOAT3 m = Sub3(o, center);
+        const float b = Dot3(m, d);
+        const float c = Dot3(m, m) - r * r;
+        if (c <= 0.0f) { *outT = 0.0f; return true; }
+        if (b > 0.0f) return false;
+
+        const float disc = b * b - c;
+        if (disc < 0.0f) return false;
+
+        const float t = -b - std::sqrt(disc);
+        if (t > maxT) return false;
+        *outT = std::max(t, 0.0f);
+        return true;
+    }
+
+    // CƃJvZi a-bAa rj
+    bool RayCapsule(const XMFLOAT3& o, const XMFLOAT3& d, const XMFLOAT3& a, const XMFLOAT3& b, float r,
+        float maxT, float* outT)
+    {
+        const XMFLOAT3 ba = Sub3(b, a);
+        const XMFLOAT3 oa = Sub3(o, a);
+        const float baba = Dot3(ba, ba);
+        const float bard = Dot3(ba, d);
+        const float baoa = Dot3(ba, oa);
+        const float rdoa = Dot3(d, oa);
+        const float oaoa = Dot3(oa, oa);
+
+        float best = FLT_MAX;
+
+        // ́i~j
+        const float qa = baba - bard * bard;
+        if (qa > 1.0e-12f)
+        {
+            const float qb = baba * rdoa - baoa * bard;
+            const float qc = baba * oaoa - baoa * baoa - r * r * baba;
+            const float h = qb * qb - qa * qc;
+            if (h >= 0.0f)
+            {
+                const float t = (-qb - std::sqrt(h)) / qa;
+                const float y = baoa + t * bard;
+                if (t >= 0.0f && t <= maxT && y > 0.0f && y < baba) best = t;
+            }
+        }
+
+        // [̋
+        float t;
+        if (RaySphere(o, d, a, r, maxT, &t)) best = std::min(best, t);
+        if (RaySphere(o, d, b, r, maxT, &t)) best = std::min(best, t);
+
+        if (best == FLT_MAX) return false;
+        *outT = best;
+        return true;
+    }
+
+    inline XMFLOAT3 Corner(const float mn[3], const float mx[3], int bits)
+    {
+        return { (bits & 1) ? mx[0] : mn[0], (bits & 2) ? mx[1] : mn[1], (bits & 4) ? mx[2] : mn[2] };
+    }
+
+    // ƔF r 点pۂ̔ƃČB
+    // ܂pۂɂȂœAʒuӁEp̊OȂJvZŎ蒼
+    bool SphereVsBox(const CastParams& c, const float mn[3], const float mx[3], float maxT,
+        float* outT, XMFLOAT3* outN)
+    {
+        const float r = c.radius;
+        const float o[3] = { c.origin.x, c.origin.y, c.origin.z };
+        const float d[3] = { c.dir.x, c.dir.y, c.dir.z };
+        const float emn[3] = { mn[0] - r, mn[1] - r, mn[2] - r };
+        const float emx[3] = { mx[0] + r, mx[1] + r, mx[2] + r };
+
+        float t;
+        int axis;
+        if (!RaySlab(o, d, emn, emx, maxT, &t, &axis)) return false;
+
+        XMFLOAT3 p = PointAt(c, t);
+        const float pv[3] = { p.x, p.y, p.z };
+
+        // n_点̒F{ɋɐHł邩͍ŋߓ_̋Ō
+        float dist2 = 0.0f;
+        for (int a = 0; a < 3; ++a)
+        {
+            const float e = (pv[a] < mn[a]) ? mn[a] - pv[a] : (pv[a] > mx[a]) ? pv[a] - mx[a] : 0.0f;
+            dist2 += e * e;
+        }
+        const bool startInside = (t <= 0.0f && dist2 < r * r);
+
+        int u = 0, v = 0;
+        for (int a = 0; a < 3; ++a)
+        {
+            if (pv[a] < mn[a]) u |= (1 << a);
+            if (pv[a] > mx[a]) v |= (1 << a);
+        }
+        const int m = u | v;
+
+        if (!startInside && m != 0 && (m & (m - 1)) != 0)
+        {
+            // ӂp̂΁Fۂ߂Ŏ蒼
+            float best = FLT_MAX;
+            float tc;
+            if (m == 7)
+            {
+                const XMFLOAT3 cv = Corner(mn, mx, v);
+                for (int bit = 1; bit <= 4; bit <<= 1)
+                {
+                    if (RayCapsule(c.origin, c.dir, cv, Corner(mn, mx, v ^ bit), r, maxT, &tc))
+                        best = std::min(best, tc);
+                }
+            }
+            else
+            {
+                if (RayCapsule(c.origin, c.dir, Corner(mn, mx, u ^ 7), Corner(mn, mx, v), r, maxT, &tc))
+                    best = tc;
+            }
+            if (best == FLT_MAX) return false;
+            t = best;
+            p = PointAt(c, t);
+        }
+
+        // @͔̍ŋߓ_狅̒S
+        const XMFLOAT3 q{ std::clamp(p.x, mn[0], mx[0]), std::clamp(p.y, mn[1], mx[1]), std::clamp(p.z, mn[2], mx[2]) };
+        const XMFLOAT3 n = Sub3(p, q);
+        const float len = std::sqrt(Dot3(n, n));
+        if (len > 1.0e-6f)
+            *outN = { n.x / len, n.y / len, n.z / len };
+        else
+            *outN = AxisNormal((t > 0.0f) ? axis : -1, c.dir);
+
+        *outT = t;
+        return true;
+    }
+
+    // 1ubN̔
+    bool CastBlock(const CastParams& c, const AABBSoAView& soa, int i, float maxT, float* outT, XMFLOAT3* outN)
+    {
+        const float mn[3] = { soa.minX[i], soa.minY[i], soa.minZ[i] };
+        const float mx[3] = { soa.maxX[i], soa.maxY[i], soa.maxZ[i] };
+
+        // BubNi傫 0j͉߂ƓȂ
+        if (!(mx[0] > mn[0] && mx[1] > mn[1] && mx[2] > mn[2])) return false;
+
+        if (c.shape == CastShape::Sphere)
+            return SphereVsBox(c, mn, mx, maxT, outT, outN);
+
+        // CƔ͑点ƃCim̃~RtXL[a͂܂j
+        const XMFLOAT3 h = (c.shape == CastShape::Box) ? c.half : XMFLOAT3{ 0,0,0 };
+        const float o[3] = { c.origin.x, c.origin.y, c.origin.z };
+        const float d[3] = { c.dir.x, c.dir.y, c.dir.z };
+        const float emn[3] = { mn[0] - h.x, mn[1] - h.y, mn[2] - h.z };
+        const float emx[3] = { mx[0] + h.x, mx[1] + h.y, mx[2] + h.z };
+
+        int axis;
+        if (!RaySlab(o, d, emn, emx, maxT, outT, &axis)) return false;
+        *outN = AxisNormal(axis, c.dir);
+        return true;
+    }
+
+    // dir 𐳋KB 0 Ȃ false
+    bool Normalize(XMFLOAT3& d)
+    {
+        const float len = std::sqrt(Dot3(d, d));
+        if (!(len > 1.0e-8f)) return false;
+        d = { d.x / len, d.y / len, d.z / len };
+        return true;
+    }
+
+    // ʂ̖{́BClosest/Any  outHit ɁAAll  outAll ɋ߂œ
+    int RunCast(CastParams c, float maxDistance, CastMode mode, CastHit* outHit, std::vector<CastHit>* outAll)
+    {
+        if (outAll) outAll->clear();
+        if (!(maxDistance >= 0.0f) || !Normalize(c.dir)) return 0;
+
+        XMFLOAT3 half{ 0,0,0 };
+        if (c.shape == CastShape::Sphere) half = { c.radius, c.radius, c.radius };
+        else if (c.shape == CastShape::Box) half = c.half;
+
+        const AABBSoAView soa = Stage01_GetCollisionSoA().bounds;
+
+        CastHit best;
+        best.distance = FLT_MAX;
+        int hits = 0;
+
+        Stage01_QueryRay(c.origin, c.dir, maxDistance, half, [&](int i, float maxT) -> float
+            {
+                float t;
+                XMFLOAT3 n;
+                if (i >= soa.count || !CastBlock(c, soa, i, maxT, &t, &n)) return maxT;
+
+                ++hits;
+                if (mode == CastMode::All)
+                {
+                    CastHit h;
+                    h.index = i;
+                    h.distance = t;
+                    h.point = PointAt(c, t);
+                    h.normal = n;
+                    outAll->push_back(h);
+                    return maxT;
+                }
+
+                // ȂCfbNX̏i̗鏇ɍEȂ悤Ɂj
+                if (t < best.distance || (t == best.distance && i < best.index))
+                {
+                    best.index = i;
+                    best.distance = t;
+                    best.normal = n;
+                }
+                return (mode == CastMode::Any) ? -1.0f : t;
+            });
+
+        if (mode == CastMode::All)
+        {
+            std::sort(outAll->begin(), outAll->end(), [](const CastHit& a, const CastHit& b)
+                {
+                    if (a.distance != b.distance) return a.distance < b.distance;
+                    return a.index < b.index;
+                });
+            return (int)outAll->size();
+        }
+
+        if (best.index < 0) return 0;
+        best.point = PointAt(c, best.distance);
+        if (outHit) *outHit = best;
+        return hits;
+    }
+
+    CastParams MakeRay(const XMFLOAT3& origin, const XMFLOAT3& dir)
+    {
+        CastParams c;
+        c.shape = CastShape::Ray;
+        c.origin = origin;
+        c.dir = dir;
+        return c;
+    }
+
+    CastParams MakeSphere(const XMFLOAT3& origin, float radius, const XMFLOAT3& dir)
+    {
+        CastParams c;
+        c.shape = CastShape::Sphere;
+        c.origin = origin;
+        c.dir = dir;
+        c.radius = std::max(radius, 0.0f);
+        return c;
+    }
+
+    CastParams MakeBox(const XMFLOAT3& center, const XMFLOAT3& half, const XMFLOAT3& dir)
+    {
+        CastParams c;
+        c.shape = CastShape::Box;
+        c.origin = center;
+        c.dir = dir;
+        c.half = { std::fabs(half.x), std::fabs(half.y), std::fabs(half.z) };
+        return c;
+    }
+}
+
+// ===== C =====
+bool Collision_Raycast(const XMFLOAT3& origin, const XMFLOAT3& dir, float maxDistance, CastHit* outHit)
+{
+    return RunCast(MakeRay(origin, dir), maxDistance, CastMode::Closest, outHit, nullptr) > 0;
+}
+
+bool Collision_RaycastAny(const XMFLOAT3& origin, const XMFLOAT3& dir, float maxDistance)
+{
+    return RunCast(MakeRay(origin, dir), maxDistance, CastMode::Any, nullptr, nullptr) > 0;
+}
+
+int Collision_RaycastAll(const XMFLOAT3& origin, const XMFLOAT3& dir, float maxDistance, std::vector<CastHit>& outHits)
+{
+    return RunCast(MakeRay(origin, dir), maxDistance, CastMode::All, nullptr, &outHits);
+}
+
+// =====  =====
+bool Collision_SphereCast(const XMFLOAT3& origin, float radius, const XMFLOAT3& dir, float maxDistance, CastHit* outHit)
+{
+    return RunCast(MakeSphere(origin, radius, dir), maxDistance, CastMode::Closest, outHit, nullptr) > 0;
+}
+
+bool Collision_SphereCastAny(const XMFLOAT3& origin, float radius, const XMFLOAT3& dir, float maxDistance)
+{
+    return RunCast(MakeSphere(origin, radius, dir), maxDistance, CastMode::Any, nullptr, nullptr) > 0;
+}
+
+int Collision_SphereCastAll(const XMFLOAT3& origin, float radius, const XMFLOAT3& dir, float maxDistance,
+    std::vector<CastHit>& outHits)
+{
+    return RunCast(MakeSphere(origin, radius, dir), maxDistance, CastMode::All, nullptr, &outHits);
+}
+
+bool Collision_SphereCastBlock(int index, const XMFLOAT3& origin, float radius, const XMFLOAT3& dir, float maxDistance,
+    CastHit* outHit)
+{
+    CastParams c = MakeSphere(origin, radius, dir);
+    if (!(maxDistance >= 0.0f) || !Normalize(c.dir)) return false;
+
+    const AABBSoAView soa = Stage01_GetCollisionSoA().bounds;
+    if (index < 0 || index >= soa.count || !Stage01_IsBlockEnabled(index)) return false;
+
+    float t;
+    XMFLOAT3 n;
+    if (!CastBlock(c, soa, index, maxDistance, &t, &n)) return false;
+
+    if (outHit)
+    {
+        outHit->index = index;
+        outHit->distance = t;
+        outHit->point = PointAt(c, t);
+        outHit->normal = n;
+    }
+    return true;
+}
+
+// =====  =====
+bool Collision_BoxCast(const XMFLOAT3& center, const XMFLOAT3& half, const XMFLOAT3& dir, float maxDistance,
+    CastHit* outHit)
+{
+    return RunCast(MakeBox(center, half, dir), maxDistance, CastMode::Closest, outHit, nullptr) > 0;
+}
+
+bool Collision_BoxCastAny(const XMFLOAT3& center, const XMFLOAT3& half, const XMFLOAT3& dir, float maxDistance)
+{
+    return RunCast(MakeBox(center, half, dir), maxDistance, CastMode::Any, nullptr, nullptr) > 0;
+}
+
+int Collision_BoxCastAll(const XMFLOAT3& center, const XMFLOAT3& half, const XMFLOAT3& dir, float maxDistance,
+    std::vector<CastHit>& outHits)
+{
+    return RunCast(MakeBox(center, half, dir), maxDistance, CastMode::All, nullptr, &outHits);
+}
+
+// ===== ܂Ƃ߂ =====
+int Collision_RaycastBatch(const CastRay* rays, int count, CastHit* outHits)
+{
+    if (!rays || !outHits) return 0;
+
+    // u[htF[Y̍ƃobt@1Ȃ̂ŏԂɗ
+    int hits = 0;
+    for (int r = 0; r < count; ++r)
+    {
+        outHits[r] = CastHit{};
+        if (RunCast(MakeRay(rays[r].origin, rays[r].dir), rays[r].maxDistance, CastMode::Closest, &outHits[r], nullptr) > 0)
+            ++hits;
+    }
+    return hits;
+}
@@ -0,0 +1,68 @@
+/*==============================================================================
+
+@@  Xe[Wւ̃CE`LXg[collision_query.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/11
+--------------------------------------------------------------------------------
+@@Xe[W̃ubNiStage01jɑ΂ăCEE΂B
+@@̓u[htF[YiStage01_QueryRayjOɂ炤̂ŁA
+@@ԎOTƂ͓艜̃Z͌ȂB
+@@傫 0 ̃ubNisɉB́j͓ȂB
+==============================================================================*/
+#ifndef COLLISION_QUERY_H
+#define COLLISION_QUERY_H
+
+#include <DirectXMath.h>
+#include <vector>
+
+struct CastHit
+{
+    int index = -1;                                 // ubNiStage01_Get ňjBO -1
+    float distance = 0.0f;                          // n_瓖ʒu܂
+    DirectX::XMFLOAT3 point{ 0.0f, 0.0f, 0.0f };    // Ƃ̌`̒S
+    DirectX::XMFLOAT3 normal{ 0.0f, 0.0f, 0.0f };   // ʂ̖@iubNOj
+};
+
+struct CastRay
+{
+    DirectX::XMFLOAT3 origin;
+    DirectX::XMFLOAT3 dir;      // KȂĂ悢
+    float maxDistance;
+};
+
+// dir ͐KȂĂ悢BmaxDistance ̓[h̒B
+// n_ŏubN̒Ȃ distance = 0A@ -dirB
+// ڂĂ邾̃ubŃA֐iނƂ
+
+// ԎO
+bool Collision_Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir, float maxDistance,
+    CastHit* outHit = nullptr);
+// ǂꂩɓ邩iԎOƂ͌ȂBՕ̊mFpj
+bool Collision_RaycastAny(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir, float maxDistance);
+// ̑Si߂jB߂l͐
+int Collision_RaycastAll(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir, float maxDistance,
+    std::vector<CastHit>& outHits);
+
+bool Collision_SphereCast(const DirectX::XMFLOAT3& origin, float radius, const DirectX::XMFLOAT3& dir,
+    float maxDistance, CastHit* outHit = nullptr);
+bool Collision_SphereCastAny(const DirectX::XMFLOAT3& origin, float radius, const DirectX::XMFLOAT3& dir,
+    float maxDistance);
+int Collision_SphereCastAll(const DirectX::XMFLOAT3& origin, float radius, const DirectX::XMFLOAT3& dir,
+    float maxDistance, std::vector<CastHit>& outHits);
+
+// 1ubNɔ΂iO񓖂ubN܂m߂Ƃpj
+bool Collision_SphereCastBlock(int index, const DirectX::XMFLOAT3& origin, float radius, const DirectX::XMFLOAT3& dir,
+    float maxDistance, CastHit* outHit = nullptr);
+
+// ɕsȔicenter } halfj΂
+bool Collision_BoxCast(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& half, const DirectX::XMFLOAT3& dir,
+    float maxDistance, CastHit* outHit = nullptr);
+bool Collision_BoxCastAny(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& half, const DirectX::XMFLOAT3& dir,
+    float maxDistance);
+int Collision_BoxCastAll(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& half, const DirectX::XMFLOAT3& dir,
+    float maxDistance, std::vector<CastHit>& outHits);
+
+// ܂Ƃ߂āFoutHits[i]  rays[i] ̈ԎOiO index = -1jB߂l͓
+int Collision_RaycastBatch(const CastRay* rays, int count, CastHit* outHits);
+
+#endif // COLLISION_QUERY_H
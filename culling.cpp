@@ -0,0 +1,237 @@
+/*==============================================================================
+
+@@  EJO[culling.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/09
+--------------------------------------------------------------------------------
+
+==============================================================================*/
+#include "culling.h"
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define CULLING_USE_SSE 1
+#include <xmmintrin.h>
+#else
+#define CULLING_USE_SSE 0
+#endif
+
+using namespace DirectX;
+
+namespace
+{
+    struct ViewState
+    {
+        bool active = false;
+        Frustum frustum{};
+        XMFLOAT3 eye{ 0,0,0 };
+        float maxDistance = 0.0f;
+        CullStats stats{};
+    };
+
+    ViewState g_views[CULL_VIEW_COUNT];
+
+    inline XMFLOAT4 NormalizePlane(float a, float b, float c, float d)
+    {
+        const float len = std::sqrt(a * a + b * b + c * c);
+        const float inv = (len > 0.0f) ? 1.0f / len : 0.0f;
+        return { a * inv, b * inv, c * inv, d * inv };
+    }
+
+    // 1i[P̔pj
+    inline bool TestOne(const Frustum& f, float mnX, float mnY, float mnZ, float mxX, float mxY, float mxZ,
+        const XMFLOAT3& eye, float maxDistSq)
+    {
+        for (const XMFLOAT4& p : f.planes)
+        {
+            // ʂ̖@ɂ΂oĂ钸_OȂ甠ƊO
+            const float px = (p.x >= 0.0f) ? mxX : mnX;
+            const float py = (p.y >= 0.0f) ? mxY : mnY;
+            const float pz = (p.z >= 0.0f) ? mxZ : mnZ;
+            if (p.x * px + p.y * py + p.z * pz + p.w < 0.0f) return false;
+        }
+
+        if (maxDistSq > 0.0f)
+        {
+            // ̒ł΂߂_܂ł̋
+            const float dx = std::fmax(std::fmax(mnX - eye.x, eye.x - mxX), 0.0f);
+            const float dy = std::fmax(std::fmax(mnY - eye.y, eye.y - mxY), 0.0f);
+            const float dz = std::fmax(std::fmax(mnZ - eye.z, eye.z - mxZ), 0.0f);
+            if (dx * dx + dy * dy + dz * dz > maxDistSq) return false;
+        }
+        return true;
+    }
+}
+
+void CullBoundsSoA::Resize(size_t n)
+{
+    minX.resize(n); minY.resize(n); minZ.resize(n);
+    maxX.resize(n); maxY.resize(n); maxZ.resize(n);
+}
+
+void CullBoundsSoA::Set(size_t i, const AABB& aabb)
+{
+    minX[i] = aabb.min.x; minY[i] = aabb.min.y; minZ[i] = aabb.min.z;
+    maxX[i] = aabb.max.x; maxY[i] = aabb.max.y; maxZ[i] = aabb.max.z;
+}
+
+AABBSoAView CullBoundsSoA::View() const
+{
+    AABBSoAView v;
+    v.minX = minX.data(); v.minY = minY.data(); v.minZ = minZ.data();
+    v.maxX = maxX.data(); v.maxY = maxY.data(); v.maxZ = maxZ.data();
+    v.count = (int)minX.size();
+    return v;
+}
+
+void Culling_BuildFrustum(const XMMATRIX& view, const XMMATRIX& proj, Frustum* out)
+{
+    if (!out) return;
+
+    XMFLOAT4X4 m;
+    XMStoreFloat4x4(&m, view * proj);
+
+    //  j = (_1j, _2j, _3j, _4j)
+    out->planes[0] = NormalizePlane(m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41); // left
+    out->planes[1] = NormalizePlane(m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41); // right
+    out->planes[2] = NormalizePlane(m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42); // bottom
+    out->planes[3] = NormalizePlane(m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42); // top
+    out->planes[4] = NormalizePlane(m._13, m._23, m._33, m._43);                                 // near
+    out->planes[5] = NormalizePlane(m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43); // far
+}
+
+bool Culling_TestAABB(const Frustum& frustum, const AABB& aabb)
+{
+    return TestOne(frustum, aabb.min.x, aabb.min.y, aabb.min.z, aabb.max.x, aabb.max.y, aabb.max.z,
+        { 0,0,0 }, 0.0f);
+}
+
+int Culling_TestAABBs(const Frustum& frustum, const AABBSoAView& bounds,
+    const XMFLOAT3& eye, float maxDistance, uint8_t* outVisible)
+{
+    const int count = bounds.count;
+    if (!outVisible || count <= 0) return 0;
+
+    const float maxDistSq = (maxDistance > 0.0f) ? maxDistance * maxDistance : 0.0f;
+    const float* mnX = bounds.minX; const float* mnY = bounds.minY; const float* mnZ = bounds.minZ;
+    const float* mxX = bounds.maxX; const float* mxY = bounds.maxY; const float* mxZ = bounds.maxZ;
+
+    int visible = 0;
+    int i = 0;
+
+#if CULLING_USE_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 ex = _mm_set1_ps(eye.x), ey = _mm_set1_ps(eye.y), ez = _mm_set1_ps(eye.z);
+    const __m128 dist2 = _mm_set1_ps(maxDistSq);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 bMnX = _mm_loadu_ps(mnX + i), bMnY = _mm_loadu_ps(mnY + i), bMnZ = _mm_loadu_ps(mnZ + i);
+        const __m128 bMxX = _mm_loadu_ps(mxX + i), bMxY = _mm_loadu_ps(mxY + i), bMxZ = _mm_loadu_ps(mxZ + i);
+
+        // 4 ܂Ƃ߂āAǂꂩ̕ʂ̊OɏoĂO
+        __m128 outside = zero;
+        for (const XMFLOAT4& p : frustum.planes)
+        {
+            const __m128 px = (p.x >= 0.0f) ? bMxX : bMnX;
+            const __m128 py = (p.y >= 0.0f) ? bMxY : bMnY;
+            const __m128 pz = (p.z >= 0.0f) ? bMxZ : bMnZ;
+            __m128 d = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(p.x)), _mm_mul_ps(py, _mm_set1_ps(p.y)));
+            d = _mm_add_ps(d, _mm_mul_ps(pz, _mm_set1_ps(p.z)));
+            d = _mm_add_ps(d, _mm_set1_ps(p.w));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(d, zero));
+        }
+
+        if (maxDistSq > 0.0f)
+        {
+            const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(bMnX, ex), _mm_sub_ps(ex, bMxX)), zero);
+            const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(bMnY, ey), _mm_sub_ps(ey, bMxY)), zero);
+            const __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(bMnZ, ez), _mm_sub_ps(ez, bMxZ)), zero);
+            const __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            outside = _mm_or_ps(outside, _mm_cmpgt_ps(d2, dist2));
+        }
+
+        const int mask = _mm_movemask_ps(outside);
+        for (int k = 0; k < 4; ++k)
+        {
+            const uint8_t v = ((mask >> k) & 1) ? 0 : 1;
+            outVisible[i + k] = v;
+            visible += v;
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        const bool v = TestOne(frustum, mnX[i], mnY[i], mnZ[i], mxX[i], mxY[i], mxZ[i], eye, maxDistSq);
+        outVisible[i] = v ? 1 : 0;
+        visible += v ? 1 : 0;
+    }
+    return visible;
+}
+
+void Culling_SetView(CullView view, const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix,
+    const XMFLOAT3& eye, float maxDistance)
+{
+    if (view < 0 || view >= CULL_VIEW_COUNT) return;
+
+    ViewState& v = g_views[view];
+    Culling_BuildFrustum(viewMatrix, projMatrix, &v.frustum);
+    v.eye = eye;
+    v.maxDistance = maxDistance;
+    v.active = true;
+    v.stats = {};
+}
+
+void Culling_DisableView(CullView view)
+{
+    if (view < 0 || view >= CULL_VIEW_COUNT) return;
+    g_views[view].active = false;
+    g_views[view].stats = {};
+}
+
+bool Culling_IsViewActive(CullView view)
+{
+    if (view < 0 || view >= CULL_VIEW_COUNT) return false;
+    return g_views[view].active;
+}
+
+int Culling_TestView(CullView view, const AABBSoAView& bounds, uint8_t* outVisible)
+{
+    const int count = bounds.count;
+    if (!outVisible || count <= 0) return 0;
+
+    if (view < 0 || view >= CULL_VIEW_COUNT || !g_views[view].active)
+    {
+        for (int i = 0; i < count; ++i) outVisible[i] = 1;
+        return count;
+    }
+
+    ViewState& v = g_views[view];
+    const int visible = Culling_TestAABBs(v.frustum, bounds, v.eye, v.maxDistance, outVisible);
+    v.stats.tested += count;
+    v.stats.visible += visible;
+    v.stats.culled += count - visible;
+    return visible;
+}
+
+bool Culling_TestViewAABB(CullView view, const AABB& aabb)
+{
+    if (view < 0 || view >= CULL_VIEW_COUNT || !g_views[view].active) return true;
+
+    ViewState& v = g_views[view];
+    const float maxDistSq = (v.maxDistance > 0.0f) ? v.maxDistance * v.maxDistance : 0.0f;
+    const bool visible = TestOne(v.frustum, aabb.min.x, aabb.min.y, aabb.min.z,
+        aabb.max.x, aabb.max.y, aabb.max.z, v.eye, maxDistSq);
+    ++v.stats.tested;
+    if (visible) ++v.stats.visible;
+    else ++v.stats.culled;
+    return visible;
+}
+
+const CullStats& Culling_GetStats(CullView view)
+{
+    static const CullStats kEmpty{};
+    if (view < 0 || view >= CULL_VIEW_COUNT) return kEmpty;
+    return g_views[view].stats;
+}
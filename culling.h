@@ -0,0 +1,76 @@
+/*==============================================================================
+
+@@  EJO[culling.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/09
+--------------------------------------------------------------------------------
+@@`O AABB iJ^Cgjƕ`拗ŐU蕪B
+@@܂Ƃ߂Ĕ肷ł SoAiminX[] ... maxZ[]j 4  SSE Ŕ肷B
+==============================================================================*/
+#ifndef CULLING_H
+#define CULLING_H
+
+#include "collision.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+constexpr float CULL_DEFAULT_DRAW_DISTANCE = 300.0f;
+
+enum CullView
+{
+    CULL_VIEW_CAMERA = 0,   // CJ
+    CULL_VIEW_SHADOW,       // CgJie𗎂Ƃ́j
+
+    CULL_VIEW_COUNT
+};
+
+// ʂ (a,b,c,d)Aa*x + b*y + c*z + d >= 0 
+struct Frustum
+{
+    DirectX::XMFLOAT4 planes[6];
+};
+
+// p AABB iSoAj
+struct CullBoundsSoA
+{
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+
+    void Resize(size_t n);
+    void Set(size_t i, const AABB& aabb);
+    size_t Size() const { return minX.size(); }
+    AABBSoAView View() const;
+};
+
+struct CullStats
+{
+    int tested = 0;
+    int visible = 0;
+    int culled = 0;
+};
+
+// view * projisxNgALHAz  0..1j 6 ʂo
+void Culling_BuildFrustum(const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& proj, Frustum* out);
+
+bool Culling_TestAABB(const Frustum& frustum, const AABB& aabb);
+
+// outVisible[i]  1ij/ 0 BmaxDistance <= 0 Ȃ狗ł͐؂ȂB
+// ߂l͌鐔
+int Culling_TestAABBs(const Frustum& frustum, const AABBSoAView& bounds,
+    const DirectX::XMFLOAT3& eye, float maxDistance, uint8_t* outVisible);
+
+// ===== `摤gr[ =====
+// t[`Oɐݒ肷Bݒ肵r[̓v͂ 0 ɖ߂
+void Culling_SetView(CullView view, const DirectX::XMMATRIX& viewMatrix, const DirectX::XMMATRIX& projMatrix,
+    const DirectX::XMFLOAT3& eye, float maxDistance = 0.0f);
+void Culling_DisableView(CullView view);   // Ȍセ̃r[ł͑S鈵
+bool Culling_IsViewActive(CullView view);
+
+// r[ȂS 1 ɂBvɂ
+int  Culling_TestView(CullView view, const AABBSoAView& bounds, uint8_t* outVisible);
+bool Culling_TestViewAABB(CullView view, const AABB& aabb);
+
+const CullStats& Culling_GetStats(CullView view);
+
+#endif//CULLING_H
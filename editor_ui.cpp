@@ -10,6 +10,7 @@
 #include "imgui.h"
 #include "stage01_manage.h"
 #include "stage_cube.h"
+#include "stage_binary.h"
 #include "player_sensors.h"
 #include "player.h"
 #include <cstdio>
@@ -22,13 +23,13 @@
 #include <cmath>
 
 
-static int s_selected = -1;
+static StageBlockHandle s_selected;   // 폜EǉŃCfbNXւĂubNw
 
 static std::string s_exportText;
 static bool s_exportCopied = false;
 
 static char s_jsonPath[260] = "stage01.json";
-static char s_ioStatus[128] = "";
+static char s_ioStatus[400] = "";
 
 // ===== Kind Editor state =====
 static int s_selectedKind = 0;
@@ -697,6 +698,10 @@ void PlayerUI_Draw()
         ImGui::EndTable();
     }
 
+    ImGui::Checkbox("Continuous Collision", &t->continuousCollision);
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Sweep the move against blocks so fast falls/dashes do not tunnel.");
+
     ImGui::End();
 }
 
@@ -732,7 +737,7 @@ static void KindEditor_Draw()
     // Kind select
     ImGui::InputInt("Kind", &s_selectedKind);
     ImGui::SameLine();
-    if (ImGui::Button("Use Selected Block Kind") && s_selected >= 0)
+    if (ImGui::Button("Use Selected Block Kind") && Stage01_IsValid(s_selected))
     {
         const StageBlock* b = Stage01_Get(s_selected);
         if (b) s_selectedKind = b->kind;
@@ -883,16 +888,17 @@ void EditorUI_Draw(double elapsedTime)
 
     // ===== FXg =====
     ImGui::BeginChild("left_list", ImVec2(260, 0), true);
+    const int selectedIndex = Stage01_GetIndex(s_selected);
     for (int i = 0; i < count; ++i)
     {
         const StageBlock* b = Stage01_Get(i);
         if (!b) continue;
 
         char label[128];
-        sprintf_s(label, "#%d  kind:%d  tex:%d", i, b->kind, b->texId);
+        sprintf_s(label, "#%d  id:%d  kind:%d  tex:%d", i, b->id, b->kind, b->texId);
 
-        if (ImGui::Selectable(label, s_selected == i))
-            s_selected = i;
+        if (ImGui::Selectable(label, selectedIndex == i))
+            s_selected = Stage01_GetHandle(i);
     }
     ImGui::EndChild();
 
@@ -926,8 +932,20 @@ void EditorUI_Draw(double elapsedTime)
     if (ImGui::Button("Load JSON"))
     {
         const bool ok = Stage01_LoadJson(s_jsonPath);
-        if (ok) s_selected = (Stage01_GetCount() > 0) ? 0 : -1;
-        sprintf_s(s_ioStatus, ok ? "Loaded: %s" : "Load failed: %s", s_jsonPath);
+        if (ok) s_selected = Stage01_GetHandle(0);
+        if (ok) sprintf_s(s_ioStatus, "Loaded: %s", s_jsonPath);
+        else sprintf_s(s_ioStatus, "Load failed: %s", Stage01_GetLoadError()); // ǂœǂ߂Ȃis:j
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Compile BIN"))
+    {
+        // JSON ۑĂǂݒďiubN̈ʒuȂ悤Ɂj
+        char binPath[260];
+        StageBinary_MakePath(s_jsonPath, binPath, sizeof(binPath));
+        const int selected = Stage01_GetIndex(s_selected);
+        const bool ok = Stage01_SaveJson(s_jsonPath) && StageBinary_Compile(s_jsonPath, binPath);
+        s_selected = Stage01_GetHandle(selected);
+        sprintf_s(s_ioStatus, ok ? "Compiled: %s" : "Compile failed: %s", binPath);
     }
 
     if (s_ioStatus[0])
@@ -1004,7 +1022,7 @@ void EditorUI_Draw(double elapsedTime)
                     s_dupOffset[2] * mul
                 };
 
-                int newIndex = -1;
+                StageBlockHandle added;
                 for (int n = 0; n < s_dupCount; ++n)
                 {
                     StageBlock nb = srcBlock;
@@ -1013,21 +1031,23 @@ void EditorUI_Draw(double elapsedTime)
                     nb.position.y += step.y * t;
                     nb.position.z += step.z * t;
 
-                    newIndex = Stage01_Add(nb, true); // ApplyTex + Bake
+                    added = Stage01_Add(nb, true); // ApplyTex + Bake
                 }
 
-                if (newIndex >= 0) s_selected = newIndex;
+                if (Stage01_IsValid(added)) s_selected = added;
             }
         }
 
 
         if (changed)
-            Stage01_RebuildObject(s_selected);
+            Stage01_RebuildObject(Stage01_GetIndex(s_selected));
 
         if (ImGui::Button("Delete"))
         {
+            // ̃ubNʒuɗ̂ŁA͂I
+            const int removedIndex = Stage01_GetIndex(s_selected);
             Stage01_Remove(s_selected);
-            s_selected = (Stage01_GetCount() > 0) ? std::min(s_selected, Stage01_GetCount() - 1) : -1;
+            s_selected = Stage01_GetHandle(std::min(removedIndex, Stage01_GetCount() - 1));
         }
     }
 
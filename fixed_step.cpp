@@ -0,0 +1,67 @@
+/*==============================================================================
+
+@@  ŒXebvXV[fixed_step.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/05
+--------------------------------------------------------------------------------
+
+==============================================================================*/
+#include "fixed_step.h"
+#include <cmath>
+
+namespace
+{
+    double   g_stepSeconds = 1.0 / FIXED_STEP_DEFAULT_HZ;
+    int      g_maxCatchUp = FIXED_STEP_DEFAULT_MAX_CATCHUP;
+    double   g_accumulator = 0.0;
+    uint64_t g_tick = 0;
+    float    g_alpha = 1.0f;   // ŒXebvgȂƂiwbhXj͏ɍŐV
+}
+
+void FixedStep_Initialize(double hz, int maxCatchUpSteps)
+{
+    g_stepSeconds = (hz > 0.0) ? 1.0 / hz : 1.0 / FIXED_STEP_DEFAULT_HZ;
+    g_maxCatchUp = (maxCatchUpSteps > 0) ? maxCatchUpSteps : 1;
+    g_accumulator = 0.0;
+    g_tick = 0;
+    g_alpha = 1.0f;
+}
+
+int FixedStep_Advance(double frameSeconds)
+{
+    if (frameSeconds > 0.0) g_accumulator += frameSeconds;
+
+    int steps = (int)(g_accumulator / g_stepSeconds);
+    if (steps > g_maxCatchUp)
+    {
+        // ǂȂ͎̂ĂB[cĕԂ𑱂
+        steps = g_maxCatchUp;
+        g_accumulator = std::fmod(g_accumulator, g_stepSeconds) + g_stepSeconds * steps;
+    }
+    g_accumulator -= g_stepSeconds * steps;
+    if (g_accumulator < 0.0) g_accumulator = 0.0;
+
+    g_alpha = (float)(g_accumulator / g_stepSeconds);
+    if (g_alpha > 1.0f) g_alpha = 1.0f;
+    return steps;
+}
+
+void FixedStep_BeginTick()
+{
+    ++g_tick;
+}
+
+double FixedStep_GetStepSeconds()
+{
+    return g_stepSeconds;
+}
+
+uint64_t FixedStep_GetTick()
+{
+    return g_tick;
+}
+
+float FixedStep_GetAlpha()
+{
+    return g_alpha;
+}
@@ -0,0 +1,31 @@
+/*==============================================================================
+
+@@  ŒXebvXV[fixed_step.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/05
+--------------------------------------------------------------------------------
+@@XV͈ dt ŉ񂵁A`͖t[sB
+@@`摤 FixedStep_GetAlpha() őOeBbNƍeBbN̊ԂԂB
+==============================================================================*/
+#ifndef FIXED_STEP_H
+#define FIXED_STEP_H
+
+#include <cstdint>
+
+constexpr double FIXED_STEP_DEFAULT_HZ = 60.0;
+constexpr int    FIXED_STEP_DEFAULT_MAX_CATCHUP = 5;
+
+void FixedStep_Initialize(double hz = FIXED_STEP_DEFAULT_HZ, int maxCatchUpSteps = FIXED_STEP_DEFAULT_MAX_CATCHUP);
+
+// oߎԂ𑫂āÃt[ŉ񂷃XebvԂB
+// maxCatchUpSteps 𒴂͎̂Ăi~܂ɑɂȂȂ悤Ɂj
+int  FixedStep_Advance(double frameSeconds);
+
+// 1Xebv̍XVn߂OɌĂ
+void FixedStep_BeginTick();
+
+double   FixedStep_GetStepSeconds();
+uint64_t FixedStep_GetTick();    // BeginTick ̉񐔁i0 = ܂ŒXebvŉ񂵂ĂȂj
+float    FixedStep_GetAlpha();   // 0..1 OeBbNeBbN̕ԗ
+
+#endif//FIXED_STEP_H
@@ -13,6 +13,7 @@
 #include "staga_system.h"
 #include "title.h"
 #include "stage_registry.h"
+#include "asset_cache.h"
 
 namespace
 {
@@ -54,6 +55,7 @@ void Game_ChangeStage(StageId next)
         }
 
         Title_Initialize();              //タイトル初期化（2周目もここが走る）
+        Asset_CollectUnused();           //ステージだけで使っていたものを消す
         return;
     }
 
@@ -82,8 +84,11 @@ void Game_Update(float elapsedTime)
 
         if (Title_IsFinished())
         {
+            // 裏で読み終わるまではタイトルのまま（"Now Loading..." を出す）
             const StageId next = Title_GetSelectedStage();
-            Game_ChangeStage(next);
+            StageSystem_Preload(next);
+            if (!StageSystem_IsLoading())
+                Game_ChangeStage(next);
         }
         return;
     }
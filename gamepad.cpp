@@ -89,6 +89,10 @@ bool Gamepad_GetState(int idx, GamepadState* out)
     s.lx = NormalizeStickXI(g.sThumbLX, stickDZ);
     s.ly = NormalizeStickXI(g.sThumbLY, stickDZ);
 
+    const short rightStickDZ = XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE;
+    s.rx = NormalizeStickXI(g.sThumbRX, rightStickDZ);
+    s.ry = NormalizeStickXI(g.sThumbRY, rightStickDZ);
+
     s.lt = NormalizeTriggerXI(g.bLeftTrigger, trigTh);
     s.rt = NormalizeTriggerXI(g.bRightTrigger, trigTh);
 
@@ -17,6 +17,10 @@ struct GamepadState
     float lx = 0.0f;
     float ly = 0.0f;
 
+    // right stick (-1..1)
+    float rx = 0.0f;
+    float ry = 0.0f;
+
     // buttons
     bool a = false;
     bool b = false;
@@ -19,8 +19,10 @@
 #include "direct3d.h"
 #include "stage_registry.h"
 #include"Audio.h"
+#include "asset_cache.h"
 
 #include "model.h"
+#include "trigger_volume.h"
 
 using namespace DirectX;
 
@@ -31,6 +33,8 @@ namespace
     XMFLOAT3  g_goalPos = { 0,0,0 };
     GoalState g_goalState = GoalState::Inactive;
 
+    // fEeNX`E asset_cache ŎiXe[W؂ւĂǂݒȂj
+    AssetHandle g_goalModelAsset;
     MODEL* g_goalModel = nullptr;
     constexpr const char* kGoalModelPath = "goal.fbx";
     constexpr float       kGoalModelScale = 1.0f;
@@ -41,17 +45,19 @@ namespace
     bool LoadGoalModel()
     {
         if (g_goalModel) return true;
-        g_goalModel = ModelLoad(kGoalModelPath, kGoalModelScale, kGoalModelIsBrender);
+        g_goalModelAsset = Asset_LoadModel(kGoalModelPath, kGoalModelScale, kGoalModelIsBrender);
+        g_goalModel = Asset_GetModel(g_goalModelAsset);
         return (g_goalModel != nullptr);
     }
 
     void ReleaseGoalModel()
     {
         if (!g_goalModel) return;
-        ModelRelease(g_goalModel);
+        Asset_Release(&g_goalModelAsset);
         g_goalModel = nullptr;
     }
 
+    AssetHandle g_clearTexAsset;
     int   g_clearTex = -1;
     bool  g_prevB = false;
     float g_clearTimer = 0.0f;
@@ -66,10 +72,19 @@ namespace
     bool LoadClearTexture()
     {
         if (g_clearTex >= 0) return true;
-        g_clearTex = Texture_Load(L"stage_clear.png");
+        g_clearTexAsset = Asset_LoadTexture(L"stage_clear.png");
+        g_clearTex = Asset_GetTexture(g_clearTexAsset);
         return (g_clearTex >= 0);
     }
 
+    void ReleaseClearTexture()
+    {
+        Asset_Release(&g_clearTexAsset);
+        g_clearTex = -1;
+    }
+
+    AssetHandle g_clearAudioAsset;
+
     void DrawClearCentered()
     {
         if (g_clearTex < 0) return;
@@ -91,6 +106,17 @@ namespace
         return { {g_goalPos.x - r, g_goalPos.y - r, g_goalPos.z - r},
                  {g_goalPos.x + r, g_goalPos.y + r, g_goalPos.z + r} };
     }
+
+    // S[̓ trigger_volume ŌiuԂĂ΂j
+    int g_goalVolume = -1;
+
+    void OnEnterGoal(int, TriggerEvent, void*)
+    {
+        if (g_goalState != GoalState::Active) return;
+        g_goalState = GoalState::Clear;
+        g_clearTimer = 0.0f;
+        g_prevB = false;
+    }
 }
 
 void Goal_Init()
@@ -103,17 +129,38 @@ void Goal_Init()
 
     LoadGoalModel();
     LoadClearTexture();
-    LoadAudio("clear.wav");
+    if (!Asset_IsValid(g_clearAudioAsset))
+    {
+        g_clearAudioAsset = Asset_LoadAudio("clear.wav");
+        goalBgm = Asset_GetAudio(g_clearAudioAsset);
+    }
+
+    if (g_goalVolume < 0)
+    {
+        TriggerVolumeDesc desc;
+        desc.aabb = MakeGoalAABB();
+        desc.layer = TRIGGER_LAYER_GOAL;
+        desc.onEnter = OnEnterGoal;
+        g_goalVolume = TriggerVolume_Add(desc);
+    }
 }
 
 void Goal_Uninit()
 {
     g_goalState = GoalState::Inactive;
+    TriggerVolume_Remove(g_goalVolume);
+    g_goalVolume = -1;
     ReleaseGoalModel();
-    UnloadAudio(goalBgm);
+    ReleaseClearTexture();
+    Asset_Release(&g_clearAudioAsset);
+    goalBgm = -1;
 }
 
-void Goal_SetPosition(const XMFLOAT3& pos) { g_goalPos = pos; }
+void Goal_SetPosition(const XMFLOAT3& pos)
+{
+    g_goalPos = pos;
+    TriggerVolume_SetAABB(g_goalVolume, MakeGoalAABB());
+}
 XMFLOAT3 Goal_GetPosition() { return g_goalPos; }
 GoalState Goal_GetState() { return g_goalState; }
 
@@ -138,19 +185,7 @@ void Goal_Update(double elapsedTime)
         return;
     }
 
-    if (g_goalState == GoalState::Active)
-    {
-        LoadGoalModel();
-        const AABB playerAabb = Player_GetAABB();
-        const AABB goalAabb = MakeGoalAABB();
-
-        if (Collision_IsOverlapAABB(playerAabb, goalAabb))
-        {
-            g_goalState = GoalState::Clear;
-            g_clearTimer = 0.0f;
-            g_prevB = false;
-        }
-    }
+    // Active  Clear  OnEnterGoaliTriggerVolume_Update j
 
     if (g_goalState == GoalState::Clear)
     {
@@ -0,0 +1,31 @@
+/*==============================================================================
+
+@@  D3D11 ^̑p[d3d11.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/01
+--------------------------------------------------------------------------------
+@@SIM_HEADLESS rhiLinuxjpBCN[hpX headless/ 𑫂ƂgB
+@@C^[tF[X͑O錾Ȃ̂ŁA|C^񂷈ȏ̂Ƃ͂łȂB
+==============================================================================*/
+#ifndef SIM_HEADLESS_D3D11_H
+#define SIM_HEADLESS_D3D11_H
+
+#include "win32_types.h"
+
+struct ID3D11Device;
+struct ID3D11DeviceContext;
+struct ID3D11Resource;
+struct ID3D11Buffer;
+struct ID3D11Texture2D;
+struct ID3D11ShaderResourceView;
+struct ID3D11RenderTargetView;
+struct ID3D11DepthStencilView;
+struct ID3D11SamplerState;
+struct ID3D11BlendState;
+struct ID3D11DepthStencilState;
+struct ID3D11RasterizerState;
+struct ID3D11VertexShader;
+struct ID3D11PixelShader;
+struct ID3D11InputLayout;
+
+#endif//SIM_HEADLESS_D3D11_H
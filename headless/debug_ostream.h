@@ -0,0 +1,20 @@
+/*==============================================================================
+
+@@  fobOo͂̑p[debug_ostream.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/01
+--------------------------------------------------------------------------------
+@@SIM_HEADLESS rhiLinuxjpBCN[hpX headless/ 𑫂ƂgB
+@@hal::dout ̏o͐WG[ɂB
+==============================================================================*/
+#ifndef SIM_HEADLESS_DEBUG_OSTREAM_H
+#define SIM_HEADLESS_DEBUG_OSTREAM_H
+
+#include <iostream>
+
+namespace hal
+{
+	inline std::ostream& dout = std::cerr;
+}
+
+#endif//SIM_HEADLESS_DEBUG_OSTREAM_H
@@ -0,0 +1,42 @@
+/*==============================================================================
+
+@@  SAL ߂̑p[sal.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/01
+--------------------------------------------------------------------------------
+@@SIM_HEADLESS rhiLinuxjpBCN[hpX headless/ 𑫂ƂgB
+@@DirectXMath  GCC/Clang ŎgƂɕKvɂȂ钍߃}NɂB
+==============================================================================*/
+#ifndef SIM_HEADLESS_SAL_H
+#define SIM_HEADLESS_SAL_H
+
+#define _In_
+#define _In_opt_
+#define _Out_
+#define _Out_opt_
+#define _Inout_
+#define _Inout_opt_
+#define _In_z_
+#define _In_reads_(n)
+#define _In_reads_opt_(n)
+#define _In_reads_bytes_(n)
+#define _Out_writes_(n)
+#define _Out_writes_opt_(n)
+#define _Out_writes_bytes_(n)
+#define _Out_writes_all_(n)
+#define _Inout_updates_(n)
+#define _Inout_updates_bytes_(n)
+#define _Use_decl_annotations_
+#define _Analysis_assume_(e)
+#define _Success_(e)
+#define _Check_return_
+#define _Ret_maybenull_
+#define _Printf_format_string_
+#define _Pre_
+#define _Post_
+#define _Notnull_
+#define _Maybenull_
+#define _Null_terminated_
+#define _Field_size_(n)
+
+#endif//SIM_HEADLESS_SAL_H
@@ -0,0 +1,48 @@
+/*==============================================================================
+
+@@  Win32 ^̑p[win32_types.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/01
+--------------------------------------------------------------------------------
+@@SIM_HEADLESS rhiLinuxjpBCN[hpX headless/ 𑫂ƂgB
+@@wb_̐錾ʂ߂̌^BWin32 API ͖̎̂B
+@@Windows.h / windows.h ͑啶ႢŃ|WgɒuȂ̂ŁA
+@@CMake rhfBNgɂ include 邾̃t@CB
+==============================================================================*/
+#ifndef SIM_HEADLESS_WIN32_TYPES_H
+#define SIM_HEADLESS_WIN32_TYPES_H
+
+#include <cstdint>
+
+typedef unsigned char  BYTE;
+typedef unsigned short WORD;
+typedef unsigned int   UINT;
+typedef std::uint32_t  DWORD;
+typedef int            BOOL;
+typedef long           LONG;
+typedef unsigned long  ULONG;
+typedef long           HRESULT;
+typedef std::uintptr_t WPARAM;
+typedef std::intptr_t  LPARAM;
+typedef std::intptr_t  LRESULT;
+
+struct HWND__;
+typedef HWND__* HWND;
+struct HINSTANCE__;
+typedef HINSTANCE__* HINSTANCE;
+
+#ifndef CALLBACK
+#define CALLBACK
+#endif
+#ifndef WINAPI
+#define WINAPI
+#endif
+
+#ifndef SUCCEEDED
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#endif
+#ifndef FAILED
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+#endif
+
+#endif//SIM_HEADLESS_WIN32_TYPES_H
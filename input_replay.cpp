@@ -0,0 +1,371 @@
+/*==============================================================================
+
+@@  ͂̋L^EĐ[input_replay.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/03
+--------------------------------------------------------------------------------
+@@t@C`igGfBAj
+@@  "LMIR" u32 version f64 tickSeconds
+@@  u32 pathLen + path
+@@  f32 x 6  PlayerTuning
+@@  u8 continuousCollisioniversion 2 B1 ̃t@C false j
+@@  u32 frameCount u32 runCount
+@@  run: varint repeat, u8 buttons, f32 moveX, f32 moveY
+@@  u8 hasHash u64 trajectoryHash
+@@͂eBbN͂܂Ƃ߂ipbh|ςȂȂق1jB
+==============================================================================*/
+#include "input_replay.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr char     REPLAY_MAGIC[4] = { 'L', 'M', 'I', 'R' };
+    constexpr uint32_t REPLAY_VERSION = 2;
+
+    enum : uint8_t
+    {
+        BTN_JUMP = 1 << 0,
+        BTN_DASH = 1 << 1,
+        BTN_SPIN = 1 << 2,
+        BTN_CROUCH = 1 << 3,
+    };
+
+    struct ReplayData
+    {
+        std::string stageJsonPath;
+        PlayerTuning tuning{};
+        double tickSeconds = 1.0 / 60.0;
+        std::vector<PlayerInput> frames;
+        bool hasHash = false;
+        uint64_t hash = 0;
+    };
+
+    ReplayData g_record;
+    ReplayData g_replay;
+
+    // =====  =====
+    void PutU8(std::vector<uint8_t>& b, uint8_t v) { b.push_back(v); }
+
+    void PutU32(std::vector<uint8_t>& b, uint32_t v)
+    {
+        for (int i = 0; i < 4; ++i) b.push_back((uint8_t)(v >> (i * 8)));
+    }
+
+    void PutU64(std::vector<uint8_t>& b, uint64_t v)
+    {
+        for (int i = 0; i < 8; ++i) b.push_back((uint8_t)(v >> (i * 8)));
+    }
+
+    void PutF32(std::vector<uint8_t>& b, float f)
+    {
+        uint32_t v;
+        std::memcpy(&v, &f, sizeof(v));
+        PutU32(b, v);
+    }
+
+    void PutF64(std::vector<uint8_t>& b, double d)
+    {
+        uint64_t v;
+        std::memcpy(&v, &d, sizeof(v));
+        PutU64(b, v);
+    }
+
+    void PutVarint(std::vector<uint8_t>& b, uint32_t v)
+    {
+        while (v >= 0x80)
+        {
+            b.push_back((uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        b.push_back((uint8_t)v);
+    }
+
+    // ===== ǂݍ =====
+    struct Reader
+    {
+        const uint8_t* p;
+        const uint8_t* end;
+        bool ok = true;
+
+        bool Need(size_t n)
+        {
+            if (!ok || (size_t)(end - p) < n) ok = false;
+            return ok;
+        }
+        uint8_t U8()
+        {
+            if (!Need(1)) return 0;
+            return *p++;
+        }
+        uint32_t U32()
+        {
+            if (!Need(4)) return 0;
+            uint32_t v = 0;
+            for (int i = 0; i < 4; ++i) v |= (uint32_t)(*p++) << (i * 8);
+            return v;
+        }
+        uint64_t U64()
+        {
+            if (!Need(8)) return 0;
+            uint64_t v = 0;
+            for (int i = 0; i < 8; ++i) v |= (uint64_t)(*p++) << (i * 8);
+            return v;
+        }
+        float F32()
+        {
+            const uint32_t v = U32();
+            float f;
+            std::memcpy(&f, &v, sizeof(f));
+            return f;
+        }
+        double F64()
+        {
+            const uint64_t v = U64();
+            double d;
+            std::memcpy(&d, &v, sizeof(d));
+            return d;
+        }
+        uint32_t Varint()
+        {
+            uint32_t v = 0;
+            for (int shift = 0; shift < 35; shift += 7)
+            {
+                const uint8_t b = U8();
+                if (!ok) return 0;
+                v |= (uint32_t)(b & 0x7F) << shift;
+                if ((b & 0x80) == 0) return v;
+            }
+            ok = false;
+            return 0;
+        }
+    };
+
+    uint8_t PackButtons(const PlayerInput& in)
+    {
+        uint8_t b = 0;
+        if (in.jump)   b |= BTN_JUMP;
+        if (in.dash)   b |= BTN_DASH;
+        if (in.spin)   b |= BTN_SPIN;
+        if (in.crouch) b |= BTN_CROUCH;
+        return b;
+    }
+
+    // float  == ł͂ȂrbgŔׂi-0.0f  0.0f ʂ邽߁j
+    bool SameInput(const PlayerInput& a, const PlayerInput& b)
+    {
+        return std::memcmp(&a.moveX, &b.moveX, sizeof(float)) == 0 &&
+            std::memcmp(&a.moveY, &b.moveY, sizeof(float)) == 0 &&
+            PackButtons(a) == PackButtons(b);
+    }
+
+    uint64_t HashBytes(uint64_t h, const void* data, size_t size)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            h ^= p[i];
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+}
+
+// ===== L^ =====
+void InputRecord_Begin(const char* stageJsonPath, const PlayerTuning& tuning, double tickSeconds)
+{
+    g_record = ReplayData{};
+    g_record.stageJsonPath = stageJsonPath ? stageJsonPath : "";
+    g_record.tuning = tuning;
+    g_record.tickSeconds = tickSeconds;
+}
+
+void InputRecord_Push(const PlayerInput& input)
+{
+    g_record.frames.push_back(input);
+}
+
+int InputRecord_GetFrameCount()
+{
+    return (int)g_record.frames.size();
+}
+
+void InputRecord_SetTrajectoryHash(uint64_t hash)
+{
+    g_record.hasHash = true;
+    g_record.hash = hash;
+}
+
+bool InputRecord_Save(const char* path)
+{
+    if (!path || !path[0]) return false;
+
+    std::vector<uint8_t> b;
+    b.reserve(64 + g_record.stageJsonPath.size() + g_record.frames.size() / 4);
+
+    b.insert(b.end(), REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    PutU32(b, REPLAY_VERSION);
+    PutF64(b, g_record.tickSeconds);
+
+    PutU32(b, (uint32_t)g_record.stageJsonPath.size());
+    b.insert(b.end(), g_record.stageJsonPath.begin(), g_record.stageJsonPath.end());
+
+    const PlayerTuning& t = g_record.tuning;
+    PutF32(b, t.jumpImpulse);
+    PutF32(b, t.gravity);
+    PutF32(b, t.terminalFall);
+    PutF32(b, t.moveAccel);
+    PutF32(b, t.friction);
+    PutF32(b, t.rotSpeed);
+    PutU8(b, t.continuousCollision ? 1 : 0);
+
+    // ̘͂A܂Ƃ߂
+    const std::vector<PlayerInput>& f = g_record.frames;
+    uint32_t runCount = 0;
+    for (size_t i = 0; i < f.size(); ++i)
+    {
+        if (i == 0 || !SameInput(f[i], f[i - 1])) ++runCount;
+    }
+
+    PutU32(b, (uint32_t)f.size());
+    PutU32(b, runCount);
+    for (size_t i = 0; i < f.size();)
+    {
+        size_t j = i + 1;
+        while (j < f.size() && SameInput(f[j], f[i])) ++j;
+
+        PutVarint(b, (uint32_t)(j - i));
+        PutU8(b, PackButtons(f[i]));
+        PutF32(b, f[i].moveX);
+        PutF32(b, f[i].moveY);
+        i = j;
+    }
+
+    PutU8(b, g_record.hasHash ? 1 : 0);
+    PutU64(b, g_record.hash);
+
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs) return false;
+    ofs.write(reinterpret_cast<const char*>(b.data()), (std::streamsize)b.size());
+    return (bool)ofs;
+}
+
+// ===== Đ =====
+bool InputReplay_Load(const char* path)
+{
+    InputReplay_Clear();
+    if (!path || !path[0]) return false;
+
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) return false;
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+    Reader r{ bytes.data(), bytes.data() + bytes.size() };
+    if (!r.Need(4) || std::memcmp(r.p, REPLAY_MAGIC, 4) != 0) return false;
+    r.p += 4;
+    const uint32_t version = r.U32();
+    if (version < 1 || version > REPLAY_VERSION) return false;
+
+    ReplayData d;
+    d.tickSeconds = r.F64();
+
+    const uint32_t pathLen = r.U32();
+    if (!r.Need(pathLen)) return false;
+    d.stageJsonPath.assign(reinterpret_cast<const char*>(r.p), pathLen);
+    r.p += pathLen;
+
+    d.tuning.jumpImpulse = r.F32();
+    d.tuning.gravity = r.F32();
+    d.tuning.terminalFall = r.F32();
+    d.tuning.moveAccel = r.F32();
+    d.tuning.friction = r.F32();
+    d.tuning.rotSpeed = r.F32();
+    d.tuning.continuousCollision = (version >= 2) ? (r.U8() != 0) : false;
+
+    const uint32_t frameCount = r.U32();
+    const uint32_t runCount = r.U32();
+    if (!r.ok) return false;
+
+    // 1 run ͍Œ10oCgȂ̂ŁAꂽt@CŋmۂȂ悤ɊmF
+    if ((size_t)(r.end - r.p) / 10 < runCount) return false;
+    d.frames.reserve(frameCount);
+
+    for (uint32_t i = 0; i < runCount && r.ok; ++i)
+    {
+        const uint32_t repeat = r.Varint();
+        const uint8_t buttons = r.U8();
+        PlayerInput in{};
+        in.moveX = r.F32();
+        in.moveY = r.F32();
+        in.jump = (buttons & BTN_JUMP) != 0;
+        in.dash = (buttons & BTN_DASH) != 0;
+        in.spin = (buttons & BTN_SPIN) != 0;
+        in.crouch = (buttons & BTN_CROUCH) != 0;
+
+        if (!r.ok || repeat == 0 || repeat > frameCount - d.frames.size()) return false;
+        d.frames.insert(d.frames.end(), repeat, in);
+    }
+
+    d.hasHash = r.U8() != 0;
+    d.hash = r.U64();
+    if (!r.ok || d.frames.size() != frameCount) return false;
+
+    g_replay = std::move(d);
+    return true;
+}
+
+void InputReplay_Clear()
+{
+    g_replay = ReplayData{};
+}
+
+int InputReplay_GetFrameCount()
+{
+    return (int)g_replay.frames.size();
+}
+
+bool InputReplay_GetFrame(int frame, PlayerInput* out)
+{
+    if (frame < 0 || frame >= (int)g_replay.frames.size())
+    {
+        if (out) *out = PlayerInput{};
+        return false;
+    }
+    if (out) *out = g_replay.frames[frame];
+    return true;
+}
+
+const char* InputReplay_GetStageJsonPath()
+{
+    return g_replay.stageJsonPath.c_str();
+}
+
+const PlayerTuning& InputReplay_GetTuning()
+{
+    return g_replay.tuning;
+}
+
+double InputReplay_GetTickSeconds()
+{
+    return g_replay.tickSeconds;
+}
+
+bool InputReplay_HasTrajectoryHash()
+{
+    return g_replay.hasHash;
+}
+
+uint64_t InputReplay_GetTrajectoryHash()
+{
+    return g_replay.hash;
+}
+
+// ===== OnbV =====
+uint64_t InputReplay_HashStep(uint64_t hash, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& velocity)
+{
+    hash = HashBytes(hash, &position, sizeof(position));
+    return HashBytes(hash, &velocity, sizeof(velocity));
+}
@@ -0,0 +1,42 @@
+/*==============================================================================
+
+@@  ͂̋L^EĐ[input_replay.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/03
+--------------------------------------------------------------------------------
+@@ŒeBbNƂ PlayerInput AXe[WJSOÑpX PlayerTuning ƈꏏ
+@@oCiŕۑBĐ Player_SetInputOverride ɖeBbNnB
+@@float ̓rbĝ܂ܕۑ̂ŁArhȂO͊SɈvB
+==============================================================================*/
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+
+#include <DirectXMath.h>
+#include <cstdint>
+#include "player.h"
+
+// ===== L^ =====
+void InputRecord_Begin(const char* stageJsonPath, const PlayerTuning& tuning, double tickSeconds);
+void InputRecord_Push(const PlayerInput& input);   // 1eBbN
+int  InputRecord_GetFrameCount();
+// ĐŔr邽߂̋OnbViInputReplay_HashStep ṓj
+void InputRecord_SetTrajectoryHash(uint64_t hash);
+bool InputRecord_Save(const char* path);
+
+// ===== Đ =====
+bool InputReplay_Load(const char* path);
+void InputReplay_Clear();
+int  InputReplay_GetFrameCount();
+bool InputReplay_GetFrame(int frame, PlayerInput* out);   // ͈͊O false + j[g
+const char* InputReplay_GetStageJsonPath();
+const PlayerTuning& InputReplay_GetTuning();
+double InputReplay_GetTickSeconds();
+bool InputReplay_HasTrajectoryHash();
+uint64_t InputReplay_GetTrajectoryHash();
+
+// ===== OnbV =====
+constexpr uint64_t INPUT_REPLAY_HASH_SEED = 14695981039346656037ull; // FNV-1a
+// ʒuƑx̃rbgnbVɍieBbNĂԁj
+uint64_t InputReplay_HashStep(uint64_t hash, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& velocity);
+
+#endif//INPUT_REPLAY_H
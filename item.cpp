@@ -11,8 +11,13 @@
 #include "collision.h"
 #include "model.h"
 #include "player.h"
+#include "culling.h"
+#include "trigger_volume.h"
 
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 using namespace DirectX;
 
@@ -22,15 +27,58 @@ namespace {
 		XMFLOAT3 rotation{};
 		int modelIndex = -1;
 		bool active = true;
+		int volume = -1;	// 
 	};
 
 	std::vector<ItemData> g_items;
 	std::vector<MODEL*> g_itemModels;
 	int g_hitCount = 0;
+
+	// `ÕJOp
+	std::vector<int> g_drawItems;
+	CullBoundsSoA g_drawBounds;
+	std::vector<uint8_t> g_drawVisible;
+
+	//  trigger_volume ŌiGꂽuԂĂ΂j
+	void OnEnterItem(int volume, TriggerEvent, void* user)
+	{
+		const int index = (int)(intptr_t)user;
+		if (index < 0 || index >= static_cast<int>(g_items.size())) return;
+
+		ItemData& item = g_items[index];
+		if (!item.active) return;
+		item.active = false;
+		item.volume = -1;
+		++g_hitCount;
+		TriggerVolume_Remove(volume);
+	}
+
+	void RemoveItemVolumes()
+	{
+		for (auto& item : g_items) {
+			TriggerVolume_Remove(item.volume);
+			item.volume = -1;
+		}
+	}
+
+	// ]ĕ`̂ŁA_܂ɉ񂵂Ă܂锠ɂĂ
+	AABB DrawBoundsOf(MODEL* model, const XMFLOAT3& position)
+	{
+		const AABB local = Model_GetAABB(model, { 0.0f, 0.0f, 0.0f });
+		const float ex = (std::max)(std::fabs(local.min.x), std::fabs(local.max.x));
+		const float ey = (std::max)(std::fabs(local.min.y), std::fabs(local.max.y));
+		const float ez = (std::max)(std::fabs(local.min.z), std::fabs(local.max.z));
+		const float r = std::sqrt(ex * ex + ey * ey + ez * ez);
+		return {
+			{ position.x - r, position.y - r, position.z - r },
+			{ position.x + r, position.y + r, position.z + r }
+		};
+	}
 }
 
 void Item_Initialize()
 {
+	RemoveItemVolumes();
 	g_items.clear();
 	g_itemModels.clear();
 	g_hitCount = 0;
@@ -44,6 +92,7 @@ void Item_Finalize()
 		}
 	}
 	g_itemModels.clear();
+	RemoveItemVolumes();
 	g_items.clear();
 }
 
@@ -65,14 +114,33 @@ int Item_Add(const XMFLOAT3& position, const XMFLOAT3& rotationDeg, int modelInd
 	};
 	data.modelIndex = modelIndex;
 	data.active = true;
+
+	const int index = static_cast<int>(g_items.size());
+	MODEL* model = (modelIndex >= 0 && modelIndex < static_cast<int>(g_itemModels.size())) ? g_itemModels[modelIndex] : nullptr;
+	if (model) {
+		TriggerVolumeDesc desc;
+		desc.aabb = Model_GetAABB(model, position);
+		desc.layer = TRIGGER_LAYER_ITEM;
+		desc.onEnter = OnEnterItem;
+		desc.user = (void*)(intptr_t)index;
+		data.volume = TriggerVolume_Add(desc);
+	}
+
 	g_items.push_back(data);
-	return static_cast<int>(g_items.size()) - 1;
+	return index;
 }
 
 void Item_Update()
 {
-	const AABB playerAabb = Player_GetAABB();
-	for (auto& item : g_items) {
+	//  TriggerVolume_Update ōςłiOnEnterItemj
+}
+
+// `̂W߂āAJ̎ł܂Ƃ߂Ĕ肷iʂ g_drawItems / g_drawVisiblej
+static void CullDrawItems()
+{
+	g_drawItems.clear();
+	for (int i = 0; i < static_cast<int>(g_items.size()); ++i) {
+		const auto& item = g_items[i];
 		if (!item.active) {
 			continue;
 		}
@@ -81,39 +149,55 @@ void Item_Update()
 			continue;
 		}
 
-		MODEL* model = g_itemModels[item.modelIndex];
-		if (!model) {
+		if (!g_itemModels[item.modelIndex]) {
 			continue;
 		}
+		g_drawItems.push_back(i);
+	}
 
-		const AABB itemAabb = Model_GetAABB(model, item.position);
-		if (Collision_IsOverlapAABB(playerAabb, itemAabb)) {
-			item.active = false;
-			++g_hitCount;
-		}
+	g_drawBounds.Resize(g_drawItems.size());
+	g_drawVisible.resize(g_drawItems.size());
+	for (size_t k = 0; k < g_drawItems.size(); ++k) {
+		const auto& item = g_items[g_drawItems[k]];
+		g_drawBounds.Set(k, DrawBoundsOf(g_itemModels[item.modelIndex], item.position));
 	}
+	Culling_TestView(CULL_VIEW_CAMERA, g_drawBounds.View(), g_drawVisible.data());
+}
+
+static XMMATRIX ItemWorldMatrix(const ItemData& item)
+{
+	const XMMATRIX rotation =
+		XMMatrixRotationRollPitchYaw(item.rotation.x, item.rotation.y, item.rotation.z);
+	const XMMATRIX translation = XMMatrixTranslation(item.position.x, item.position.y, item.position.z);
+	return rotation * translation;
 }
 
 void Item_Draw()
 {
-	for (const auto& item : g_items) {
-		if (!item.active) {
-			continue;
-		}
+	CullDrawItems();
 
-		if (item.modelIndex < 0 || item.modelIndex >= static_cast<int>(g_itemModels.size())) {
+	for (size_t k = 0; k < g_drawItems.size(); ++k) {
+		if (!g_drawVisible[k]) {
 			continue;
 		}
 
-		MODEL* model = g_itemModels[item.modelIndex];
-		if (!model) {
+		const auto& item = g_items[g_drawItems[k]];
+		ModelDraw(g_itemModels[item.modelIndex], ItemWorldMatrix(item));
+	}
+}
+
+void Item_Submit(const XMFLOAT3& cameraPosition, const XMFLOAT3& cameraFront)
+{
+	CullDrawItems();
+
+	for (size_t k = 0; k < g_drawItems.size(); ++k) {
+		if (!g_drawVisible[k]) {
 			continue;
 		}
 
-		const XMMATRIX rotation =
-			XMMatrixRotationRollPitchYaw(item.rotation.x, item.rotation.y, item.rotation.z);
-		const XMMATRIX translation = XMMatrixTranslation(item.position.x, item.position.y, item.position.z);
-		ModelDraw(model, rotation * translation);
+		const auto& item = g_items[g_drawItems[k]];
+		Model_Submit(g_itemModels[item.modelIndex], ItemWorldMatrix(item), RENDER_PASS_OPAQUE, RENDER_SHADER_3D,
+			RenderQueue_ViewDepth(cameraPosition, cameraFront, item.position));
 	}
 }
 
@@ -16,6 +16,8 @@ void Item_Initialize();
 void Item_Finalize();
 void Item_Update();
 void Item_Draw();
+// Item_Draw ̕`L[ŁibVƂɐςށj
+void Item_Submit(const DirectX::XMFLOAT3& cameraPosition, const DirectX::XMFLOAT3& cameraFront);
 
 int Item_LoadModel(const char* modelPath, float scale = 0.1f, bool isBrender = false);
 int Item_Add(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& rotationDeg, int modelIndex);
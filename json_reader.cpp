@@ -0,0 +1,232 @@
+/*==============================================================================
+
+@@  JSON ̓ǂݎ[json_reader.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/17
+--------------------------------------------------------------------------------
+
+==============================================================================*/
+#include "json_reader.h"
+#include <cstdlib>
+
+JsonReader::JsonReader(const char* text, size_t size)
+    : m_begin(text), m_p(text), m_end(text + size)
+{
+    // UTF-8  BOM ͓ǂݔ΂iŕۑt@Cj
+    if (size >= 3 && (unsigned char)text[0] == 0xEF && (unsigned char)text[1] == 0xBB && (unsigned char)text[2] == 0xBF)
+        m_p += 3;
+}
+
+void JsonReader::SkipSpace()
+{
+    while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\r' || *m_p == '\n')) ++m_p;
+}
+
+bool JsonReader::Fail(const char* message)
+{
+    if (!m_error)
+    {
+        m_error = message;
+        m_errorAt = m_p;
+    }
+    return false;
+}
+
+bool JsonReader::Expect(char c, const char* message)
+{
+    SkipSpace();
+    if (m_p >= m_end || *m_p != c) return Fail(message);
+    ++m_p;
+    return true;
+}
+
+bool JsonReader::BeginObject()
+{
+    if (m_error) return false;
+    if (m_depth >= MAX_DEPTH) return Fail("nesting too deep");
+    if (!Expect('{', "expected '{'")) return false;
+    m_scope[m_depth] = SCOPE_OBJECT;
+    m_first[m_depth] = true;
+    ++m_depth;
+    return true;
+}
+
+bool JsonReader::BeginArray()
+{
+    if (m_error) return false;
+    if (m_depth >= MAX_DEPTH) return Fail("nesting too deep");
+    if (!Expect('[', "expected '['")) return false;
+    m_scope[m_depth] = SCOPE_ARRAY;
+    m_first[m_depth] = true;
+    ++m_depth;
+    return true;
+}
+
+// ʂȂ甲 trueBłȂ ',' ǂŁi擪ȊOjfalse
+bool JsonReader::LeaveScope(char close)
+{
+    SkipSpace();
+    bool& first = m_first[m_depth - 1];
+    if (m_p < m_end && *m_p == close)
+    {
+        ++m_p;
+        --m_depth;
+        return true;
+    }
+    if (!first && !Expect(',', close == '}' ? "expected ',' or '}'" : "expected ',' or ']'")) return false;
+    first = false;
+    return false;
+}
+
+bool JsonReader::NextMember(JsonStr* key)
+{
+    if (m_error || m_depth <= 0 || m_scope[m_depth - 1] != SCOPE_OBJECT) return false;
+    if (LeaveScope('}') || m_error) return false;
+
+    SkipSpace();
+    if (m_p < m_end && *m_p == '}') return Fail("trailing ','");
+    if (!ReadString(key)) return false;
+    return Expect(':', "expected ':'");
+}
+
+bool JsonReader::NextElement()
+{
+    if (m_error || m_depth <= 0 || m_scope[m_depth - 1] != SCOPE_ARRAY) return false;
+    if (LeaveScope(']') || m_error) return false;
+
+    SkipSpace();
+    if (m_p < m_end && *m_p == ']') return Fail("trailing ','");
+    return true;
+}
+
+bool JsonReader::ReadNumber(double* out)
+{
+    if (m_error) return false;
+    SkipSpace();
+    if (m_p >= m_end || !(*m_p == '-' || (*m_p >= '0' && *m_p <= '9'))) return Fail("expected a number");
+
+    char* end = nullptr;
+    const double v = std::strtod(m_p, &end);
+    if (end == m_p || end > m_end) return Fail("bad number");
+    m_p = end;
+    *out = v;
+    return true;
+}
+
+bool JsonReader::ReadFloat(float* out)
+{
+    double v = 0.0;
+    if (!ReadNumber(&v)) return false;
+    *out = (float)v;
+    return true;
+}
+
+bool JsonReader::ReadInt(int* out)
+{
+    double v = 0.0;
+    if (!ReadNumber(&v)) return false;
+    if (v < -2147483648.0 || v > 2147483647.0) return Fail("integer out of range");
+    *out = (int)v;
+    return true;
+}
+
+bool JsonReader::ReadString(JsonStr* out)
+{
+    if (m_error) return false;
+    if (!Expect('"', "expected a string")) return false;
+
+    const char* start = m_p;
+    while (m_p < m_end && *m_p != '"')
+    {
+        if ((unsigned char)*m_p < 0x20) return Fail("control character in string");
+        if (*m_p == '\\' && m_p + 1 < m_end) ++m_p;
+        ++m_p;
+    }
+    if (m_p >= m_end) return Fail("unterminated string");
+
+    out->s = start;
+    out->len = (int)(m_p - start);
+    ++m_p;
+    return true;
+}
+
+bool JsonReader::ReadFloats(float* out, int count)
+{
+    if (!BeginArray()) return false;
+
+    int n = 0;
+    while (NextElement())
+    {
+        if (n < count) ReadFloat(&out[n++]);
+        else Skip();
+    }
+    if (m_error) return false;
+    if (n < count) return Fail("too few numbers in array");
+    return true;
+}
+
+bool JsonReader::Skip()
+{
+    if (m_error) return false;
+    SkipSpace();
+    if (m_p >= m_end) return Fail("expected a value");
+
+    switch (*m_p)
+    {
+    case '{':
+    {
+        if (!BeginObject()) return false;
+        JsonStr key;
+        while (NextMember(&key)) Skip();
+        return !m_error;
+    }
+    case '[':
+        if (!BeginArray()) return false;
+        while (NextElement()) Skip();
+        return !m_error;
+    case '"':
+    {
+        JsonStr s;
+        return ReadString(&s);
+    }
+    case 't': case 'f': case 'n':
+    {
+        static const char* const kWords[] = { "true", "false", "null" };
+        for (const char* w : kWords)
+        {
+            const size_t len = std::strlen(w);
+            if ((size_t)(m_end - m_p) >= len && std::memcmp(m_p, w, len) == 0)
+            {
+                m_p += len;
+                return true;
+            }
+        }
+        return Fail("bad value");
+    }
+    default:
+    {
+        double v;
+        return ReadNumber(&v);
+    }
+    }
+}
+
+bool JsonReader::IsAtEnd()
+{
+    SkipSpace();
+    return m_p >= m_end;
+}
+
+void JsonReader::GetErrorPosition(int* line, int* column) const
+{
+    // G[̂Ƃiǂݎ蒆͍s𐔂Ȃj
+    int l = 1, c = 1;
+    const char* at = m_errorAt ? m_errorAt : m_p;
+    for (const char* q = m_begin; q < at; ++q)
+    {
+        if (*q == '\n') { ++l; c = 1; }
+        else ++c;
+    }
+    if (line) *line = l;
+    if (column) *column = c;
+}
@@ -0,0 +1,87 @@
+/*==============================================================================
+
+@@  JSON ̓ǂݎ[json_reader.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/17
+--------------------------------------------------------------------------------
+@@obt@擪 1 Ȃ߂邾 JSON [_[Blǂޑ
+@@u̓IuWFNg^z^lvƎwȂi߂iDOM ͍ȂjB
+@@̓obt@wȂ̂ŁAǂݎ蒆Ƀ͊mۂȂB
+@@  r.BeginObject();
+@@  JsonStr key;
+@@  while (r.NextMember(&key)) {
+@@      if (key == "size") r.ReadFloats(v, 3);
+@@      else r.Skip();
+@@  }
+@@ŏ̃G[Ŏ~܂Aȍ~̓ǂݎ͑SsBʒu͍sEŎB
+@@G[̓GfB^iImGuijɂ̂܂܏ôŉpB
+==============================================================================*/
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <cstddef>
+#include <cstring>
+
+// obt@̕i"" ̒gBGXP[v͂̂܂܁j
+struct JsonStr
+{
+    const char* s = nullptr;
+    int len = 0;
+
+    bool operator==(const char* t) const
+    {
+        return (int)std::strlen(t) == len && std::memcmp(s, t, (size_t)len) == 0;
+    }
+    bool operator!=(const char* t) const { return !(*this == t); }
+};
+
+class JsonReader
+{
+public:
+    // text  '\0' ŏIĂ邱Ɓistd::string  c_str() Ȃǁj
+    JsonReader(const char* text, size_t size);
+
+    // { ǂށBNextMember  false Ԃ܂ŃL[ƒl݂ɓǂށil͕Kǂނ Skip j
+    bool BeginObject();
+    bool NextMember(JsonStr* key);
+
+    // [ ǂށBNextElement  false Ԃ܂ŗvf 1 ǂ
+    bool BeginArray();
+    bool NextElement();
+
+    bool ReadNumber(double* out);
+    bool ReadFloat(float* out);
+    bool ReadInt(int* out);         // ͐؂̂āiÂۑ`̌݊j
+    bool ReadString(JsonStr* out);
+    // [a, b, ...] ̐擪 count B͓ǂݎ̂āAȂ΃G[
+    bool ReadFloats(float* out, int count);
+
+    bool Skip();                    // l 1 ǂݔ΂iqj
+    bool Fail(const char* message); // ̈ʒuŃG[ɂi falsej
+
+    bool IsAtEnd();                 // 󔒂΂Ė
+    bool HasError() const { return m_error != nullptr; }
+    const char* GetError() const { return m_error; }
+    void GetErrorPosition(int* line, int* column) const;    // 1 n܂
+
+private:
+    enum Scope : unsigned char { SCOPE_OBJECT, SCOPE_ARRAY };
+
+    void SkipSpace();
+    bool Expect(char c, const char* message);
+    bool LeaveScope(char close);
+
+    static constexpr int MAX_DEPTH = 64;
+
+    const char* m_begin;
+    const char* m_p;
+    const char* m_end;
+    const char* m_error = nullptr;
+    const char* m_errorAt = nullptr;
+
+    Scope m_scope[MAX_DEPTH];
+    bool m_first[MAX_DEPTH];        // ̃XR[vł܂vfǂłȂ
+    int m_depth = 0;
+};
+
+#endif // JSON_READER_H
@@ -29,7 +29,7 @@ int APIENTRY WinMain(_In_ HINSTANCE hIstance, _In_opt_ HINSTANCE hPrevInstance,
 #include"texture.h"
 #include"sprite.h"
 #include"sprite_anim.h"
-#include"collision.h"
+#include"collision_debug.h"
 #include"fade.h"
 #include"debug_text.h"
 #include<sstream>
@@ -54,10 +54,18 @@ int APIENTRY WinMain(_In_ HINSTANCE hIstance, _In_opt_ HINSTANCE hPrevInstance,
 #include"editor_ui.h"
 #include"player.h"
 #include "gamepad.h"
+#include "fixed_step.h"
+#include "render_queue.h"
+#include "culling.h"
+#include "asset_cache.h"
 
 
 #pragma comment(lib,"xinput.lib")
 
+// XV͌ŒXebvi`͖t[AԂ͕ԁj
+static constexpr double SIM_TICK_HZ = FIXED_STEP_DEFAULT_HZ;
+static constexpr int SIM_MAX_CATCHUP_STEPS = FIXED_STEP_DEFAULT_MAX_CATCHUP;
+
 
 
 /*-----------------------------------------
@@ -100,6 +108,7 @@ DirectX
     //Grid_Initialize(Direct3D_GetDevice(), Direct3D_GetContext());
     MeshField_Initialize(Direct3D_GetDevice(), Direct3D_GetContext());
     Light_Initialize(Direct3D_GetDevice(), Direct3D_GetContext());
+    RenderQueue_Initialize();
     ImGuiManager::Initialize(hWnd, Direct3D_GetDevice(), Direct3D_GetContext());
 
    
@@ -143,6 +152,8 @@ DirectX
     ULONG frame_count = 0;
     double fps = 0.0;
 
+    FixedStep_Initialize(SIM_TICK_HZ, SIM_MAX_CATCHUP_STEPS);
+
 
     /* Q[[vbZ[W[v */
     MSG msg;
@@ -183,21 +194,26 @@ DirectX
            
 
            
-           //1/60bƂɎs
+            //Ot[̌oߎԂԂAŒXebvōXV
             elapsed_time = current_time - exec_last_time;
-            if (elapsed_time >= (1.0 / 60.0)) {
-                //if(true){  //ifǂ
-                exec_last_time = current_time;//ۑ
-
+            exec_last_time = current_time;//ۑ
+            {
+                const int steps = FixedStep_Advance(elapsed_time);
+                const double step_time = FixedStep_GetStepSeconds();
 
-                //Q[̍XV
-                KeyLogger_Update();
-                Gamepad_Update();
-                Mouse_State ms{};
-                Mouse_GetState(&ms);
-                Scene_Update(elapsed_time);
-                SpriteAnim_Update(elapsed_time);
-                Game_Update(elapsed_time);
+                for (int i = 0; i < steps; ++i)
+                {
+                    FixedStep_BeginTick();
+
+                    //Q[̍XV
+                    KeyLogger_Update();
+                    Gamepad_Update();
+                    Mouse_State ms{};
+                    Mouse_GetState(&ms);
+                    Scene_Update(step_time);
+                    SpriteAnim_Update(step_time);
+                    Game_Update((float)step_time);
+                }
 
 #if defined(DEBUG)||defined(_DEBUG)
                 // UpdateOǂłOK
@@ -214,7 +230,7 @@ DirectX
                     Player_SetInputOverride(false, nullptr);
                 }
 #endif
-                //Q[̕`
+                //Q[̕`ivC[EJ FixedStep_GetAlpha() ŕԂj
                 Direct3D_SetBackBuffer();
                 Direct3D_ClearBackBuffer();
                 Game_Draw();//3D
@@ -229,6 +245,34 @@ DirectX
                 ss << "count:" << frame_count << std::endl;
                 dt.SetText(ss.str().c_str());
 
+                // `L[̐ݒ񐔁iʓ͏Ȃ񐔁jBs͖Ȃ̂ŕʂ̍sœn
+                const RenderQueueStats& rq = RenderQueue_GetStats();
+                std::stringstream rqs;
+                rqs << "rq cmd:" << rq.commands
+                    << " shader:" << rq.shaderBinds << "(-" << rq.shaderBindsSkipped << ")"
+                    << " tex:" << rq.textureBinds << "(-" << rq.textureBindsSkipped << ")" << std::endl;
+                dt.SetText(rqs.str().c_str());
+
+                const CullStats& cull = Culling_GetStats(CULL_VIEW_CAMERA);
+                const CullStats& cullShadow = Culling_GetStats(CULL_VIEW_SHADOW);
+                std::stringstream cs;
+                cs << "cull cam:" << cull.visible << "/" << cull.tested
+                   << " shadow:" << cullShadow.visible << "/" << cullShadow.tested << std::endl;
+                dt.SetText(cs.str().c_str());
+
+                // AZbg̎g񂵁ihit/missjƏ풓
+                std::stringstream as;
+                size_t assetBytes = 0;
+                as << "asset";
+                for (int t = 0; t < ASSET_TYPE_MAX; t++)
+                {
+                    const AssetStats& st = Asset_GetStats((AssetType)t);
+                    as << " " << Asset_GetTypeName((AssetType)t) << ":" << st.hits << "/" << st.misses;
+                    assetBytes += st.residentBytes;
+                }
+                as << " res:" << (assetBytes >> 10) << "KB" << std::endl;
+                dt.SetText(as.str().c_str());
+
                //dt.SetText("ABCDE\n");//̓r\nƃG[Ȃ@̂
                // dt.SetText("FG\n", { 0.0f,1.0f,1.0f,1.0f });
 
@@ -254,6 +298,7 @@ DirectX
 
     ImGuiManager::Finalize();
 
+    RenderQueue_Finalize();
     Light_Finalize();
 
     Cube_Finalize();
@@ -261,6 +306,7 @@ DirectX
     MeshField_Finalize();
 
     Scene_Finalize();
+    Asset_Finalize();
 
     Shader2D_Finalize();
     Shader3D_Finalize();
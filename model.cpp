@@ -17,6 +17,8 @@
 #include<assert.h>
 #include<algorithm>
 #include<DirectXMath.h>
+#include<mutex>
+#include<vector>
 
 using namespace DirectX;
 
@@ -34,7 +36,10 @@ MODEL* ModelLoad( const char *FileName ,float scale, bool isBrender)
 {
 	MODEL* model = new MODEL;
 
-	model->AiScene = aiImportFile(FileName, aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_ConvertToLeftHanded);
+	//œǂł΂g
+	model->AiScene = Model_TakePrefetched(FileName);
+	if (!model->AiScene)
+		model->AiScene = aiImportFile(FileName, MODEL_IMPORT_FLAGS);
 	assert(model->AiScene);
 
 	model->VertexBuffer = new ID3D11Buffer*[model->AiScene->mNumMeshes];
@@ -144,13 +149,16 @@ MODEL* ModelLoad( const char *FileName ,float scale, bool isBrender)
 		ID3D11ShaderResourceView* texture;
 		ID3D11Resource* resource;
 
-		CreateWICTextureFromMemory(
-			Direct3D_GetDevice(),
-			Direct3D_GetContext(),
-			(const uint8_t*)aitexture->pcData,
-			(size_t)aitexture->mWidth,
-			&resource, // release!!!!!
-			&texture);
+		if (!Texture_CreatePrefetched(Model_EmbeddedTextureName(FileName, i).c_str(), &resource, &texture))
+		{
+			CreateWICTextureFromMemory(
+				Direct3D_GetDevice(),
+				Direct3D_GetContext(),
+				(const uint8_t*)aitexture->pcData,
+				(size_t)aitexture->mWidth,
+				&resource, // release!!!!!
+				&texture);
+		}
 
 		assert(texture);
 
@@ -161,19 +169,6 @@ MODEL* ModelLoad( const char *FileName ,float scale, bool isBrender)
 	}
 
 
-	// fbx̃t@CpX擾
-	const std::string modelPath(FileName);
-// Ō'/' ܂ '\' ̈ʒuT (WindowsΉ)
-	size_t pos = modelPath.find_last_of("/\\");
-	std::string directory;
-
-	if (pos != std::string::npos) {
-		directory = modelPath.substr(0, pos);   // t@C
-	}
-	else {
-		directory = "";   // pXɋ؂肪Ȃꍇit@Ĉ݁j
-	}
-
 	// eNX`FBXƂ͕ʂɗpӂĂꍇ
 	//FBXt@CɏĂ geNX`摜h ɁAtH_ł̉摜TADirectXGPU\[Xɓo^鏈
 	for (unsigned int m = 0; m < model->AiScene->mNumMeshes; m++)
@@ -193,20 +188,17 @@ MODEL* ModelLoad( const char *FileName ,float scale, bool isBrender)
 		ID3D11ShaderResourceView* texture;
 		ID3D11Resource* resource;
 
-		std::string texfilename = directory + "/" + filename.C_Str();
-
-		int len = MultiByteToWideChar(CP_UTF8, 0, texfilename.c_str(), -1, nullptr, 0);
-		wchar_t* pWideFilename = new wchar_t[len];
-		MultiByteToWideChar(CP_UTF8, 0, texfilename.c_str(), -1, pWideFilename, len);
+		const std::wstring texfilename = Model_ExternalTexturePath(FileName, filename.C_Str());
 
-		CreateWICTextureFromFile(
-			Direct3D_GetDevice(),
-			Direct3D_GetContext(),
-			pWideFilename,
-			&resource,
-			&texture);
-
-		delete[] pWideFilename;
+		if (!Texture_CreatePrefetched(texfilename.c_str(), &resource, &texture))
+		{
+			CreateWICTextureFromFile(
+				Direct3D_GetDevice(),
+				Direct3D_GetContext(),
+				texfilename.c_str(),
+				&resource,
+				&texture);
+		}
 
 		assert(texture);
 
@@ -221,6 +213,113 @@ MODEL* ModelLoad( const char *FileName ,float scale, bool isBrender)
 
 
 
+//=====ł̓ǂݍ========
+// aiImportFile ܂ōς܂V[iModelLoad / SkinnedModel_Load oj
+struct PrefetchedScene
+{
+	std::string fileName;
+	const aiScene* scene;
+};
+static std::vector<PrefetchedScene> g_PrefetchedScenes;
+static std::mutex g_PrefetchMutex;
+
+static bool IsScenePrefetched(const char* FileName)
+{
+	for (const PrefetchedScene& p : g_PrefetchedScenes)
+	{
+		if (p.fileName == FileName) return true;
+	}
+	return false;
+}
+
+static std::wstring Utf8ToWide(const std::string& text)
+{
+	int len = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, nullptr, 0);
+	if (len <= 0) return std::wstring();
+	std::wstring out((size_t)len, L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, &out[0], len);
+	out.resize((size_t)len - 1);
+	return out;
+}
+
+std::wstring Model_EmbeddedTextureName(const char* FileName, unsigned int index)
+{
+	return Utf8ToWide(std::string(FileName) + "*" + std::to_string(index));
+}
+
+std::wstring Model_ExternalTexturePath(const char* FileName, const char* texName)
+{
+	// fbx̃t@CpX擾iŌ'/' ܂ '\' OB؂肪΋j
+	const std::string modelPath(FileName);
+	const size_t pos = modelPath.find_last_of("/\\");
+	const std::string directory = (pos != std::string::npos) ? modelPath.substr(0, pos) : "";
+	return Utf8ToWide(directory + "/" + texName);
+}
+
+void Model_Prefetch(const char* FileName)
+{
+	if (!FileName) return;
+	{
+		std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+		if (IsScenePrefetched(FileName)) return;
+	}
+
+	const aiScene* scene = aiImportFile(FileName, MODEL_IMPORT_FLAGS);
+	if (!scene) return;	// ǂݍݑǂǂŎ~܂
+
+	// eNX`fR[hĂiModelLoad ƓOŎoj
+	for (unsigned int i = 0; i < scene->mNumTextures; i++)
+	{
+		const aiTexture* aitexture = scene->mTextures[i];
+		Texture_PrefetchMemory(Model_EmbeddedTextureName(FileName, i).c_str(), aitexture->pcData, (size_t)aitexture->mWidth);
+	}
+	for (unsigned int m = 0; m < scene->mNumMeshes; m++)
+	{
+		aiString filename;
+		scene->mMaterials[scene->mMeshes[m]->mMaterialIndex]->GetTexture(aiTextureType_DIFFUSE, 0, &filename);
+		if (filename.length == 0) continue;
+
+		bool embedded = false;
+		for (unsigned int i = 0; i < scene->mNumTextures && !embedded; i++)
+			embedded = (filename == scene->mTextures[i]->mFilename);
+		if (embedded) continue;
+
+		Texture_Prefetch(Model_ExternalTexturePath(FileName, filename.C_Str()).c_str());
+	}
+
+	std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+	if (IsScenePrefetched(FileName))
+	{
+		aiReleaseImport(scene);
+		return;
+	}
+	g_PrefetchedScenes.push_back({ FileName, scene });
+}
+
+const aiScene* Model_TakePrefetched(const char* FileName)
+{
+	std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+	for (size_t i = 0; i < g_PrefetchedScenes.size(); i++)
+	{
+		if (g_PrefetchedScenes[i].fileName != FileName) continue;
+		const aiScene* scene = g_PrefetchedScenes[i].scene;
+		g_PrefetchedScenes.erase(g_PrefetchedScenes.begin() + i);
+		return scene;
+	}
+	return nullptr;
+}
+
+void Model_DiscardPrefetched()
+{
+	std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+	for (const PrefetchedScene& p : g_PrefetchedScenes)
+	{
+		aiReleaseImport(p.scene);
+	}
+	g_PrefetchedScenes.clear();
+}
+
+
 void ModelRelease(MODEL* model)
 {
 	for (unsigned int m = 0; m < model->AiScene->mNumMeshes; m++)
@@ -408,6 +507,67 @@ void ModelUnlitDraw(MODEL* model, const XMMATRIX& mtxWorld)
 	}
 }
 
+static_assert(sizeof(ModelMeshDraw) <= RENDER_QUEUE_INLINE_DATA, "ModelMeshDraw must fit in a queue command");
+
+void Model_Submit(MODEL* model, const XMMATRIX& mtxWorld, RenderPass pass, RenderShader shader,
+	float viewDepth, RenderQueueDrawFunc func)
+{
+	if (!model || !model->AiScene) return;
+	if (!func) func = Model_DrawMesh;
+
+	ModelMeshDraw draw;
+	draw.model = model;
+	XMStoreFloat4x4(&draw.world, mtxWorld);
+
+	for (unsigned int m = 0; m < model->AiScene->mNumMeshes; m++)
+	{
+		aiString texture;
+		aiMaterial* aimaterial = model->AiScene->mMaterials[model->AiScene->mMeshes[m]->mMaterialIndex];
+		aimaterial->GetTexture(aiTextureType_DIFFUSE, 0, &texture);
+
+		// eNX`t͔iModelDraw ͑O̐F̂܂܂AёւƑO܂Ȃj
+		const auto it = (texture.length != 0) ? model->Texture.find(texture.data) : model->Texture.end();
+		uint64_t key = 0;
+		if (it != model->Texture.end() && it->second) {
+			draw.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			key = RenderQueue_MakeViewKey(pass, shader, it->second, viewDepth);
+		}
+		else {
+			aiColor3D diffuse;
+			aimaterial->Get(AI_MATKEY_COLOR_DIFFUSE, diffuse);
+			draw.color = { diffuse.r, diffuse.g, diffuse.b, 1.0f };
+			key = RenderQueue_MakeKey(pass, shader, g_TextureWhite, viewDepth);
+		}
+
+		draw.mesh = m;
+		RenderQueue_SubmitCopy(key, func, &draw, sizeof(draw), shader);
+	}
+}
+
+void Model_DrawMesh(const void* data, int param)
+{
+	const ModelMeshDraw& draw = *static_cast<const ModelMeshDraw*>(data);
+	const XMMATRIX world = XMLoadFloat4x4(&draw.world);
+
+	if (param == RENDER_SHADER_3D_UNLIT) {
+		Shader3DUnlit_SetWorldMatrix(world);
+		Shader3DUnlit_SetColor(draw.color);
+	}
+	else {
+		Shader3D_SetWorldMatrix(world);
+		Shader3d_SetColor(draw.color);
+	}
+
+	ID3D11DeviceContext* ctx = Direct3D_GetContext();
+	ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	UINT stride = sizeof(Vertex3d);
+	UINT offset = 0;
+	ctx->IASetVertexBuffers(0, 1, &draw.model->VertexBuffer[draw.mesh], &stride, &offset);
+	ctx->IASetIndexBuffer(draw.model->IndexBuffer[draw.mesh], DXGI_FORMAT_R32_UINT, 0);
+	ctx->DrawIndexed(draw.model->AiScene->mMeshes[draw.mesh]->mNumFaces * 3, 0, 0);
+}
+
 AABB Model_GetAABB(MODEL* model, const DirectX::XMFLOAT3& position)
 {
 	return {
@@ -417,8 +577,20 @@ AABB Model_GetAABB(MODEL* model, const DirectX::XMFLOAT3& position)
 	};
 }
 
+size_t Model_GetBytes(const MODEL* model)
+{
+	if (!model || !model->AiScene) return 0;
 
-
-
-
-
+	size_t bytes = 0;
+	for (unsigned int m = 0; m < model->AiScene->mNumMeshes; m++)
+	{
+		const aiMesh* mesh = model->AiScene->mMeshes[m];
+		bytes += sizeof(Vertex3d) * mesh->mNumVertices;
+		bytes += sizeof(unsigned int) * mesh->mNumFaces * 3;
+	}
+	for (const std::pair<const std::string, ID3D11ShaderResourceView*>& pair : model->Texture)
+	{
+		bytes += Texture_GetViewBytes(pair.second);
+	}
+	return bytes;
+}
@@ -17,8 +17,10 @@
 #include "Assimp/assimp/postprocess.h"
 #include "Assimp/assimp/matrix4x4.h"
 #include <unordered_map>
+#include <string>
 
 #include"collision.h"
+#include"render_queue.h"
 #include<d3d11.h>
 #include<DirectXMath.h>
 
@@ -43,6 +45,35 @@ void ModelDraw(MODEL* model ,const DirectX::XMMATRIX& mtxWorld);
 void ModelDepthDraw(MODEL* model, const DirectX::XMMATRIX& mtxWorld);
 void ModelUnlitDraw(MODEL* model, const DirectX::XMMATRIX& mtxWorld);
 
+// `L[ɃbV1ςށishader  RENDER_SHADER_3D  RENDER_SHADER_3D_UNLITjB
+// VF[_[ƃeNX`̓L[ݒ肷̂ŁA`֐͍sEFEobt@G
+struct ModelMeshDraw
+{
+	MODEL* model = nullptr;
+	unsigned int mesh = 0;
+	DirectX::XMFLOAT4 color{ 1.0f, 1.0f, 1.0f, 1.0f };
+	DirectX::XMFLOAT4X4 world{};
+};
+void Model_Submit(MODEL* model, const DirectX::XMMATRIX& mtxWorld, RenderPass pass, RenderShader shader,
+	float viewDepth, RenderQueueDrawFunc func = nullptr);
+// Model_Submit ̊̕`֐idata  ModelMeshDrawAparam ̓VF[_[j
+void Model_DrawMesh(const void* data, int param);
+
+// ModelLoad / SkinnedModel_Load ̓ǂݍ݃tO
+constexpr unsigned int MODEL_IMPORT_FLAGS = aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_ConvertToLeftHanded;
+
+//  aiImportFile Ɖ摜̃fR[h܂ōς܂Ăiǂ̃Xbhłj
+// ModelLoad / SkinnedModel_Load ͓t@Ĉ̂΂g
+void Model_Prefetch(const char* FileName);
+// pӂĂ΃V[niCXbhjB nullptrB󂯎 aiReleaseImport 
+const aiScene* Model_TakePrefetched(const char* FileName);
+void Model_DiscardPrefetched();
+// f̃eNX` Texture_Prefetch / Texture_CreatePrefetched Ƃ̖O
+std::wstring Model_EmbeddedTextureName(const char* FileName, unsigned int index);
+std::wstring Model_ExternalTexturePath(const char* FileName, const char* texName);
+
 AABB Model_GetAABB(MODEL* model, const DirectX::XMFLOAT3& position);
+// _ECfbNXobt@ƃeNX`̂悻̃oCg
+size_t Model_GetBytes(const MODEL* model);
 
 #endif//MODEL_H
\ No newline at end of file
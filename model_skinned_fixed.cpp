@@ -11,30 +11,35 @@
 ==============================================================================*/
 
 #include "model_skinned_fixed.h"
+
+// Assimp ͂̃t@C̒Ŏgiwb_ɏoƃvC[܂ Assimp ˑɂȂj
+#include "Assimp/assimp/scene.h"
+#include "Assimp/assimp/cimport.h"
+#include "Assimp/assimp/postprocess.h"
+#include "Assimp/assimp/matrix4x4.h"
+
+#pragma comment (lib, "assimp-vc143-mt.lib")
 // --- DEFENSIVE INCLUDES (wb_ include guard Փ˂ include ̖) ---
 #include "collision.h"
 #include <unordered_map>
 #include <string>
 #include "direct3d.h"
 #include "texture.h"
+#include "model.h"
 #include "shader3d.h"
 #include "WICTextureLoader11.h"
 #include "shader_depth.h"
+#include "skinning.h"
 #include <cassert>
 #include <algorithm>
 #include <cstdint>
 #include <cmath>
+#include <cstdio>
 
 using namespace DirectX;
 
-//  shader3d  InputLayout ɍ킹邽߂̃tH[}bg
-struct SkinnedVertex3d
-{
-    XMFLOAT3 position;
-    XMFLOAT3 normalVector;
-    XMFLOAT4 color;
-    XMFLOAT2 texcoord;
-};
+//  shader3d  InputLayout ɍ킹邽߂̃tH[}bgiXLjO͂ɒڏj
+using SkinnedVertex3d = SkinningVertex;
 
 
 struct BaseVertex
@@ -93,15 +98,48 @@ struct SKINNED_MESH
     ID3D11Buffer* vb = nullptr; // dynamic
     ID3D11Buffer* ib = nullptr; // static
 
-    std::vector<BaseVertex> baseVerts;
-    std::vector<Influence4> influences;
+    // oCh|[YƉe{[iSoAjBVB  Map  Skinning_Run ږ߂
+    SkinningStreams streams;
 
     uint32_t numIndices = 0;
     uint32_t materialIndex = 0;
+};
 
-    // CPU skinning p̈ꎞƗ̈
-    std::vector<SkinnedVertex3d> skinnedVerts;
+// ǂݍݎ aiNode ̖؂𕽂ɂ́Be͕KqOɂi擪 rootj
+struct SKELETON_NODE
+{
+    XMMATRIX local;         // ǂݍݎ̃[Jsi`lƂɎgj
+    int parent = -1;        // -1  root
+    int bone = -1;          // boneFinal ̔ԍBłȂ -1
+};
+
+// 1 m[h̃L[Bƒlʂ̔zɎiSoAjB] snorm16 ɋl߂
+struct CLIP_TRACK
+{
+    std::vector<float> posTime;
+    std::vector<XMFLOAT3> posValue;
+    std::vector<float> rotTime;
+    std::vector<int16_t> rotValue;      // L[Ƃ x,y,z,w
+    std::vector<float> sclTime;
+    std::vector<XMFLOAT3> sclValue;
+};
+
+// OgL[̈ʒuBĐȂ琔i߂邾ōς
+struct KEY_CURSOR
+{
+    uint32_t pos = 0;
+    uint32_t rot = 0;
+    uint32_t scl = 0;
 };
+
+struct ANIM_CLIP
+{
+    std::vector<CLIP_TRACK> tracks;     // aiAnimation ̃`l
+    std::vector<KEY_CURSOR> cursors;    // [gbN]
+    std::vector<int> trackOfNode;       // [m[h]BȂm[h -1
+    size_t sourceBytes = 0;             //  aiNodeAnim ̃L[̃oCgirpj
+};
+
 struct SKINNED_MODEL
 {
     const aiScene* scene = nullptr;
@@ -116,6 +154,11 @@ struct SKINNED_MODEL
 
     XMMATRIX globalInverse = XMMatrixIdentity();
 
+    // skeleton
+    std::vector<SKELETON_NODE> skeleton;
+    std::vector<ANIM_CLIP> clips;                               // [Aj]
+    std::vector<XMMATRIX> nodeGlobal;                           // |[YvZ̍Ɨ̈im[hƁj
+
     // ȈՃLbV
     int lastAnimIndex = -1;
     double lastAnimTime = -1.0;
@@ -142,213 +185,238 @@ static XMMATRIX AiToXM(const aiMatrix4x4& m)
     );
 }
 
-static XMMATRIX CalcNodeLocalTransform(const aiNode* node)
-{
-    return AiToXM(node->mTransformation);
-}
+//------------------------------------------------------------------------------
+// Animation clip
+//------------------------------------------------------------------------------
+constexpr uint32_t KEY_CURSOR_STEP_MAX = 4;     // ֔񂾂V[NƂ݂Ȃē񕪒T
+constexpr float QUAT_SNORM = 32767.0f;
 
-static const aiNodeAnim* FindNodeAnim(const aiAnimation* anim, const std::string& nodeName)
+// times[i] <= t < times[i + 1] ƂȂ ii0 .. size-2jB͈͊O͒[Ɋ񂹂Btimes  2 ȏ
+static uint32_t FindKeyIndex(const std::vector<float>& times, float t, uint32_t* cursor)
 {
-    for (unsigned int i = 0; i < anim->mNumChannels; ++i)
+    const uint32_t last = (uint32_t)times.size() - 2;
+    uint32_t i = (std::min)(*cursor, last);
+
+    for (uint32_t step = 0; step < KEY_CURSOR_STEP_MAX && i < last && t >= times[i + 1]; ++step)
+        ++i;
+
+    if ((i > 0 && t < times[i]) || (i < last && t >= times[i + 1]))
     {
-        const aiNodeAnim* channel = anim->mChannels[i];
-        if (nodeName == channel->mNodeName.C_Str())
-            return channel;
+        // ߂E傫񂾁BŌ̃L[͒TȂiȍ~ last Ɋ񂹂j
+        i = (uint32_t)(std::upper_bound(times.begin() + 1, times.end() - 1, t) - (times.begin() + 1));
     }
-    return nullptr;
+
+    *cursor = i;
+    return i;
 }
 
-static unsigned int FindKeyIndex(double animTime, const aiVectorKey* keys, unsigned int numKeys)
+static float KeyFactor(const std::vector<float>& times, uint32_t i, float t)
 {
-    for (unsigned int i = 0; i + 1 < numKeys; ++i)
-    {
-        if (animTime < keys[i + 1].mTime)
-            return i;
-    }
-    return (std::max)(0u, numKeys - 1);
-
+    const float t1 = times[i];
+    const float t2 = times[i + 1];
+    if (t2 <= t1) return 0.0f;
+    return (std::max)(0.0f, (std::min)((t - t1) / (t2 - t1), 1.0f));
 }
 
-static unsigned int FindKeyIndex(double animTime, const aiQuatKey* keys, unsigned int numKeys)
+static XMVECTOR SampleVector(const std::vector<float>& times, const std::vector<XMFLOAT3>& values, float t, uint32_t* cursor)
 {
-    for (unsigned int i = 0; i + 1 < numKeys; ++i)
-    {
-        if (animTime < keys[i + 1].mTime)
-            return i;
-    }
-    return (std::max)(0u, numKeys - 1);
+    if (times.size() == 1)
+        return XMLoadFloat3(&values[0]);
 
+    const uint32_t i = FindKeyIndex(times, t, cursor);
+    return XMVectorLerp(XMLoadFloat3(&values[i]), XMLoadFloat3(&values[i + 1]), KeyFactor(times, i, t));
 }
 
-static XMMATRIX InterpolatePosition(double animTime, const aiNodeAnim* channel)
+static XMVECTOR LoadQuat(const std::vector<int16_t>& values, uint32_t i)
 {
-    if (!channel || channel->mNumPositionKeys == 0)
-        return XMMatrixIdentity();
-
-    if (channel->mNumPositionKeys == 1)
-    {
-        const aiVector3D& v = channel->mPositionKeys[0].mValue;
-        return XMMatrixTranslation(v.x, v.y, v.z);
-    }
+    const int16_t* q = &values[(size_t)i * 4];
+    return XMVectorScale(XMVectorSet(q[0], q[1], q[2], q[3]), 1.0f / QUAT_SNORM);
+}
 
-    unsigned int idx = FindKeyIndex(animTime, channel->mPositionKeys, channel->mNumPositionKeys);
-    unsigned int next = idx + 1;
+static XMVECTOR SampleRotation(const CLIP_TRACK& track, float t, uint32_t* cursor)
+{
+    if (track.rotTime.size() == 1)
+        return XMQuaternionNormalize(LoadQuat(track.rotValue, 0));
 
-    double t1 = channel->mPositionKeys[idx].mTime;
-    double t2 = channel->mPositionKeys[next].mTime;
-    float factor = (t2 > t1) ? (float)((animTime - t1) / (t2 - t1)) : 0.0f;
+    const uint32_t i = FindKeyIndex(track.rotTime, t, cursor);
+    const XMVECTOR q = XMQuaternionSlerp(LoadQuat(track.rotValue, i), LoadQuat(track.rotValue, i + 1),
+        KeyFactor(track.rotTime, i, t));
+    return XMQuaternionNormalize(q);
+}
 
-    const aiVector3D& a = channel->mPositionKeys[idx].mValue;
-    const aiVector3D& b = channel->mPositionKeys[next].mValue;
+// row-vector Łupos * S * R * TvɂȂ悤ɂ
+static XMMATRIX SampleTrack(const CLIP_TRACK& track, KEY_CURSOR* cursor, float t)
+{
+    XMMATRIX S = XMMatrixIdentity();
+    XMMATRIX R = XMMatrixIdentity();
+    XMMATRIX T = XMMatrixIdentity();
+
+    if (!track.sclTime.empty())
+        S = XMMatrixScalingFromVector(SampleVector(track.sclTime, track.sclValue, t, &cursor->scl));
+    if (!track.rotTime.empty())
+        R = XMMatrixRotationQuaternion(SampleRotation(track, t, &cursor->rot));
+    if (!track.posTime.empty())
+        T = XMMatrixTranslationFromVector(SampleVector(track.posTime, track.posValue, t, &cursor->pos));
+
+    return S * R * T;
+}
 
-    aiVector3D out = a + (b - a) * factor;
-    return XMMatrixTranslation(out.x, out.y, out.z);
+static void CompileVectorKeys(const aiVectorKey* keys, unsigned int numKeys,
+    std::vector<float>& outTime, std::vector<XMFLOAT3>& outValue)
+{
+    outTime.resize(numKeys);
+    outValue.resize(numKeys);
+    for (unsigned int k = 0; k < numKeys; ++k)
+    {
+        outTime[k] = (float)keys[k].mTime;
+        outValue[k] = { keys[k].mValue.x, keys[k].mValue.y, keys[k].mValue.z };
+    }
 }
 
-static XMMATRIX InterpolateScaling(double animTime, const aiNodeAnim* channel)
+static void CompileTrack(const aiNodeAnim* channel, CLIP_TRACK* out)
 {
-    if (!channel || channel->mNumScalingKeys == 0)
-        return XMMatrixIdentity();
+    CompileVectorKeys(channel->mPositionKeys, channel->mNumPositionKeys, out->posTime, out->posValue);
+    CompileVectorKeys(channel->mScalingKeys, channel->mNumScalingKeys, out->sclTime, out->sclValue);
 
-    if (channel->mNumScalingKeys == 1)
+    out->rotTime.resize(channel->mNumRotationKeys);
+    out->rotValue.resize((size_t)channel->mNumRotationKeys * 4);
+    for (unsigned int k = 0; k < channel->mNumRotationKeys; ++k)
     {
-        const aiVector3D& v = channel->mScalingKeys[0].mValue;
-        return XMMatrixScaling(v.x, v.y, v.z);
+        const aiQuaternion& q = channel->mRotationKeys[k].mValue;
+        XMFLOAT4 n;
+        XMStoreFloat4(&n, XMQuaternionNormalize(XMVectorSet(q.x, q.y, q.z, q.w)));
+
+        const float v[4] = { n.x, n.y, n.z, n.w };
+        out->rotTime[k] = (float)channel->mRotationKeys[k].mTime;
+        for (int c = 0; c < 4; ++c)
+            out->rotValue[(size_t)k * 4 + c] = (int16_t)std::lround((std::max)(-1.0f, (std::min)(v[c], 1.0f)) * QUAT_SNORM);
     }
+}
 
-    unsigned int idx = FindKeyIndex(animTime, channel->mScalingKeys, channel->mNumScalingKeys);
-    unsigned int next = idx + 1;
+static size_t ClipBytes(const ANIM_CLIP& clip)
+{
+    size_t bytes = clip.tracks.capacity() * sizeof(CLIP_TRACK)
+        + clip.cursors.capacity() * sizeof(KEY_CURSOR)
+        + clip.trackOfNode.capacity() * sizeof(int);
+    for (const CLIP_TRACK& t : clip.tracks)
+    {
+        bytes += (t.posTime.capacity() + t.rotTime.capacity() + t.sclTime.capacity()) * sizeof(float);
+        bytes += (t.posValue.capacity() + t.sclValue.capacity()) * sizeof(XMFLOAT3);
+        bytes += t.rotValue.capacity() * sizeof(int16_t);
+    }
+    return bytes;
+}
 
-    double t1 = channel->mScalingKeys[idx].mTime;
-    double t2 = channel->mScalingKeys[next].mTime;
-    float factor = (t2 > t1) ? (float)((animTime - t1) / (t2 - t1)) : 0.0f;
+//------------------------------------------------------------------------------
+// Skeleton
+//------------------------------------------------------------------------------
+// ؂sɕׂBO͓ǂݍݒ̑Ήtɂg
+static void FlattenNodes(const aiNode* node, int parent,
+    std::vector<SKELETON_NODE>& outNodes, std::vector<std::string>& outNames)
+{
+    const int index = (int)outNodes.size();
 
-    const aiVector3D& a = channel->mScalingKeys[idx].mValue;
-    const aiVector3D& b = channel->mScalingKeys[next].mValue;
+    SKELETON_NODE n;
+    n.local = AiToXM(node->mTransformation);
+    n.parent = parent;
+    outNodes.push_back(n);
+    outNames.push_back(node->mName.C_Str());
 
-    aiVector3D out = a + (b - a) * factor;
-    return XMMatrixScaling(out.x, out.y, out.z);
+    for (unsigned int i = 0; i < node->mNumChildren; ++i)
+        FlattenNodes(node->mChildren[i], index, outNodes, outNames);
 }
 
-static XMMATRIX InterpolateRotation(double animTime, const aiNodeAnim* channel)
+// m[hɍƃ`lѕtit[̖Oōς܂j
+static void BuildSkeleton(SKINNED_MODEL* model)
 {
-    if (!channel || channel->mNumRotationKeys == 0)
-        return XMMatrixIdentity();
+    std::vector<std::string> names;
+    model->skeleton.clear();
+    FlattenNodes(model->scene->mRootNode, -1, model->skeleton, names);
 
-    if (channel->mNumRotationKeys == 1)
+    for (size_t i = 0; i < model->skeleton.size(); ++i)
     {
-        const aiQuaternion& q = channel->mRotationKeys[0].mValue;
-        XMVECTOR rot = XMVectorSet(q.x, q.y, q.z, q.w);
-        return XMMatrixRotationQuaternion(rot);
+        auto it = model->boneMap.find(names[i]);
+        if (it != model->boneMap.end())
+            model->skeleton[i].bone = (int)it->second;
     }
 
-    unsigned int idx = FindKeyIndex(animTime, channel->mRotationKeys, channel->mNumRotationKeys);
-    unsigned int next = idx + 1;
-
-    double t1 = channel->mRotationKeys[idx].mTime;
-    double t2 = channel->mRotationKeys[next].mTime;
-    float factor = (t2 > t1) ? (float)((animTime - t1) / (t2 - t1)) : 0.0f;
-
-    const aiQuaternion& a = channel->mRotationKeys[idx].mValue;
-    const aiQuaternion& b = channel->mRotationKeys[next].mValue;
+    model->clips.assign(model->scene->mNumAnimations, {});
+    size_t sourceBytes = 0;
+    size_t compactBytes = 0;
+    for (unsigned int a = 0; a < model->scene->mNumAnimations; ++a)
+    {
+        const aiAnimation* anim = model->scene->mAnimations[a];
+        ANIM_CLIP& clip = model->clips[a];
 
-    aiQuaternion out;
-    aiQuaternion::Interpolate(out, a, b, factor);
-    out.Normalize();
+        clip.tracks.resize(anim->mNumChannels);
+        clip.cursors.resize(anim->mNumChannels);
 
-    XMVECTOR rot = XMVectorSet(out.x, out.y, out.z, out.w);
-    return XMMatrixRotationQuaternion(rot);
-}
+        // Õ`lΐ̂̂g
+        std::unordered_map<std::string, int> byName;
+        for (unsigned int c = 0; c < anim->mNumChannels; ++c)
+        {
+            const aiNodeAnim* channel = anim->mChannels[c];
+            CompileTrack(channel, &clip.tracks[c]);
+            byName.emplace(channel->mNodeName.C_Str(), (int)c);
 
-static void ReadNodeHierarchy(
-    double animTime,
-    const aiNode* node,
-    const XMMATRIX& parentTransform,
-    const aiAnimation* anim,
-    const std::unordered_map<std::string, uint32_t>& boneMap,
-    const std::vector<XMMATRIX>& boneOffset,
-    const XMMATRIX& globalInverse,
-    std::vector<XMMATRIX>& outFinal
-)
-{
-    std::string nodeName = node->mName.C_Str();
+            clip.sourceBytes += sizeof(aiNodeAnim)
+                + (channel->mNumPositionKeys + channel->mNumScalingKeys) * sizeof(aiVectorKey)
+                + channel->mNumRotationKeys * sizeof(aiQuatKey);
+        }
 
-    XMMATRIX nodeTransform = CalcNodeLocalTransform(node);
+        clip.trackOfNode.assign(model->skeleton.size(), -1);
+        for (size_t i = 0; i < model->skeleton.size(); ++i)
+        {
+            auto it = byName.find(names[i]);
+            if (it != byName.end()) clip.trackOfNode[i] = it->second;
+        }
 
-    const aiNodeAnim* channel = FindNodeAnim(anim, nodeName);
-    if (channel)
-    {
-        // row-vector Łupos * S * R * TvɂȂ悤ɂ
-        XMMATRIX S = InterpolateScaling(animTime, channel);
-        XMMATRIX R = InterpolateRotation(animTime, channel);
-        XMMATRIX T = InterpolatePosition(animTime, channel);
-        nodeTransform = S * R * T;
+        sourceBytes += clip.sourceBytes;
+        compactBytes += ClipBytes(clip);
     }
 
-    // row-vectorFq̃[JɂāAe̕ϊɂ
-    XMMATRIX globalTransform = nodeTransform * parentTransform;
+#if defined(_DEBUG)
+    char buf[128];
+    sprintf_s(buf, "SkinnedModel clips:%u keys %zuKB -> %zuKB\n",
+        model->scene->mNumAnimations, sourceBytes >> 10, compactBytes >> 10);
+    OutputDebugStringA(buf);
+#endif
 
-    auto it = boneMap.find(nodeName);
-    if (it != boneMap.end())
-    {
-        uint32_t boneIndex = it->second;
-        // AssimpԂ row-vector ɒ`
-        outFinal[boneIndex] = boneOffset[boneIndex] * globalTransform * globalInverse;
-    }
-
-    for (unsigned int i = 0; i < node->mNumChildren; ++i)
-    {
-        ReadNodeHierarchy(animTime, node->mChildren[i], globalTransform, anim, boneMap, boneOffset, globalInverse, outFinal);
-    }
+    model->nodeGlobal.assign(model->skeleton.size(), XMMatrixIdentity());
 }
 
-static void ReadNodeHierarchyBindPose(
-    const aiNode* node,
-    const DirectX::XMMATRIX& parentTransform,
-    const std::unordered_map<std::string, uint32_t>& boneMap,
-    const std::vector<DirectX::XMMATRIX>& boneOffset,
-    const DirectX::XMMATRIX& globalInverse,
-    std::vector<DirectX::XMMATRIX>& outFinal
-)
+// e珇 1 Ȃ߂ boneFinal Bclip  nullptr ȂoCh|[Y
+static void EvaluateSkeleton(SKINNED_MODEL* model, ANIM_CLIP* clip, double animTime)
 {
-    using namespace DirectX;
-
-    std::string nodeName = node->mName.C_Str();
+    const size_t count = model->skeleton.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const SKELETON_NODE& node = model->skeleton[i];
 
-    // ǂݍݎibind/restj̃[Js
-    XMMATRIX nodeTransform = CalcNodeLocalTransform(node);
+        XMMATRIX nodeTransform = node.local;
+        const int track = clip ? clip->trackOfNode[i] : -1;
+        if (track >= 0)
+            nodeTransform = SampleTrack(clip->tracks[track], &clip->cursors[track], (float)animTime);
 
-    // row-vector nȂ̂Łuq * ev
-    XMMATRIX globalTransform = nodeTransform * parentTransform;
+        // row-vectorFq̃[JɂāAe̕ϊɂ
+        const XMMATRIX globalTransform = (node.parent >= 0)
+            ? nodeTransform * model->nodeGlobal[node.parent]
+            : nodeTransform;
+        model->nodeGlobal[i] = globalTransform;
 
-    auto it = boneMap.find(nodeName);
-    if (it != boneMap.end())
-    {
-        uint32_t boneIndex = it->second;
-        if (boneIndex < outFinal.size())
+        if (node.bone >= 0)
         {
-            outFinal[boneIndex] = boneOffset[boneIndex] * globalTransform * globalInverse;
+            // AssimpԂ row-vector ɒ`
+            model->boneFinal[node.bone] = model->boneOffset[node.bone] * globalTransform * model->globalInverse;
         }
     }
-
-    for (unsigned int i = 0; i < node->mNumChildren; ++i)
-    {
-        ReadNodeHierarchyBindPose(
-            node->mChildren[i],
-            globalTransform,
-            boneMap,
-            boneOffset,
-            globalInverse,
-            outFinal
-        );
-    }
 }
 
 
 //------------------------------------------------------------------------------
 // Texture helper (model.cpp Ƃقړ)
 //------------------------------------------------------------------------------
-static void LoadEmbeddedTextures(SKINNED_MODEL* model)
+static void LoadEmbeddedTextures(SKINNED_MODEL* model, const char* fileName)
 {
     for (unsigned int i = 0; i < model->scene->mNumTextures; ++i)
     {
@@ -357,13 +425,16 @@ static void LoadEmbeddedTextures(SKINNED_MODEL* model)
         ID3D11ShaderResourceView* texture = nullptr;
         ID3D11Resource* resource = nullptr;
 
-        CreateWICTextureFromMemory(
-            Direct3D_GetDevice(),
-            Direct3D_GetContext(),
-            (const uint8_t*)aitexture->pcData,
-            (size_t)aitexture->mWidth,
-            &resource,
-            &texture);
+        if (!Texture_CreatePrefetched(Model_EmbeddedTextureName(fileName, i).c_str(), &resource, &texture))
+        {
+            CreateWICTextureFromMemory(
+                Direct3D_GetDevice(),
+                Direct3D_GetContext(),
+                (const uint8_t*)aitexture->pcData,
+                (size_t)aitexture->mWidth,
+                &resource,
+                &texture);
+        }
 
         assert(texture);
         if (resource) resource->Release();
@@ -374,10 +445,6 @@ static void LoadEmbeddedTextures(SKINNED_MODEL* model)
 
 static void LoadExternalTextures(SKINNED_MODEL* model, const char* fileName)
 {
-    const std::string modelPath(fileName);
-    size_t pos = modelPath.find_last_of("/\\");
-    std::string directory = (pos != std::string::npos) ? modelPath.substr(0, pos) : "";
-
     for (unsigned int m = 0; m < model->scene->mNumMeshes; ++m)
     {
         aiMesh* mesh = model->scene->mMeshes[m];
@@ -388,21 +455,20 @@ static void LoadExternalTextures(SKINNED_MODEL* model, const char* fileName)
         if (filename.length == 0) continue;
         if (model->textures.count(filename.C_Str())) continue;
 
-        std::string texfilename = directory + "/" + filename.C_Str();
-
-        int len = MultiByteToWideChar(CP_UTF8, 0, texfilename.c_str(), -1, nullptr, 0);
-        std::vector<wchar_t> wpath((size_t)len);
-        MultiByteToWideChar(CP_UTF8, 0, texfilename.c_str(), -1, wpath.data(), len);
+        const std::wstring wpath = Model_ExternalTexturePath(fileName, filename.C_Str());
 
         ID3D11ShaderResourceView* texture = nullptr;
         ID3D11Resource* resource = nullptr;
 
-        CreateWICTextureFromFile(
-            Direct3D_GetDevice(),
-            Direct3D_GetContext(),
-            wpath.data(),
-            &resource,
-            &texture);
+        if (!Texture_CreatePrefetched(wpath.c_str(), &resource, &texture))
+        {
+            CreateWICTextureFromFile(
+                Direct3D_GetDevice(),
+                Direct3D_GetContext(),
+                wpath.c_str(),
+                &resource,
+                &texture);
+        }
 
         if (!texture)
             continue;
@@ -421,7 +487,10 @@ SKINNED_MODEL* SkinnedModel_Load(const char* fileName, float scale, bool isBrend
 
     model->importScale = scale;
 
-    model->scene = aiImportFile(fileName, aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_ConvertToLeftHanded);
+    // œǂł΂g
+    model->scene = Model_TakePrefetched(fileName);
+    if (!model->scene)
+        model->scene = aiImportFile(fileName, MODEL_IMPORT_FLAGS);
     assert(model->scene);
 
     // O[ots
@@ -430,7 +499,7 @@ SKINNED_MODEL* SkinnedModel_Load(const char* fileName, float scale, bool isBrend
 
     // eNX`
     if (g_TextureWhite < 0) g_TextureWhite = Texture_Load(L"white.png");
-    LoadEmbeddedTextures(model);
+    LoadEmbeddedTextures(model, fileName);
     LoadExternalTextures(model, fileName);
 
     // bV
@@ -444,9 +513,10 @@ SKINNED_MODEL* SkinnedModel_Load(const char* fileName, float scale, bool isBrend
         SKINNED_MESH& out = model->meshes[m];
         out.materialIndex = mesh->mMaterialIndex;
 
-        out.baseVerts.resize(mesh->mNumVertices);
-        out.influences.resize(mesh->mNumVertices);
-        out.skinnedVerts.resize(mesh->mNumVertices);
+        // ǂݍݒgiŌ out.streams ɋl߂j
+        std::vector<BaseVertex> baseVerts(mesh->mNumVertices);
+        std::vector<Influence4> influences(mesh->mNumVertices);
+        std::vector<SkinnedVertex3d> skinnedVerts(mesh->mNumVertices);
 
         // base vertices
         for (unsigned int v = 0; v < mesh->mNumVertices; ++v)
@@ -471,7 +541,7 @@ SKINNED_MODEL* SkinnedModel_Load(const char* fileName, float scale, bool isBrend
             else
                 bv.uv = XMFLOAT2(0, 0);
 
-            out.baseVerts[v] = bv;
+            baseVerts[v] = bv;
 
             // local AABB (bind pose)
             if (!aabbInit)
@@ -491,10 +561,10 @@ SKINNED_MODEL* SkinnedModel_Load(const char* fileName, float scale, bool isBrend
             }
 
             // ̓oCh|[Ŷ܂ܓĂ
-            out.skinnedVerts[v].position = bv.position;
-            out.skinnedVerts[v].normalVector = bv.normal;
-            out.skinnedVerts[v].texcoord = bv.uv;
-            out.skinnedVerts[v].color = XMFLOAT4(1, 1, 1, 1);
+            skinnedVerts[v].position = bv.position;
+            skinnedVerts[v].normal = bv.normal;
+            skinnedVerts[v].texcoord = bv.uv;
+            skinnedVerts[v].color = XMFLOAT4(1, 1, 1, 1);
         }
 
         // bones  _ê݂L^
@@ -521,13 +591,20 @@ SKINNED_MODEL* SkinnedModel_Load(const char* fileName, float scale, bool isBrend
             for (unsigned int w = 0; w < bone->mNumWeights; ++w)
             {
                 const aiVertexWeight& vw = bone->mWeights[w];
-                out.influences[vw.mVertexId].Add((uint16_t)boneIndex, vw.mWeight);
+                influences[vw.mVertexId].Add((uint16_t)boneIndex, vw.mWeight);
             }
         }
 
-        for (auto& inf : out.influences)
+        for (auto& inf : influences)
             inf.Normalize();
 
+        Skinning_Resize(&out.streams, (int)mesh->mNumVertices);
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v)
+        {
+            const BaseVertex& bv = baseVerts[v];
+            Skinning_SetVertex(&out.streams, (int)v, bv.position, bv.normal, bv.uv, influences[v].idx, influences[v].w);
+        }
+
         // index buffer
         std::vector<uint32_t> indices;
         indices.reserve(mesh->mNumFaces * 3);
@@ -547,12 +624,12 @@ SKINNED_MODEL* SkinnedModel_Load(const char* fileName, float scale, bool isBrend
         {
             D3D11_BUFFER_DESC bd{};
             bd.Usage = D3D11_USAGE_DYNAMIC;
-            bd.ByteWidth = (UINT)(sizeof(SkinnedVertex3d) * out.skinnedVerts.size());
+            bd.ByteWidth = (UINT)(sizeof(SkinnedVertex3d) * skinnedVerts.size());
             bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
             bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 
             D3D11_SUBRESOURCE_DATA sd{};
-            sd.pSysMem = out.skinnedVerts.data();
+            sd.pSysMem = skinnedVerts.data();
 
             HRESULT hr = Direct3D_GetDevice()->CreateBuffer(&bd, &sd, &out.vb);
             assert(SUCCEEDED(hr));
@@ -572,9 +649,33 @@ SKINNED_MODEL* SkinnedModel_Load(const char* fileName, float scale, bool isBrend
         }
     }
 
+    // ̓bVSǂł瑵̂ōŌɍ
+    BuildSkeleton(model);
+
     return model;
 }
 
+size_t SkinnedModel_GetBytes(const SKINNED_MODEL* model)
+{
+    if (!model) return 0;
+
+    size_t bytes = 0;
+    for (const auto& mesh : model->meshes)
+    {
+        bytes += Skinning_GetBytes(mesh.streams);
+        if (mesh.vb) bytes += (size_t)mesh.streams.vertexCount * sizeof(SkinnedVertex3d);
+        bytes += mesh.numIndices * sizeof(uint32_t);
+    }
+    for (const auto& kv : model->textures)
+        bytes += Texture_GetViewBytes(kv.second);
+
+    bytes += (model->boneOffset.capacity() + model->boneFinal.capacity()) * sizeof(XMMATRIX);
+    bytes += model->skeleton.capacity() * sizeof(SKELETON_NODE) + model->nodeGlobal.capacity() * sizeof(XMMATRIX);
+    for (const auto& clip : model->clips)
+        bytes += ClipBytes(clip);
+    return bytes;
+}
+
 void SkinnedModel_Release(SKINNED_MODEL* model)
 {
     if (!model) return;
@@ -611,6 +712,25 @@ static const aiAnimation* SkinnedModel_GetAnimation(SKINNED_MODEL* model, int& a
     return model->scene->mAnimations[animationIndex];
 }
 
+// boneFinal őSbVό` VB ɏBMap ɒڏ̂ CPU ̎ʂ͎Ȃ
+static void SkinnedModel_SkinMeshes(SKINNED_MODEL* model)
+{
+    ID3D11DeviceContext* ctx = Direct3D_GetContext();
+    const int boneCount = (int)model->boneFinal.size();
+
+    for (SKINNED_MESH& mesh : model->meshes)
+    {
+        if (!mesh.vb) continue;
+
+        D3D11_MAPPED_SUBRESOURCE mapped{};
+        HRESULT hr = ctx->Map(mesh.vb, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+        if (FAILED(hr)) continue;
+
+        Skinning_Run(mesh.streams, model->boneFinal.data(), boneCount, (SkinnedVertex3d*)mapped.pData);
+        ctx->Unmap(mesh.vb, 0);
+    }
+}
+
 static void SkinnedModel_ApplyAnimation(SKINNED_MODEL* model,
     const aiAnimation* anim,
     int animationIndex,
@@ -629,78 +749,9 @@ static void SkinnedModel_ApplyAnimation(SKINNED_MODEL* model,
         mtx = XMMatrixIdentity();
     }
 
-    ReadNodeHierarchy(
-        animTime,
-        model->scene->mRootNode,
-        XMMatrixIdentity(),
-        anim,
-        model->boneMap,
-        model->boneOffset,
-        model->globalInverse,
-        model->boneFinal);
-
-    
-    ID3D11DeviceContext* ctx = Direct3D_GetContext();
-
-    for (unsigned int m = 0; m < model->meshes.size(); ++m)
-    {
-        SKINNED_MESH& mesh = model->meshes[m];
-
-        // CPU skinning
-        for (size_t v = 0; v < mesh.baseVerts.size(); ++v)
-        {
-            const BaseVertex& bv = mesh.baseVerts[v];
-            const Influence4& inf = mesh.influences[v];
-
-            XMVECTOR p = XMLoadFloat3(&bv.position);
-            XMVECTOR n = XMLoadFloat3(&bv.normal);
+    EvaluateSkeleton(model, &model->clips[animationIndex], animTime);
 
-            XMVECTOR pOut = XMVectorZero();
-            XMVECTOR nOut = XMVectorZero();
-            float sumW = 0.0f;
-
-            for (int i = 0; i < 4; ++i)
-            {
-                float w = inf.w[i];
-                if (w <= 0.0f) continue;
-
-                sumW += w;
-
-                uint32_t bi = inf.idx[i];
-                if (bi >= model->boneFinal.size()) continue;
-
-                XMMATRIX M = model->boneFinal[bi];
-
-                XMVECTOR tp = XMVector3TransformCoord(p, M);
-                XMVECTOR tn = XMVector3TransformNormal(n, M);
-
-                pOut += tp * w;
-                nOut += tn * w;
-            }
-
-
-            if (sumW <= 0.0f)
-            {
-                pOut = p;
-                nOut = n;
-            }
-
-            nOut = XMVector3Normalize(nOut);
-
-            XMStoreFloat3(&mesh.skinnedVerts[v].position, pOut);
-            XMStoreFloat3(&mesh.skinnedVerts[v].normalVector, nOut);
-            // uv/color ͕ςȂ
-        }
-
-        // Map/Unmap
-        D3D11_MAPPED_SUBRESOURCE mapped{};
-        HRESULT hr = ctx->Map(mesh.vb, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-        if (SUCCEEDED(hr))
-        {
-            memcpy(mapped.pData, mesh.skinnedVerts.data(), sizeof(SkinnedVertex3d) * mesh.skinnedVerts.size());
-            ctx->Unmap(mesh.vb, 0);
-        }
-    }
+    SkinnedModel_SkinMeshes(model);
 }
 
 //------------------------------------------------------------------------------
@@ -789,78 +840,10 @@ void SkinnedModel_ResetPose(SKINNED_MODEL* model)
         mtx = XMMatrixIdentity();
 
     // ǂݍݎ|[Yibind/restj boneFinal 
-    ReadNodeHierarchyBindPose(
-        model->scene->mRootNode,
-        XMMatrixIdentity(),
-        model->boneMap,
-        model->boneOffset,
-        model->globalInverse,
-        model->boneFinal
-    );
+    EvaluateSkeleton(model, nullptr, 0.0);
 
     // boneFinal  CPU XLjO VB XViApplyAnimation Ɠj
-    ID3D11DeviceContext* ctx = Direct3D_GetContext();
-
-    for (unsigned int m = 0; m < model->meshes.size(); ++m)
-    {
-        SKINNED_MESH& mesh = model->meshes[m];
-
-        for (size_t v = 0; v < mesh.baseVerts.size(); ++v)
-        {
-            const BaseVertex& bv = mesh.baseVerts[v];
-            const Influence4& inf = mesh.influences[v];
-
-            XMVECTOR p = XMLoadFloat3(&bv.position);
-            XMVECTOR n = XMLoadFloat3(&bv.normal);
-
-            XMVECTOR pOut = XMVectorZero();
-            XMVECTOR nOut = XMVectorZero();
-            float sumW = 0.0f;
-
-            for (int i = 0; i < 4; ++i)
-            {
-                float w = inf.w[i];
-                if (w <= 0.0f) continue;
-
-                uint32_t bi = inf.idx[i];
-                if (bi >= model->boneFinal.size()) continue;
-
-                sumW += w;
-
-                XMMATRIX M = model->boneFinal[bi];
-                pOut += XMVector3TransformCoord(p, M) * w;
-                nOut += XMVector3TransformNormal(n, M) * w;
-            }
-
-            if (sumW <= 0.0f)
-            {
-                // EFCg_͂̂܂
-                pOut = p;
-                nOut = n;
-            }
-            else
-            {
-                // ÔߐKiinf.Normalize() ς݂Ȃsvj
-                float inv = 1.0f / sumW;
-                pOut *= inv;
-                nOut *= inv;
-            }
-
-            nOut = XMVector3Normalize(nOut);
-
-            XMStoreFloat3(&mesh.skinnedVerts[v].position, pOut);
-            XMStoreFloat3(&mesh.skinnedVerts[v].normalVector, nOut);
-        }
-
-        D3D11_MAPPED_SUBRESOURCE mapped{};
-        HRESULT hr = ctx->Map(mesh.vb, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-        if (SUCCEEDED(hr))
-        {
-            memcpy(mapped.pData, mesh.skinnedVerts.data(),
-                sizeof(SkinnedVertex3d) * mesh.skinnedVerts.size());
-            ctx->Unmap(mesh.vb, 0);
-        }
-    }
+    SkinnedModel_SkinMeshes(model);
 }
 
 
@@ -912,6 +895,61 @@ void SkinnedModel_Draw(SKINNED_MODEL* model, const XMMATRIX& mtxWorld)
     }
 }
 
+namespace
+{
+    struct SkinnedMeshDraw
+    {
+        SKINNED_MODEL* model = nullptr;
+        unsigned int mesh = 0;
+        XMFLOAT4X4 world{};
+    };
+
+    void DrawSkinnedMesh(const void* data, int)
+    {
+        const SkinnedMeshDraw& draw = *static_cast<const SkinnedMeshDraw*>(data);
+        SKINNED_MESH& mesh = draw.model->meshes[draw.mesh];
+
+        Shader3d_SetColor({ 1,1,1,1 });
+        Shader3D_SetWorldMatrix(XMLoadFloat4x4(&draw.world));
+
+        ID3D11DeviceContext* ctx = Direct3D_GetContext();
+        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+        UINT stride = sizeof(SkinnedVertex3d);
+        UINT offset = 0;
+        ctx->IASetVertexBuffers(0, 1, &mesh.vb, &stride, &offset);
+        ctx->IASetIndexBuffer(mesh.ib, DXGI_FORMAT_R32_UINT, 0);
+        ctx->DrawIndexed(mesh.numIndices, 0, 0);
+    }
+}
+
+void SkinnedModel_Submit(SKINNED_MODEL* model, const XMMATRIX& mtxWorld, RenderPass pass, float viewDepth)
+{
+    if (!model || !model->scene) return;
+
+    // SkinnedModel_Draw Ɠ importScale ͊|Ȃ
+    SkinnedMeshDraw draw;
+    draw.model = model;
+    XMStoreFloat4x4(&draw.world, mtxWorld);
+
+    for (unsigned int m = 0; m < model->meshes.size(); ++m)
+    {
+        aiMesh* aiMeshPtr = model->scene->mMeshes[m];
+        aiMaterial* mat = model->scene->mMaterials[aiMeshPtr->mMaterialIndex];
+
+        aiString tex;
+        mat->GetTexture(aiTextureType_DIFFUSE, 0, &tex);
+
+        const auto it = (tex.length != 0) ? model->textures.find(tex.C_Str()) : model->textures.end();
+        const uint64_t key = (it != model->textures.end())
+            ? RenderQueue_MakeViewKey(pass, RENDER_SHADER_3D, it->second, viewDepth)
+            : RenderQueue_MakeKey(pass, RENDER_SHADER_3D, g_TextureWhite, viewDepth);
+
+        draw.mesh = m;
+        RenderQueue_SubmitCopy(key, DrawSkinnedMesh, &draw, sizeof(draw));
+    }
+}
+
 void SkinnedModel_DepthDraw(SKINNED_MODEL* model, const DirectX::XMMATRIX& mtxWorld)
 {
     if (!model || !model->scene) return;
@@ -23,14 +23,8 @@
 #include <vector>
 #include <string>
 
-#include "Assimp/assimp/scene.h"
-#include "Assimp/assimp/cimport.h"
-#include "Assimp/assimp/postprocess.h"
-#include "Assimp/assimp/matrix4x4.h"
-
 #include "collision.h"
-
-#pragma comment (lib, "assimp-vc143-mt.lib")
+#include "render_queue.h"
 
 
 struct SKINNED_MODEL;
@@ -55,8 +49,13 @@ void SkinnedModel_ResetPose(SKINNED_MODEL* model);
 void SkinnedModel_Draw(SKINNED_MODEL* model, const DirectX::XMMATRIX& mtxWorld);
 
 void SkinnedModel_DepthDraw(SKINNED_MODEL* model, const DirectX::XMMATRIX& mtxWorld);
+// `L[ɃbV1ςށiRENDER_SHADER_3DBVF[_[ƃeNX`̓L[ݒ肷j
+void SkinnedModel_Submit(SKINNED_MODEL* model, const DirectX::XMMATRIX& mtxWorld, RenderPass pass, float viewDepth);
 
 // AABB
 AABB SkinnedModel_GetAABB(SKINNED_MODEL* model, const DirectX::XMFLOAT3& position);
 
+// GPU obt@EeNX` CPU XLjOp̔ẑ悻̃oCg
+size_t SkinnedModel_GetBytes(const SKINNED_MODEL* model);
+
 #endif//MODLE_SKINNED_FIXED_H
@@ -8,7 +8,6 @@
 ==============================================================================*/
 
 #include "player.h"
-#include"model.h"
 #include"key_logger.h"
 #include"light.h"
 #include"camera.h"
@@ -16,6 +15,7 @@
 //#include"cube_.h"
 //#include"map.h"
 #include "model_skinned_fixed.h"
+#include "asset_cache.h"
 //#include "stage01_manage.h"
 // #include "stage_map.h"  
 #include"collision.h"
@@ -23,6 +23,7 @@
 #include "imgui_manager.h"
 #include "gamepad.h"
 #include "player_action.h"
+#include "fixed_step.h"
 #include"billboard.h"
 #include "stage_simple_manager.h"
 #include<DirectXMath.h>
@@ -30,6 +31,7 @@
 #include <cmath>
 #include <algorithm>
 #include <cfloat>
+#include <vector>
 
 using namespace DirectX;
 
@@ -53,57 +55,51 @@ static inline float ClampFloat(float v, float lo, float hi)
 	if (v > hi) return hi;
 	return v;
 }
-//サイズ０にして描画とコリジョンを消す
-static void HideStageBlockRuntime(int index)
-{
-	StageBlock* block = Stage01_GetMutable(index);
-	if (!block) return;
-
-	block->positionOffset.y -= 10000.0f;
-	block->sizeOffset.x = -block->size.x;
-	block->sizeOffset.y = -block->size.y;
-	block->sizeOffset.z = -block->size.z;
-	Stage01_RebuildObject(index);
-}
 
-// ちょい下を調べて「床がある」なら groundY(床の上面Y) を返す
-static bool ProbeGroundY(const DirectX::XMVECTOR& position, float eps, float* outGroundY)
+// ちょい下を調べて「床がある」なら groundY(床の上面Y) を返す（outIndex にはそのブロック）
+static bool ProbeGroundY(const DirectX::XMVECTOR& position, float eps, float* outGroundY, int* outIndex = nullptr)
 {
 	if (outGroundY) *outGroundY = 0.0f;
+	if (outIndex) *outIndex = -1;
 
 	AABB playerAabb = Player_ConvertPositionToAABB(position);
 
 	bool found = false;
 	float bestY = -FLT_MAX;
+	int bestIndex = -1;
 
-	const int n = Stage01_GetCount();
-	for (int i = 0; i < n; ++i)
-	{
-		const StageBlock* b = Stage01_Get(i);
-		if (!b) continue;
+	// 上面が足元の -eps..+0.002 にあるブロックだけ候補にする
+	AABB probe = playerAabb;
+	probe.max.y = playerAabb.min.y + 0.002f;
+	probe.min.y = playerAabb.min.y - eps;
 
-		const AABB& box = b->aabb;
+	Stage01_QueryAABB(probe, [&](int index, const StageBlock& b)
+		{
+			const AABB& box = b.aabb;
 
-		// XZ の足裏が乗ってるか（投影でチェック）
-		const bool overlapXZ = !(playerAabb.max.x <= box.min.x || playerAabb.min.x >= box.max.x ||
-			playerAabb.max.z <= box.min.z || playerAabb.min.z >= box.max.z);
-		if (!overlapXZ) continue;
+			// XZ の足裏が乗ってるか（投影でチェック）
+			const bool overlapXZ = !(playerAabb.max.x <= box.min.x || playerAabb.min.x >= box.max.x ||
+				playerAabb.max.z <= box.min.z || playerAabb.min.z >= box.max.z);
+			if (!overlapXZ) return true;
 
-		// 足元が床の上面からどれだけ上か
-		const float dy = playerAabb.min.y - box.max.y;
+			// 足元が床の上面からどれだけ上か
+			const float dy = playerAabb.min.y - box.max.y;
 
-		// dyが 0..eps（＋微小な誤差は許容）なら接地扱い
-		if (dy >= -0.002f && dy <= eps)
-		{
-			if (box.max.y > bestY)
+			// dyが 0..eps（＋微小な誤差は許容）なら接地扱い
+			if (dy >= -0.002f && dy <= eps)
 			{
-				bestY = box.max.y;
-				found = true;
+				if (box.max.y > bestY)
+				{
+					bestY = box.max.y;
+					bestIndex = index;
+					found = true;
+				}
 			}
-		}
-	}
+			return true;
+		});
 
 	if (found && outGroundY) *outGroundY = bestY;
+	if (found && outIndex) *outIndex = bestIndex;
 	return found;
 }
 
@@ -112,10 +108,25 @@ static XMFLOAT3 g_playerPos{};
 static XMFLOAT3 g_playerFront{0.0f,0.0f,1.0f};
 static XMFLOAT3 g_playerVel{};
 
+// ===== 描画補間（前ティックの位置・向き） =====
+static XMFLOAT3 g_playerPrevPos{};
+static XMFLOAT3 g_playerPrevFront{ 0.0f,0.0f,1.0f };
+static uint64_t g_playerInterpTick = 0; // prev を取ったティック。違えば補間しない
+
 static bool g_isGrounded = false;
+// 接地しているブロック（押し戻し・スイープ・床プローブで決まる）。乗っている足場の移動に使う。
+// フレームをまたいで持つので、エディタでブロックが消されて並びが変わっても追えるようハンドルで持つ
+static StageBlockHandle g_groundBlock;
+
+// 押し出し候補（毎フレーム使い回す）
+static std::vector<int> g_pushCandidates;
+// スイープ移動の候補
+static std::vector<int> g_sweepCandidates;
 
 //static MODEL* g_playerModel{ nullptr };
 static SKINNED_MODEL* g_playerModel{ nullptr };
+static constexpr const char* kPlayerModelPath = "model/atlas/scene.gltf";
+static AssetHandle g_playerModelAsset;	// ステージを切り替えても同じモデルを使い回す
 
 
 static constexpr float PLAYER_SCALE = 14.0f;//14.0fに決定
@@ -131,7 +142,8 @@ static const PlayerTuning k_defaultTune{
 	-7.0f,           // terminalFall
 	1000.0f / 40.0f, // moveAccel加速度
 	10.0f,           // friction
-	DirectX::XM_2PI * 1.0f // rotSpeed
+	DirectX::XM_2PI * 1.0f, // rotSpeed
+	false            // continuousCollision
 };
 
 static PlayerTuning g_tune = k_defaultTune;
@@ -196,11 +208,38 @@ bool Player_IsInputOverrideEnabled()
 }
 
 
+// ワープ時は補間しない（前の位置から線を引かないように）
+static void SnapInterpolation()
+{
+	g_playerPrevPos = g_playerPos;
+	g_playerPrevFront = g_playerFront;
+}
+
+// 描画用の位置・向き。最後の固定ティックで更新されていれば前ティックと補間する
+static void GetDrawTransform(XMVECTOR* outPos, XMFLOAT3* outFront)
+{
+	XMVECTOR pos = XMLoadFloat3(&g_playerPos);
+	XMVECTOR front = XMLoadFloat3(&g_playerFront);
+	if (g_playerInterpTick != 0 && g_playerInterpTick == FixedStep_GetTick())
+	{
+		const float alpha = FixedStep_GetAlpha();
+		pos = XMVectorLerp(XMLoadFloat3(&g_playerPrevPos), pos, alpha);
+		const XMVECTOR f = XMVectorLerp(XMLoadFloat3(&g_playerPrevFront), front, alpha);
+		if (XMVectorGetX(XMVector3LengthSq(f)) > 1e-6f) front = XMVector3Normalize(f);
+	}
+	*outPos = pos;
+	XMStoreFloat3(outFront, front);
+}
+
 void Player_DebugTeleport(const DirectX::XMFLOAT3& pos, bool resetVelocity)
 {
 	g_playerPos = pos;
 	if (resetVelocity)
+	{
 		g_playerVel = { 0,0,0 };
+		g_groundBlock = StageBlockHandle{};
+	}
+	SnapInterpolation();
 }
 
 bool Player_IsGrounded()
@@ -208,15 +247,31 @@ bool Player_IsGrounded()
 	return g_isGrounded;
 }
 
+int Player_GetGroundBlock()
+{
+	return g_isGrounded ? Stage01_GetIndex(g_groundBlock) : -1;
+}
+
+
+void Player_CollectAssets(AssetPrefetchList* list)
+{
+	if (list) list->models.push_back(kPlayerModelPath);
+}
 
 void Player_Initialize(const XMFLOAT3& position, const XMFLOAT3& front)
 {
 	g_playerPos = position;
 	g_playerVel = { 0.0f,0.0f,0.0f };
+	g_isGrounded = false;
+	g_groundBlock = StageBlockHandle{};
     XMStoreFloat3(&g_playerFront, XMVector3Normalize(XMLoadFloat3(&front)));
+	SnapInterpolation();
+	g_playerInterpTick = 0;
 
 	//g_playerModel = ModelLoad("model/atlas/scene.gltf", 0.2f, false);
-	g_playerModel = SkinnedModel_Load("model/atlas/scene.gltf", 1.0f, false);
+	g_playerModelAsset = Asset_LoadSkinnedModel(kPlayerModelPath, 1.0f, false);
+	g_playerModel = Asset_GetSkinnedModel(g_playerModelAsset);
+	SkinnedModel_ResetPose(g_playerModel);	// 前のステージのポーズが残っているので読み込み直後に戻す
 
 	PlayerAction_Init(g_act);
 	PlayerAction_InitDefaultParams(g_actParam);
@@ -225,15 +280,88 @@ void Player_Initialize(const XMFLOAT3& position, const XMFLOAT3& front)
 void Player_Finalize()
 {
 	//ModelRelease(g_playerModel);
-	SkinnedModel_Release(g_playerModel);
+	Asset_Release(&g_playerModelAsset);
 	g_playerModel = nullptr;
 }
 
+// ===== 連続判定の移動 =====
+// velocity * dt をスイープで解く。当たった面の手前で止めて、残りの移動から法線方向を捨てて滑らせる（最大4回）。
+// 面にぴったり止めるだけなので、最初から重なっている分は後の押し戻しで直す
+static void MoveSwept(XMVECTOR& position, XMVECTOR& velocity, float dt)
+{
+	XMFLOAT3 move;
+	XMStoreFloat3(&move, velocity * dt);
+
+	for (int iter = 0; iter < 4; ++iter)
+	{
+		if (move.x == 0.0f && move.y == 0.0f && move.z == 0.0f) break;
+
+		const AABB from = Player_ConvertPositionToAABB(position);
+
+		// 移動範囲をまるごと含む箱で候補を集める
+		AABB swept = from;
+		if (move.x > 0.0f) swept.max.x += move.x; else swept.min.x += move.x;
+		if (move.y > 0.0f) swept.max.y += move.y; else swept.min.y += move.y;
+		if (move.z > 0.0f) swept.max.z += move.z; else swept.min.z += move.z;
+
+		Stage01_CollectAABB(swept, g_sweepCandidates);
+		const StageCollisionSoA soa = Stage01_GetCollisionSoA();
+		const SweepHit hit = Collision_SweepAABB(from, move, soa.bounds,
+			g_sweepCandidates.data(), (int)g_sweepCandidates.size());
+
+		if (!hit.hit)
+		{
+			position += XMLoadFloat3(&move);
+			break;
+		}
+
+		position += XMLoadFloat3(&move) * hit.t;
+
+		const float remain = 1.0f - hit.t;
+		move.x *= remain;
+		move.y *= remain;
+		move.z *= remain;
+
+		if (hit.normal.x != 0.0f)
+		{
+			move.x = 0.0f;
+			velocity = XMVectorSetX(velocity, 0.0f);
+		}
+		else if (hit.normal.y != 0.0f)
+		{
+			move.y = 0.0f;
+
+			// 上から乗った（押し戻しの Landed on top と同じ条件）
+			if (hit.normal.y > 0.0f && XMVectorGetY(velocity) <= 0.0f)
+			{
+				g_isGrounded = true;
+				g_groundBlock = Stage01_GetHandle(hit.index);
+			}
+
+			// 頭突き：kind==10 は壊す（押し戻しと同じ）
+			if (hit.normal.y < 0.0f && XMVectorGetY(velocity) > 0.0f && soa.kind[hit.index] == 10)
+			{
+				Stage01_SetBlockEnabled(hit.index, false);
+			}
+
+			velocity = XMVectorSetY(velocity, 0.0f);
+		}
+		else
+		{
+			move.z = 0.0f;
+			velocity = XMVectorSetZ(velocity, 0.0f);
+		}
+	}
+}
+
 void Player_Update(double elapsedTime)
 {
 	const bool inputEnabled = !ImGuiManager::IsVisible();
 	const float dt = (float)elapsedTime;
 
+	SnapInterpolation();
+	g_playerInterpTick = FixedStep_GetTick();
+
 	// CrouchJump landing move-lock timer
 	if (s_crouchFJumpMoveLockT > 0.0f)
 	{
@@ -265,6 +393,14 @@ void Player_Update(double elapsedTime)
 	XMVECTOR position = XMLoadFloat3(&g_playerPos);
 	XMVECTOR velocity = XMLoadFloat3(&g_playerVel);
 
+	// 前フレームに立っていたブロックが今フレーム動いた分だけ一緒に動く（動く足場）。
+	// 上に跳んでいる途中は乗っていない扱い
+	if (g_isGrounded && XMVectorGetY(velocity) <= 0.01f)
+	{
+		const XMFLOAT3 carry = Stage01_GetFrameMove(Stage01_GetIndex(g_groundBlock));
+		position += XMLoadFloat3(&carry);
+	}
+
 	// Ground probe（重なってなくても接地を安定させる）
 	bool  probedGround = false;
 	float groundY = 0.0f;
@@ -426,6 +562,7 @@ void Player_Update(double elapsedTime)
 
 	// This frame's grounded will be determined by collision resolution.
 	g_isGrounded = false;
+	g_groundBlock = StageBlockHandle{};
 
 	// ===== Apply action outputs to velocity / position (type-safe) =====
 	if (ao.overrideVelocity)
@@ -908,7 +1045,10 @@ void Player_Update(double elapsedTime)
 
 
 	// ===== Integrate =====
-	position += velocity * dt;
+	if (g_tune.continuousCollision)
+		MoveSwept(position, velocity, dt);
+	else
+		position += velocity * dt;
 
 	// ===== Spin AABB vs AABB : Spin attack destroys kind==0 cube  (runtime only)=====
 	{
@@ -923,48 +1063,58 @@ void Player_Update(double elapsedTime)
 			spinAabb.min.z -= SPIN_EXPAND_XZ;
 			spinAabb.max.z += SPIN_EXPAND_XZ;
 
-			const int blockCount = Stage01_GetCount();
-			for (int i = 0; i < blockCount; ++i)
-			{
-				StageBlock* obj = Stage01_GetMutable(i);
-				if (!obj) continue;
-				if (obj->kind != 10) continue;//kind==１０のCubeにスピンを当てたら破壊できる
-				if (!Collision_IsOverlapAABB(spinAabb, obj->aabb)) continue;
-
-				const DirectX::XMFLOAT3 hitPosition{
-				(obj->aabb.min.x + obj->aabb.max.x) * 0.5f,
-				(obj->aabb.min.y + obj->aabb.max.y) * 0.5f,
-				(obj->aabb.min.z + obj->aabb.max.z) * 0.5f
-				};
-				StageSimpleManager_AddSpinBreakBillboard(hitPosition);
-
-				obj->sizeOffset.x = -obj->size.x;
-				obj->sizeOffset.y = -obj->size.y;
-				obj->sizeOffset.z = -obj->size.z;
-				HideStageBlockRuntime(i);
-				break;
-			}
+			Stage01_QueryAABB(spinAabb, [&](int i, const StageBlock&)
+				{
+					const StageBlock* obj = Stage01_Get(i);
+					if (!obj) return true;
+					if (obj->kind != 10) return true;//kind==１０のCubeにスピンを当てたら破壊できる
+					if (!Collision_IsOverlapAABB(spinAabb, obj->aabb)) return true;
+
+					const DirectX::XMFLOAT3 hitPosition{
+					(obj->aabb.min.x + obj->aabb.max.x) * 0.5f,
+					(obj->aabb.min.y + obj->aabb.max.y) * 0.5f,
+					(obj->aabb.min.z + obj->aabb.max.z) * 0.5f
+					};
+					StageSimpleManager_AddSpinBreakBillboard(hitPosition);
+
+					Stage01_SetBlockEnabled(i, false);
+					return false;
+				});
 		}
 	}
 
 
 	// ===== AABB vs AABB : Player を Cube から押し戻す =====
 	{
+		// 1パス中の押し戻し量はプレイヤーの大きさ程度なので、その分広げた範囲だけ候補にする
+		// （はみ出した分は次のパスで拾う）
+		constexpr float PUSH_QUERY_MARGIN = 1.0f;
+
 		for (int solve = 0; solve < 4; ++solve)
 		{
 			bool anyHit = false;
 			bool removedBlock = false;
 
-			for (int i = 0; i < Stage01_GetCount(); ++i)
-			{
-				const StageBlock* obj = Stage01_Get(i);
-				if (!obj) continue;
+			AABB reach = Player_ConvertPositionToAABB(position);
+			reach.min.x -= PUSH_QUERY_MARGIN; reach.min.y -= PUSH_QUERY_MARGIN; reach.min.z -= PUSH_QUERY_MARGIN;
+			reach.max.x += PUSH_QUERY_MARGIN; reach.max.y += PUSH_QUERY_MARGIN; reach.max.z += PUSH_QUERY_MARGIN;
+
+			// 候補（昇順）を先に集めて、SoA の重なり判定で「次に重なるブロック」だけ拾う。
+			// 押し出すたびに playerAabb が変わるので、重なり判定は毎回その時点の位置でやり直す
+			Stage01_CollectAABB(reach, g_pushCandidates);
+			const StageCollisionSoA soa = Stage01_GetCollisionSoA();
+			const int candidateCount = (int)g_pushCandidates.size();
 
+			for (int k = 0; k < candidateCount; ++k)
+			{
 				AABB playerAabb = Player_ConvertPositionToAABB(position);
 
-				const AABB& box = obj->aabb;
+				k = Collision_FindFirstOverlapAABB(playerAabb, soa.bounds, g_pushCandidates.data(), k, candidateCount);
+				if (k < 0) break;
 
-				if (!Collision_IsOverlapAABB(box, playerAabb)) continue;
+				const int i = g_pushCandidates[k];
+				const StageBlock* obj = Stage01_Get(i);
+				const AABB& box = obj->aabb;
 
 				const float ox = std::min(playerAabb.max.x, box.max.x) - std::max(playerAabb.min.x, box.min.x);
 				const float oy = std::min(playerAabb.max.y, box.max.y) - std::max(playerAabb.min.y, box.min.y);
@@ -995,12 +1145,13 @@ void Player_Update(double elapsedTime)
 					if (dir > 0.0f && XMVectorGetY(velocity) <= 0.0f)
 					{
 						g_isGrounded = true;
+						g_groundBlock = Stage01_GetHandle(i);
 					}
 
 					// Hit head (jumping) : remove kind==0 cube(runtime only)
 					if (dir < 0.0f && XMVectorGetY(velocity) > 0.0f && obj->kind == 10)
 					{
-						HideStageBlockRuntime(i);
+						Stage01_SetBlockEnabled(i, false);
 						removedBlock = true;
 						anyHit = true;
 						velocity = XMVectorSetY(velocity, 0.0f);
@@ -1033,8 +1184,10 @@ void Player_Update(double elapsedTime)
 	{
 		float groundY = 0.0f;
 		constexpr float GROUND_EPS = 0.06f;
-		if (ProbeGroundY(position, GROUND_EPS, &groundY))
+		int groundIndex = -1;
+		if (ProbeGroundY(position, GROUND_EPS, &groundY, &groundIndex))
 		{
+			g_groundBlock = Stage01_GetHandle(groundIndex);
 			g_isGrounded = true;
 			position = XMVectorSetY(position, groundY);
 			velocity = XMVectorSetY(velocity, 0.0f);
@@ -1283,16 +1436,19 @@ void Player_Update(double elapsedTime)
 	XMStoreFloat3(&g_playerVel, velocity);
 }
 
-void Player_Draw()
+// Player_Draw / Player_Submit のワールド行列
+static XMMATRIX DrawWorldMatrix()
 {
-	Light_SetSpecularWorld(Camera_GetPosition(), 4.0f, { 0.2f,0.2f,0.2f,1.0f });
-
 	float angleX = 90.0f;
 	float angleY = 0.0f;
 	
 	//-atan2f(g_playerFront.z, g_playerFront.x) + XMConvertToRadians(270);
 	//XMMATRIX r = XMMatrixRotationX(XMConvertToRadians(angleX)) * XMMatrixRotationY(XMConvertToRadians(angleY));
-	float angle = -atan2f(g_playerFront.z, g_playerFront.x) + XMConvertToRadians(270);
+	XMVECTOR pos{};
+	XMFLOAT3 drawFront{};
+	GetDrawTransform(&pos, &drawFront);
+
+	float angle = -atan2f(drawFront.z, drawFront.x) + XMConvertToRadians(270);
 	angle += g_spinYaw;
 	XMMATRIX r = XMMatrixRotationX(XMConvertToRadians(angleX))*XMMatrixRotationY(angle);
 
@@ -1302,10 +1458,9 @@ void Player_Draw()
 	else if (g_visFixCrouchForwardJump2) fix = g_visCrouchForwardJump2Fix;
 	else if (g_visFixJump) fix = g_visJumpForwardFix;
 
-	XMVECTOR pos = XMLoadFloat3(&g_playerPos);
 	if (fix != 0.0f)
 	{
-		XMVECTOR front = XMVector3Normalize(XMLoadFloat3(&g_playerFront));
+		XMVECTOR front = XMVector3Normalize(XMLoadFloat3(&drawFront));
 		pos += front * fix; // 前方向へ固定距離だけずらす
 	}
 
@@ -1316,9 +1471,20 @@ void Player_Draw()
 	);
 
 	XMMATRIX s = XMMatrixScaling(PLAYER_SCALE, PLAYER_SCALE, PLAYER_SCALE);
-	XMMATRIX world = s * r * t;
+	return s * r * t;
+}
 
-	SkinnedModel_Draw(g_playerModel, world);
+void Player_Draw()
+{
+	Light_SetSpecularWorld(Camera_GetPosition(), 4.0f, { 0.2f,0.2f,0.2f,1.0f });
+	SkinnedModel_Draw(g_playerModel, DrawWorldMatrix());
+}
+
+void Player_Submit(float viewDepth)
+{
+	// スペキュラーは定数バッファなので積む時点で入れておく
+	Light_SetSpecularWorld(Camera_GetPosition(), 4.0f, { 0.2f,0.2f,0.2f,1.0f });
+	SkinnedModel_Submit(g_playerModel, DrawWorldMatrix(), RENDER_PASS_OPAQUE, viewDepth);
 }
 
 void Player_DepthDraw()
@@ -1326,7 +1492,11 @@ void Player_DepthDraw()
 	Light_SetSpecularWorld(Camera_GetPosition(), 4.0f, { 0.2f,0.2f,0.2f,1.0f });
 
 
-	float angle = -atan2f(g_playerFront.z, g_playerFront.x) + XMConvertToRadians(270);
+	XMVECTOR pos{};
+	XMFLOAT3 drawFront{};
+	GetDrawTransform(&pos, &drawFront);
+
+	float angle = -atan2f(drawFront.z, drawFront.x) + XMConvertToRadians(270);
 	angle += g_spinYaw;
 	XMMATRIX r = XMMatrixRotationY(angle);
 	// ===== Visual-only fixed offset =====
@@ -1335,10 +1505,9 @@ void Player_DepthDraw()
 	else if (g_visFixCrouchForwardJump2) fix = g_visCrouchForwardJump2Fix;
 	else if (g_visFixJump) fix = g_visJumpForwardFix;
 
-	XMVECTOR pos = XMLoadFloat3(&g_playerPos);
 	if (fix != 0.0f)
 	{
-		XMVECTOR front = XMVector3Normalize(XMLoadFloat3(&g_playerFront));
+		XMVECTOR front = XMVector3Normalize(XMLoadFloat3(&drawFront));
 		pos += front * fix;
 	}
 
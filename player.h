@@ -35,11 +35,16 @@ void Player_DebugTeleport(const DirectX::XMFLOAT3& pos, bool resetVelocity);
 
 // MotionLabpFnoiꂪƃWvvj
 bool Player_IsGrounded();
+// ĂubNiStage01 ̃CfbNXjBڒnĂȂ -1
+int  Player_GetGroundBlock();
 
 void Player_Initialize(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& front);
+struct AssetPrefetchList;
+void Player_CollectAssets(AssetPrefetchList* list);	// Player_Initialize ǂނ
 void Player_Finalize();
 void Player_Update(double elapsedTime);
 void Player_Draw();
+void Player_Submit(float viewDepth);	// Player_Draw ̕`L[ŁibVƂɐςށj
 void Player_DepthDraw();
 
 const DirectX::XMFLOAT3& Player_GetPosition();
@@ -56,6 +61,7 @@ struct PlayerTuning
 	float moveAccel;
 	float friction;
 	float rotSpeed;
+	bool  continuousCollision; // ړXC[vŉiĂubN蔲Ȃj
 };
 
 PlayerTuning* Player_GetTuning();
@@ -9,16 +9,12 @@
 
 #include "player_camera.h"
 #include"direct3d.h"
-#include"shader3d.h"
 #include"key_logger.h"
 #include"gamepad.h"
-#include "mouse.h"
-#include"debug_text.h"
 #include"player.h"
-#include"shader_field.h"
-#include"shader_billboard.h"
-#include <windows.h>
-#include<sstream>
+#include"fixed_step.h"
+#include"collision_query.h"
+#include <algorithm>
 #include <cmath>
 
 using namespace DirectX;
@@ -36,13 +32,73 @@ static bool g_enableKeyCamera = false;
 static bool g_prevToggleKey = false;
 static float g_normalCameraYaw = 0.0f;
 
+// ===== `ԁieBbNƂ̃Jpj =====
+struct CameraPose
+{
+    XMFLOAT3 position{};
+    XMFLOAT3 target{ 0.0f,0.0f,1.0f };
+    XMFLOAT3 up{ 0.0f,1.0f,0.0f };
+};
+static CameraPose g_posePrev{};
+static CameraPose g_poseCur{};
+static bool g_hasPose = false;
+static uint64_t g_poseTick = 0;        // g_poseCur eBbN
+static XMFLOAT3 g_cameraDrawPos{};
+static uint64_t g_drawTick = 0;        // g_CameraMatrix Ƃ̃eBbNƕԗ
+static float g_drawAlpha = -1.0f;
+
 static const float NORMAL_CAMERA_TARGET_OFFSET_Y = 1.25f;
 static const float NORMAL_CAMERA_STICK_DEADZONE = 0.2f;
 static const float NORMAL_CAMERA_STICK_YAW_SENSITIVITY = XMConvertToRadians(90.0f);
 
-void PlayerCamera_Initialize()
+// ===== J̃A[i_J܂ŁBubNΏk߂j =====
+// _J̈ʒu֋΂āA炻̎O܂ŃA[k߂B
+// k߂̂͂iǂɂ߂荞܂ȂjAL΂̂͂߂B
+// ӂĂȂt[́uǂꂩɓ邩v̖₢킹1ōς܂B
+// ӂĂԂ͑ÕubNɊm߂āA̎OTB
+static const float CAMERA_ARM_RADIUS = 0.3f;        // J̓苅
+static const float CAMERA_ARM_MIN_LENGTH = 0.5f;    // ߂ɂ͊񂹂Ȃ
+static const float CAMERA_ARM_RETURN_RATE = 6.0f;   // L΂Ƃ̖߂i1/sAwŋ߂Âj
+static float g_armLength = -1.0f;                   // ̃A[̒i = ̃t[ŖڕWɍ킹j
+static int g_armBlocker = -1;                       // OӂłubN
+
+// lookTarget  diriKς݁j maxLength ܂ŐL΂钷
+static float ComputeArmLength(const XMFLOAT3& lookTarget, const XMFLOAT3& dir, float maxLength)
 {
+    CastHit hit;
+
+    if (g_armBlocker >= 0)
+    {
+        // ÕubN܂ӂł΁AOT
+        if (Collision_SphereCastBlock(g_armBlocker, lookTarget, CAMERA_ARM_RADIUS, dir, maxLength, &hit))
+        {
+            CastHit nearer;
+            if (Collision_SphereCast(lookTarget, CAMERA_ARM_RADIUS, dir, hit.distance, &nearer)
+                && nearer.distance < hit.distance)
+            {
+                hit = nearer;
+            }
+            g_armBlocker = hit.index;
+            return hit.distance;
+        }
+        g_armBlocker = -1;
+    }
 
+    // قƂǂ̃t[͂ŏI
+    if (!Collision_SphereCastAny(lookTarget, CAMERA_ARM_RADIUS, dir, maxLength)) return maxLength;
+
+    if (!Collision_SphereCast(lookTarget, CAMERA_ARM_RADIUS, dir, maxLength, &hit)) return maxLength;
+    g_armBlocker = hit.index;
+    return hit.distance;
+}
+
+void PlayerCamera_Initialize()
+{
+    g_armLength = -1.0f;
+    g_armBlocker = -1;
+    g_hasPose = false;
+    g_poseTick = 0;
+    g_drawAlpha = -1.0f;
 }
 
 void PlayerCamera_Finalize()
@@ -79,6 +135,8 @@ void PlayerCamera_Update(float elapsedTime)
         XMFLOAT3 offset{};
         XMStoreFloat3(&offset, offsetVec);
         g_normalCameraYaw = std::atan2(-offset.x, -offset.z);
+        g_armLength = -1.0f;
+        g_armBlocker = -1;
     }
 
     XMVECTOR position{};
@@ -114,6 +172,29 @@ void PlayerCamera_Update(float elapsedTime)
         position = playerPos + rotatedOffset;
 
         XMVECTOR lookTarget = playerPos + XMVECTOR{ 0.0f, NORMAL_CAMERA_TARGET_OFFSET_Y, 0.0f };
+
+        // A[F_{̈ʒu܂ł̊ԂɃubNΎOɊ񂹂
+        {
+            const XMVECTOR arm = position - lookTarget;
+            const float desiredLength = XMVectorGetX(XMVector3Length(arm));
+            if (desiredLength > CAMERA_ARM_MIN_LENGTH)
+            {
+                XMFLOAT3 origin, dir;
+                XMStoreFloat3(&origin, lookTarget);
+                XMStoreFloat3(&dir, arm / desiredLength);
+
+                float allowed = ComputeArmLength(origin, dir, desiredLength);
+                allowed = std::max(allowed, CAMERA_ARM_MIN_LENGTH);
+
+                if (g_armLength < 0.0f || allowed <= g_armLength)
+                    g_armLength = allowed;
+                else
+                    g_armLength += (allowed - g_armLength) * (1.0f - std::exp(-CAMERA_ARM_RETURN_RATE * elapsedTime));
+
+                if (g_armLength < desiredLength)
+                    position = lookTarget + XMLoadFloat3(&dir) * g_armLength;
+            }
+        }
         front = XMVector3Normalize(lookTarget - position);
         up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
         right = XMVector3Normalize(XMVector3Cross(up, front));
@@ -194,6 +275,39 @@ void PlayerCamera_Update(float elapsedTime)
     //p[XyNeBusۑ//Jsۑ
     XMStoreFloat4x4(&g_CameraMatrix, mtrView);
     XMStoreFloat4x4(&g_CameraPerspectiveMatrix, mtxPerspective);
+
+    // ԗpɍeBbN̎pci͑OeBbNeBbNj
+    CameraPose pose{};
+    XMStoreFloat3(&pose.position, position);
+    XMStoreFloat3(&pose.target, target);
+    XMStoreFloat3(&pose.up, up);
+    g_posePrev = g_hasPose ? g_poseCur : pose;
+    g_poseCur = pose;
+    g_hasPose = true;
+    g_poseTick = FixedStep_GetTick();
+
+    g_cameraDrawPos = pose.position;
+    g_drawTick = g_poseTick;
+    g_drawAlpha = 1.0f;
+}
+
+// `p̃r[sԗɍ킹č蒼it[ł͎g񂷁j
+static void UpdateDrawView()
+{
+    if (!g_hasPose || g_poseTick == 0 || g_poseTick != FixedStep_GetTick()) return;
+
+    const float alpha = FixedStep_GetAlpha();
+    if (g_drawTick == g_poseTick && g_drawAlpha == alpha) return;
+
+    const XMVECTOR position = XMVectorLerp(XMLoadFloat3(&g_posePrev.position), XMLoadFloat3(&g_poseCur.position), alpha);
+    const XMVECTOR target = XMVectorLerp(XMLoadFloat3(&g_posePrev.target), XMLoadFloat3(&g_poseCur.target), alpha);
+    XMVECTOR up = XMVectorLerp(XMLoadFloat3(&g_posePrev.up), XMLoadFloat3(&g_poseCur.up), alpha);
+    if (XMVectorGetX(XMVector3LengthSq(up)) < 1e-6f) up = XMLoadFloat3(&g_poseCur.up);
+
+    XMStoreFloat4x4(&g_CameraMatrix, XMMatrixLookAtLH(position, target, XMVector3Normalize(up)));
+    XMStoreFloat3(&g_cameraDrawPos, position);
+    g_drawTick = g_poseTick;
+    g_drawAlpha = alpha;
 }
 
 /*void PlayerCamera_Update(float elapsedTime)
@@ -234,7 +348,8 @@ void PlayerCamera_Update(float elapsedTime)
 
 const DirectX::XMFLOAT3& PlayerCamera_GetPosition()
 {
-    return g_cameraPos;
+    UpdateDrawView();
+    return g_hasPose ? g_cameraDrawPos : g_cameraPos;
 }
 
 const DirectX::XMFLOAT3& PlayerCamera_GetFront()
@@ -244,6 +359,7 @@ const DirectX::XMFLOAT3& PlayerCamera_GetFront()
 
 const DirectX::XMFLOAT4X4& PlayerCamera_GetViewMatrix()
 {
+    UpdateDrawView();
     return g_CameraMatrix;
 }
 
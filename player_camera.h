@@ -16,6 +16,7 @@ void PlayerCamera_Initialize();
 void PlayerCamera_Finalize();
 void PlayerCamera_Update(float elapsedTime);
 
+// ʒuƃr[s͕`piŒXebv̕ԍ݁jB͍ŐVeBbN̒l
 const DirectX::XMFLOAT3& PlayerCamera_GetPosition();
 const DirectX::XMFLOAT3& PlayerCamera_GetFront();
 
@@ -10,11 +10,15 @@
 #include "player_sensors.h"
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 using namespace DirectX;
 
 namespace
 {
+    // ǒŤit[g񂷁j
+    std::vector<int> g_wallCandidates;
+
     inline XMFLOAT3 Center(const AABB& a)
     {
         return { (a.min.x + a.max.x) * 0.5f, (a.min.y + a.max.y) * 0.5f, (a.min.z + a.max.z) * 0.5f };
@@ -74,14 +78,7 @@ namespace
 
     inline bool OverlapsAnyStage(const AABB& aabb)
     {
-        const int n = Stage01_GetCount();
-        for (int i = 0; i < n; ++i)
-        {
-            const StageBlock* b = Stage01_Get(i);
-            if (!b) continue;
-            if (Collision_IsOverlapAABB(aabb, b->aabb)) return true;
-        }
-        return false;
+        return Stage01_OverlapsAny(aabb);
     }
 
     inline XMFLOAT3 ComputeHangCenter(const AABB& playerAabb,
@@ -130,14 +127,18 @@ void PlayerSensors_BuildWallLedge(const AABB& playerAabb,
     StageBlock const* bestWall = nullptr;
     XMFLOAT3 bestNormal{ 0,0,0 };
 
-    const int count = Stage01_GetCount();
-    for (int i = 0; i < count; ++i)
+    // ̓CfbNXŗ̂ŁuŏɌǁv͑SƓB
+    // dȂ蔻 SoA ł܂Ƃ߂ĂāAdȂ̂ڂ
+    Stage01_CollectAABB(touchAabb, g_wallCandidates);
+    const StageCollisionSoA soa = Stage01_GetCollisionSoA();
+    const int candidateCount = (int)g_wallCandidates.size();
+
+    for (int k = 0; k < candidateCount && !foundWall; ++k)
     {
-        const StageBlock* b = Stage01_Get(i);
-        if (!b) continue;
+        k = Collision_FindFirstOverlapAABB(touchAabb, soa.bounds, g_wallCandidates.data(), k, candidateCount);
+        if (k < 0) break;
 
-        if (!Collision_IsOverlapAABB(touchAabb, b->aabb))
-            continue;
+        const StageBlock* b = Stage01_Get(g_wallCandidates[k]);
 
         // Use MTV normal from overlap, but compute outward axis from centers for stability
         Hit hit = Collision_IsHitAABB(touchAabb, b->aabb);
@@ -155,8 +156,7 @@ void PlayerSensors_BuildWallLedge(const AABB& playerAabb,
 
         foundWall = true;
         bestWall = b;
-        bestNormal = outward;
-        break; // first is enough for now (stable)
+        bestNormal = outward; // first is enough for now (stable)
     }
 
     if (foundWall && bestWall)
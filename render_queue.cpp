@@ -0,0 +1,293 @@
+/*==============================================================================
+
+@@  `L[[render_queue.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/07
+--------------------------------------------------------------------------------
+
+==============================================================================*/
+#include "render_queue.h"
+#include "shader3d.h"
+#include "shader3d_unlit.h"
+#include "shader_depth.h"
+#include "billboard.h"
+#include "texture.h"
+#include "direct3d.h"
+#include <cstring>
+#include <vector>
+
+using namespace DirectX;
+
+namespace
+{
+    struct Command
+    {
+        RenderQueueDrawFunc func = nullptr;
+        const void* data = nullptr;
+        int param = 0;
+        uint32_t flags = 0;
+        bool copied = false;    // true Ȃ payload Ɏʂ data n
+        alignas(16) unsigned char payload[RENDER_QUEUE_INLINE_DATA];
+    };
+
+    std::vector<uint64_t> g_keys;
+    std::vector<Command>  g_commands;
+
+    // RenderQueue_MakeViewKey ŔԍUr[it[Ɓj
+    std::vector<ID3D11ShaderResourceView*> g_views;
+
+    // \[gpiL[ƌ̔ԍꏏɕבւj
+    std::vector<uint64_t> g_sortKeys;
+    std::vector<uint64_t> g_sortKeysTmp;
+    std::vector<uint32_t> g_order;
+    std::vector<uint32_t> g_orderTmp;
+
+    RenderQueueStats g_stats{};
+
+    constexpr int kNoState = -2;   // uݒ肳Ă邩킩Ȃv
+
+    constexpr uint32_t kTexNone = 0;
+    constexpr uint32_t kTexViewBit = 0x8000u;
+    constexpr uint32_t kTexIdMax = kTexViewBit - 1;   // texId+1 ̏
+
+    void BindShader(int shader)
+    {
+        switch (shader)
+        {
+        case RENDER_SHADER_3D:        Shader3D_Begin(); break;
+        case RENDER_SHADER_3D_UNLIT:  Shader3DUnlit_Begin(); break;
+        case RENDER_SHADER_BILLBOARD: Billboard_BeginPipeline(); break;
+        case RENDER_SHADER_DEPTH:     ShaderDepth_Begin(); break;
+        case RENDER_SHADER_3D_INSTANCED: Shader3D_BeginInstanced(); break;
+        default: break;
+        }
+    }
+
+    // 8bit  8  LSD \[giȂ̂œL[͐ς񂾏̂܂܁j
+    void BindTexture(uint32_t tex)
+    {
+        if (tex & kTexViewBit)
+        {
+            const uint32_t index = tex & ~kTexViewBit;
+            if (index >= g_views.size()) return;
+            ID3D11ShaderResourceView* view = g_views[index];
+            Direct3D_GetContext()->PSSetShaderResources(0, 1, &view);
+        }
+        else
+        {
+            Texture_SetTexture((int)tex - 1);
+        }
+    }
+
+    uint64_t PackKey(RenderPass pass, RenderShader shader, uint32_t tex, float viewDepth)
+    {
+        //  float ̓rbĝ܂ܑ召ۂ
+        if (!(viewDepth > 0.0f)) viewDepth = 0.0f;
+        uint32_t depthBits = 0;
+        std::memcpy(&depthBits, &viewDepth, sizeof(depthBits));
+        if (pass == RENDER_PASS_TRANSPARENT) depthBits = ~depthBits;
+
+        return ((uint64_t)((uint32_t)pass & 0xFFu) << 56)
+            | ((uint64_t)((uint32_t)shader & 0xFFu) << 48)
+            | ((uint64_t)(tex & 0xFFFFu) << 32)
+            | (uint64_t)depthBits;
+    }
+
+    void RadixSort()
+    {
+        const size_t n = g_keys.size();
+        g_sortKeys.assign(g_keys.begin(), g_keys.end());
+        g_sortKeysTmp.resize(n);
+        g_order.resize(n);
+        g_orderTmp.resize(n);
+        for (size_t i = 0; i < n; ++i) g_order[i] = (uint32_t)i;
+        if (n < 2) return;
+
+        for (int shift = 0; shift < 64; shift += 8)
+        {
+            size_t count[256] = {};
+            for (size_t i = 0; i < n; ++i)
+                ++count[(g_sortKeys[i] >> shift) & 0xFF];
+
+            // SȂт͕ςȂidepth ̏ʂ▢gp pass Ȃǁj
+            if (count[(g_sortKeys[0] >> shift) & 0xFF] == n) continue;
+
+            size_t offset = 0;
+            for (int b = 0; b < 256; ++b)
+            {
+                const size_t c = count[b];
+                count[b] = offset;
+                offset += c;
+            }
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                const size_t dst = count[(g_sortKeys[i] >> shift) & 0xFF]++;
+                g_sortKeysTmp[dst] = g_sortKeys[i];
+                g_orderTmp[dst] = g_order[i];
+            }
+            g_sortKeys.swap(g_sortKeysTmp);
+            g_order.swap(g_orderTmp);
+        }
+    }
+}
+
+uint64_t RenderQueue_MakeKey(RenderPass pass, RenderShader shader, int texId, float viewDepth)
+{
+    uint32_t tex = (texId < 0) ? kTexNone : (uint32_t)texId + 1u;
+    if (tex > kTexIdMax) tex = kTexIdMax;
+    return PackKey(pass, shader, tex, viewDepth);
+}
+
+uint64_t RenderQueue_MakeViewKey(RenderPass pass, RenderShader shader, ID3D11ShaderResourceView* view, float viewDepth)
+{
+    // 1t[ɏoĂr[͐\Ȃ̂Ő`Tő
+    uint32_t index = 0;
+    while (index < g_views.size() && g_views[index] != view) ++index;
+    if (index == g_views.size())
+    {
+        if (index > kTexIdMax) index = kTexIdMax;
+        else g_views.push_back(view);
+    }
+    return PackKey(pass, shader, kTexViewBit | index, viewDepth);
+}
+
+float RenderQueue_ViewDepth(const XMFLOAT3& cameraPosition, const XMFLOAT3& cameraFront, const XMFLOAT3& position)
+{
+    return (position.x - cameraPosition.x) * cameraFront.x
+        + (position.y - cameraPosition.y) * cameraFront.y
+        + (position.z - cameraPosition.z) * cameraFront.z;
+}
+
+void RenderQueue_Initialize()
+{
+    g_keys.clear();
+    g_commands.clear();
+    g_views.clear();
+    g_keys.reserve(256);
+    g_commands.reserve(256);
+    g_stats = {};
+}
+
+void RenderQueue_Finalize()
+{
+    std::vector<uint64_t>().swap(g_keys);
+    std::vector<Command>().swap(g_commands);
+    std::vector<ID3D11ShaderResourceView*>().swap(g_views);
+    std::vector<uint64_t>().swap(g_sortKeys);
+    std::vector<uint64_t>().swap(g_sortKeysTmp);
+    std::vector<uint32_t>().swap(g_order);
+    std::vector<uint32_t>().swap(g_orderTmp);
+}
+
+void RenderQueue_Begin()
+{
+    g_keys.clear();
+    g_commands.clear();
+    g_views.clear();
+    g_sortKeys.clear();
+    g_order.clear();
+}
+
+void RenderQueue_Submit(uint64_t key, RenderQueueDrawFunc func, const void* data, int param, uint32_t flags)
+{
+    if (!func) return;
+
+    Command cmd;
+    cmd.func = func;
+    cmd.data = data;
+    cmd.param = param;
+    cmd.flags = flags;
+
+    g_keys.push_back(key);
+    g_commands.push_back(cmd);
+}
+
+void RenderQueue_SubmitCopy(uint64_t key, RenderQueueDrawFunc func, const void* data, size_t size, int param, uint32_t flags)
+{
+    if (!func || !data || size > RENDER_QUEUE_INLINE_DATA) return;
+
+    g_keys.push_back(key);
+    g_commands.emplace_back();
+    Command& cmd = g_commands.back();
+    cmd.func = func;
+    cmd.param = param;
+    cmd.flags = flags;
+    cmd.copied = true;
+    std::memcpy(cmd.payload, data, size);
+}
+
+void RenderQueue_Execute()
+{
+    RadixSort();
+
+    g_stats = {};
+    g_stats.commands = (int)g_commands.size();
+
+    int curShader = kNoState;
+    int curTex = kNoState;
+
+    for (size_t i = 0; i < g_order.size(); ++i)
+    {
+        const uint64_t key = g_sortKeys[i];
+        const Command& cmd = g_commands[g_order[i]];
+        const void* data = cmd.copied ? cmd.payload : cmd.data;
+
+        if (cmd.flags & RENDER_CMD_BINDS_OWN_STATE)
+        {
+            cmd.func(data, cmd.param);
+            ++g_stats.ownStateCommands;
+            curShader = kNoState;
+            curTex = kNoState;
+            continue;
+        }
+
+        const int shader = (int)((key >> 48) & 0xFF);
+        if (shader != RENDER_SHADER_NONE)
+        {
+            if (shader != curShader)
+            {
+                BindShader(shader);
+                curShader = shader;
+                ++g_stats.shaderBinds;
+            }
+            else
+            {
+                ++g_stats.shaderBindsSkipped;
+            }
+        }
+
+        const int tex = (int)((key >> 32) & 0xFFFF);
+        if (tex != (int)kTexNone)
+        {
+            if (tex != curTex)
+            {
+                BindTexture((uint32_t)tex);
+                curTex = tex;
+                ++g_stats.textureBinds;
+            }
+            else
+            {
+                ++g_stats.textureBindsSkipped;
+            }
+        }
+
+        cmd.func(data, cmd.param);
+    }
+}
+
+int RenderQueue_GetCount()
+{
+    return (int)g_commands.size();
+}
+
+uint64_t RenderQueue_GetSortedKey(int order)
+{
+    if (order < 0 || order >= (int)g_sortKeys.size()) return 0;
+    return g_sortKeys[order];
+}
+
+const RenderQueueStats& RenderQueue_GetStats()
+{
+    return g_stats;
+}
@@ -0,0 +1,99 @@
+/*==============================================================================
+
+@@  `L[[render_queue.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/07
+--------------------------------------------------------------------------------
+@@`͂̏ŏo 64bit ̃\[gL[{`֐ŐςłA
+@@t[̍ŌɊ\[gĂ܂Ƃ߂ĎsB
+@@VF[_[ƃeNX`͑ÕR}hƓȂݒ肵ȂB
+==============================================================================*/
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+
+struct ID3D11ShaderResourceView;
+
+// L[̏ʂ珇ɕ
+// | pass 8bit | shader 8bit | texture 16bit | depth 32bit |
+// texture  0 ȂA0x8000  texId+1A0x8000 ȏオ̃t[ŐUr[̔ԍ
+enum RenderPass
+{
+    RENDER_PASS_SKY = 0,
+    RENDER_PASS_OPAQUE,
+    RENDER_PASS_TRANSPARENT,   // depth ͉ȌɂȂ
+    RENDER_PASS_OVERLAY,
+
+    RENDER_PASS_COUNT
+};
+
+enum RenderShader
+{
+    RENDER_SHADER_NONE = 0,    // L[ł͐ݒ肵Ȃi`֐łj
+    RENDER_SHADER_3D,
+    RENDER_SHADER_3D_UNLIT,
+    RENDER_SHADER_BILLBOARD,
+    RENDER_SHADER_DEPTH,
+    RENDER_SHADER_3D_INSTANCED,   // Shader3D_BeginInstancediςޑ Shader3D_CanInstance mFĂj
+
+    RENDER_SHADER_COUNT
+};
+
+// `֐ŃVF[_[/eNX`ݒ肷B
+// s̓L[́u̐ݒvYāÃR}hŐݒ肵
+constexpr uint32_t RENDER_CMD_BINDS_OWN_STATE = 1u << 0;
+
+typedef void (*RenderQueueDrawFunc)(const void* data, int param);
+
+// RenderQueue_SubmitCopy ŃR}hɎʂ傫i[hs{j
+constexpr size_t RENDER_QUEUE_INLINE_DATA = 96;
+
+struct RenderQueueStats
+{
+    int commands = 0;
+    int shaderBinds = 0;        // ۂɐݒ肵
+    int textureBinds = 0;
+    int shaderBindsSkipped = 0; // OƓȂ̂ŏȂ
+    int textureBindsSkipped = 0;
+    int ownStateCommands = 0;   // RENDER_CMD_BINDS_OWN_STATE ̃R}h
+};
+
+// texId < 0 ̓eNX`ȂBviewDepth ̓JŐi 0 j
+uint64_t RenderQueue_MakeKey(RenderPass pass, RenderShader shader, int texId, float viewDepth);
+
+// eNX`ǗʂĂȂr[if̃eNX`ȂǁjpB
+// r[̓t[ƂɔԍÛŁARenderQueue_Begin ̌ŌĂԂ
+uint64_t RenderQueue_MakeViewKey(RenderPass pass, RenderShader shader,
+    ID3D11ShaderResourceView* view, float viewDepth);
+
+// JʒuƑO viewDepth o
+float RenderQueue_ViewDepth(const DirectX::XMFLOAT3& cameraPosition,
+    const DirectX::XMFLOAT3& cameraFront, const DirectX::XMFLOAT3& position);
+
+void RenderQueue_Initialize();
+void RenderQueue_Finalize();
+
+// t[̍ŏɌĂԁiOt[̃R}ĥĂj
+void RenderQueue_Begin();
+
+// data  Execute ܂ŐĂ邱ƁiRs[͂Ȃj
+void RenderQueue_Submit(uint64_t key, RenderQueueDrawFunc func, const void* data = nullptr,
+    int param = 0, uint32_t flags = 0);
+
+// data  size oCgiRENDER_QUEUE_INLINE_DATA ܂ŁjR}hɎʂĐςށB
+// `֐ɂ̓R}h̎ʂn
+void RenderQueue_SubmitCopy(uint64_t key, RenderQueueDrawFunc func, const void* data, size_t size,
+    int param = 0, uint32_t flags = 0);
+
+// \[gĎsBsR}h Begin ܂Ŏc
+void RenderQueue_Execute();
+
+int      RenderQueue_GetCount();
+uint64_t RenderQueue_GetSortedKey(int order);   // Execute  order Ԗڂ̃L[
+
+const RenderQueueStats& RenderQueue_GetStats(); // ߂ Execute
+
+#endif//RENDER_QUEUE_H
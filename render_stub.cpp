@@ -0,0 +1,79 @@
+/*==============================================================================
+
+@@  `w̃X^u[render_stub.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/01
+--------------------------------------------------------------------------------
+@@SIM_HEADLESS rhpBV~[V{́isim_corejĂԕ`ÉE
+@@AZbg֐ȂŖ߂BQ[{̂̃rhɂ͓ȂƁB
+==============================================================================*/
+#ifndef SIM_HEADLESS
+#error "render_stub.cpp is only for SIM_HEADLESS builds"
+#endif
+
+#include "direct3d.h"
+#include "texture.h"
+#include "light.h"
+#include "camera.h"
+#include "key_logger.h"
+#include "imgui_manager.h"
+#include "model_skinned_fixed.h"
+#include "asset_cache.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // ʂ̂ŁAJ̃AXyNg䂾炵Ă
+    constexpr unsigned int SIM_BACKBUFFER_WIDTH = 1280;
+    constexpr unsigned int SIM_BACKBUFFER_HEIGHT = 720;
+
+    XMFLOAT3 g_cameraPosition{ 0.0f, 0.0f, 0.0f };
+}
+
+// ===== Direct3D =====
+unsigned int Direct3D_GetBackBufferWidth() { return SIM_BACKBUFFER_WIDTH; }
+unsigned int Direct3D_GetBackBufferHeight() { return SIM_BACKBUFFER_HEIGHT; }
+ID3D11Device* Direct3D_GetDevice() { return nullptr; }
+ID3D11DeviceContext* Direct3D_GetContext() { return nullptr; }
+
+// ===== Texture =====
+int Texture_Load(const wchar_t*) { return -1; }
+void Texture_SetTexture(int, int) {}
+
+// ===== Light / Camera =====
+void Light_SetSpecularWorld(const XMFLOAT3&, float, const XMFLOAT4&) {}
+const XMFLOAT3& Camera_GetPosition() { return g_cameraPosition; }
+
+// ===== Skinned model =====
+// ڂȂ̂œǂݍ܂Ȃinullptr nĂȂj
+SKINNED_MODEL* SkinnedModel_Load(const char*, float, bool) { return nullptr; }
+void SkinnedModel_Release(SKINNED_MODEL*) {}
+void SkinnedModel_Update(SKINNED_MODEL*, float, int) {}
+void SkinnedModel_UpdateAtTime(SKINNED_MODEL*, float, int) {}
+void SkinnedModel_UpdateClip(SKINNED_MODEL*, float, int, float, float, bool) {}
+void SkinnedModel_ResetPose(SKINNED_MODEL*) {}
+void SkinnedModel_Draw(SKINNED_MODEL*, const XMMATRIX&) {}
+void SkinnedModel_DepthDraw(SKINNED_MODEL*, const XMMATRIX&) {}
+void SkinnedModel_Submit(SKINNED_MODEL*, const XMMATRIX&, RenderPass, float) {}
+AABB SkinnedModel_GetAABB(SKINNED_MODEL*, const XMFLOAT3& position)
+{
+    return AABB{ position, position };
+}
+
+// ===== Asset cache =====
+// ǂ܂Ȃ̂ŏɖȃnh
+AssetHandle Asset_LoadSkinnedModel(const char*, float, bool) { return AssetHandle(); }
+SKINNED_MODEL* Asset_GetSkinnedModel(AssetHandle) { return nullptr; }
+void Asset_Release(AssetHandle* handle) { if (handle) *handle = AssetHandle(); }
+
+// ===== Input =====
+// L[{[h͏ɗςȂBvC[ւ̓͂ Player_SetInputOverride œn
+bool KeyLogger_IsPressed(Keyboard_Keys) { return false; }
+bool KeyLogger_IsTrigger(Keyboard_Keys) { return false; }
+bool KeyLogger_IsRelease(Keyboard_Keys) { return false; }
+
+namespace ImGuiManager
+{
+    bool IsVisible() { return false; }
+}
@@ -24,6 +24,10 @@ static ID3D11Buffer* g_pVSConstantBuffer0 = nullptr; // 
 static ID3D11Buffer* g_pPSConstantBuffer0 = nullptr; // 萔obt@b0
 static ID3D11PixelShader* g_pPixelShader = nullptr;
 
+// CX^X`pi[hs𒸓_͂̃Xbg1jBcsoΎgȂ
+static ID3D11VertexShader* g_pVertexShaderInstanced = nullptr;
+static ID3D11InputLayout* g_pInputLayoutInstanced = nullptr;
+
 // ӁIŊOݒ肳́BReleasesvB
 static ID3D11Device* g_pDevice = nullptr;
 static ID3D11DeviceContext* g_pContext = nullptr;
@@ -166,6 +170,46 @@ bool Shader3D_Initialize(ID3D11Device* pDevice, ID3D11DeviceContext* pContext)
 	/*==Tv[XeCgݒsampler.cpp/hɈڂ*/
 	Sampler_SetFilterAnisotropic();
 
+	// CX^X`p̒_VF[_[iĂʏ`͓j
+	std::ifstream ifs_ivs("shader_vertex_3d_instanced.cso", std::ios::binary);
+	if (!ifs_ivs) {
+		hal::dout << "Shader3D_Initialize() : shader_vertex_3d_instanced.cso ̂ŃCX^X`͎g܂" << std::endl;
+		return true;
+	}
+
+	ifs_ivs.seekg(0, std::ios::end);
+	filesize = ifs_ivs.tellg();
+	ifs_ivs.seekg(0, std::ios::beg);
+
+	unsigned char* ivsbinary_pointer = new unsigned char[filesize];
+	ifs_ivs.read((char*)ivsbinary_pointer, filesize);
+	ifs_ivs.close();
+
+	hr = g_pDevice->CreateVertexShader(ivsbinary_pointer, filesize, nullptr, &g_pVertexShaderInstanced);
+
+	if (SUCCEEDED(hr)) {
+		// Xbg0F_AXbg1FCX^XƂ̃[hsi4sj
+		D3D11_INPUT_ELEMENT_DESC instanced_layout[] = {
+			{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "WORLD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1,  0, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "WORLD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "WORLD", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "WORLD", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+		};
+		hr = g_pDevice->CreateInputLayout(instanced_layout, ARRAYSIZE(instanced_layout), ivsbinary_pointer, filesize, &g_pInputLayoutInstanced);
+	}
+
+	delete[] ivsbinary_pointer;
+
+	if (FAILED(hr)) {
+		hal::dout << "Shader3D_Initialize() : CX^X`pVF[_[̍쐬Ɏs܂" << std::endl;
+		SAFE_RELEASE(g_pInputLayoutInstanced);
+		SAFE_RELEASE(g_pVertexShaderInstanced);
+	}
+
 	return true;
 }
 
@@ -179,6 +223,8 @@ void Shader3D_Finalize()
 	SAFE_RELEASE(g_pPixelShader);
 	SAFE_RELEASE(g_pInputLayout);
 	SAFE_RELEASE(g_pVertexShader);
+	SAFE_RELEASE(g_pInputLayoutInstanced);
+	SAFE_RELEASE(g_pVertexShaderInstanced);
 	g_pDevice = nullptr;
 	g_pContext = nullptr;
 }
@@ -253,4 +299,23 @@ void Shader3D_Begin()
 	//g_pContext->PSSetSamplers(0, 1, &g_pSamplerState);
 	//  3D͉ȉȂǂɌٕ
 	Sampler_SetFilterAnisotropic();
-}
\ No newline at end of file
+}
+
+bool Shader3D_CanInstance()
+{
+	return g_pVertexShaderInstanced && g_pInputLayoutInstanced;
+}
+
+bool Shader3D_BeginInstanced()
+{
+	if (!g_pVertexShaderInstanced || !g_pInputLayoutInstanced) return false;
+
+	g_pContext->VSSetShader(g_pVertexShaderInstanced, nullptr, 0);
+	g_pContext->PSSetShader(g_pPixelShader, nullptr, 0);
+	g_pContext->IASetInputLayout(g_pInputLayoutInstanced);
+
+	// b0(world)͎gȂBF(PS b0)ƃTv[ Shader3D_Begin Ɠ
+	g_pContext->PSSetConstantBuffers(0, 1, &g_pPSConstantBuffer0);
+	Sampler_SetFilterAnisotropic();
+	return true;
+}
@@ -23,5 +23,9 @@ void Shader3d_SetColor(const DirectX::XMFLOAT4& color);
 
 void Shader3D_Begin();
 
+// CX^X`i[hs͒_obt@̃Xbg1jBgȂ false
+bool Shader3D_BeginInstanced();
+bool Shader3D_CanInstance();   // ݒ͂Ag邩
+
 #endif // SHADER3D_H
 
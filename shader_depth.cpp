@@ -16,6 +16,10 @@ static ID3D11Buffer* g_pVSConstantBuffer2 = nullptr; // 
 static ID3D11Buffer* g_pPSConstantBuffer0 = nullptr; // 萔obt@b0
 static ID3D11PixelShader* g_pPixelShader = nullptr;
 
+// CX^X`picsoΎgȂj
+static ID3D11VertexShader* g_pVertexShaderInstanced = nullptr;
+static ID3D11InputLayout* g_pInputLayoutInstanced = nullptr;
+
 bool ShaderDepth_Initialize()
 {
 	HRESULT hr; // ߂li[p
@@ -113,6 +117,42 @@ bool ShaderDepth_Initialize()
 	/*==Tv[XeCgݒsampler.cpp/hɈڂ*/
 	Sampler_SetFilterAnisotropic();
 
+	// CX^X`p̒_VF[_[iĂʏ`͓j
+	std::ifstream ifs_ivs("shader_vertex_depth_instanced.cso", std::ios::binary);
+	if (!ifs_ivs) {
+		hal::dout << "ShaderDepth_Initialize() : shader_vertex_depth_instanced.cso ̂ŃCX^X`͎g܂" << std::endl;
+		return true;
+	}
+
+	ifs_ivs.seekg(0, std::ios::end);
+	filesize = ifs_ivs.tellg();
+	ifs_ivs.seekg(0, std::ios::beg);
+
+	unsigned char* ivsbinary_pointer = new unsigned char[filesize];
+	ifs_ivs.read((char*)ivsbinary_pointer, filesize);
+	ifs_ivs.close();
+
+	hr = Direct3D_GetDevice()->CreateVertexShader(ivsbinary_pointer, filesize, nullptr, &g_pVertexShaderInstanced);
+
+	if (SUCCEEDED(hr)) {
+		D3D11_INPUT_ELEMENT_DESC instanced_layout[] = {
+			{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "WORLD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1,  0, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "WORLD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "WORLD", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "WORLD", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+		};
+		hr = Direct3D_GetDevice()->CreateInputLayout(instanced_layout, ARRAYSIZE(instanced_layout), ivsbinary_pointer, filesize, &g_pInputLayoutInstanced);
+	}
+
+	delete[] ivsbinary_pointer;
+
+	if (FAILED(hr)) {
+		hal::dout << "ShaderDepth_Initialize() : CX^X`pVF[_[̍쐬Ɏs܂" << std::endl;
+		SAFE_RELEASE(g_pInputLayoutInstanced);
+		SAFE_RELEASE(g_pVertexShaderInstanced);
+	}
+
 	return true;
 }
 
@@ -125,6 +165,8 @@ void ShaderDepth_Finalize()
 	SAFE_RELEASE(g_pVSConstantBuffer2);
 	SAFE_RELEASE(g_pInputLayout);
 	SAFE_RELEASE(g_pVertexShader);
+	SAFE_RELEASE(g_pInputLayoutInstanced);
+	SAFE_RELEASE(g_pVertexShaderInstanced);
 }
 
 void ShaderDepth_SetWorldMatrix(const DirectX::XMMATRIX& matrix)
@@ -186,3 +228,17 @@ void ShaderDepth_Begin()
 	// 萔obt@iPSjݒiFpj
 	Direct3D_GetContext()->PSSetConstantBuffers(0, 1, &g_pPSConstantBuffer0);
 }
+
+bool ShaderDepth_BeginInstanced()
+{
+	if (!g_pVertexShaderInstanced || !g_pInputLayoutInstanced) return false;
+
+	Direct3D_GetContext()->VSSetShader(g_pVertexShaderInstanced, nullptr, 0);
+	Direct3D_GetContext()->PSSetShader(g_pPixelShader, nullptr, 0);
+	Direct3D_GetContext()->IASetInputLayout(g_pInputLayoutInstanced);
+
+	ID3D11Buffer* vsCBs[] = { g_pVSConstantBuffer0, g_pVSConstantBuffer1, g_pVSConstantBuffer2 };
+	Direct3D_GetContext()->VSSetConstantBuffers(0, 3, vsCBs);
+	Direct3D_GetContext()->PSSetConstantBuffers(0, 1, &g_pPSConstantBuffer0);
+	return true;
+}
@@ -21,6 +21,8 @@ void ShaderDepth_SetViewMatrix(const DirectX::XMMATRIX& matrix);
 void ShaderDepth_SetProjectionMatrix(const DirectX::XMMATRIX& matrix);
 void ShaderDepth_SetColor(const DirectX::XMFLOAT4& color);
 void ShaderDepth_Begin();
+// CX^X`i[hs͒_obt@̃Xbg1jBgȂ false
+bool ShaderDepth_BeginInstanced();
 
 #endif//SHADER_DEPTH_H
 
@@ -0,0 +1,68 @@
+/*==============================================================================
+
+   3D`p_VF[_[iCX^X`j [shader_vertex_3d_instanced.hlsl]
+														 Author : Tanaka Kouki
+														 Date   : 2026/02/07
+--------------------------------------------------------------------------------
+   shader_vertex_3d.hlsl ƓvZB[hs񂾂萔obt@b0ł͂Ȃ
+   CX^XƂ̒_́iXbg1AWORLD0`3 s̊esjB
+==============================================================================*/
+cbuffer VS_CONSTANT_BUFFER1 : register(b1)
+{
+    float4x4 view;
+};
+
+cbuffer VS_CONSTANT_BUFFER2 : register(b2) 
+{
+    float4x4 projection;
+};
+
+cbuffer VS_CONSTANT_BUFFER3 : register(b3)
+{
+    float4x4 light_view_proj;
+};
+
+struct VS_IN
+{
+    float4 posL : POSITION0;
+    float4 normalL : NORMAL0;
+    float4 color : COLOR0;
+    float2 uv : TEXCOORD0;
+
+    float4 world0 : WORLD0; // CX^Xf[^isxNg`̍sj
+    float4 world1 : WORLD1;
+    float4 world2 : WORLD2;
+    float4 world3 : WORLD3;
+};
+
+struct VS_OUT
+{
+    float4 posH : SV_POSITION;
+    float4 posW : POSITION0;
+    float4 posLightWVP : POSITION1;
+    float3 normalW : NORMAL0;
+    float4 color : COLOR0;
+    float2 uv : TEXCOORD0;
+};
+
+VS_OUT main(VS_IN vi)
+{
+    VS_OUT vo;
+
+    const float4x4 world = float4x4(vi.world0, vi.world1, vi.world2, vi.world3);
+
+    float4 posW = mul(vi.posL, world);
+    float4 posV = mul(posW, view);
+    vo.posH = mul(posV, projection);
+
+    vo.posLightWVP = mul(posW, light_view_proj);
+
+    float4 normalW = mul(float4(vi.normalL.xyz, 0.0f), world);
+    vo.normalW = normalize(normalW.xyz);
+    vo.posW = posW;
+
+    vo.color = vi.color;
+    vo.uv = vi.uv;
+
+    return vo;
+}
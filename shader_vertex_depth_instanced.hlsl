@@ -0,0 +1,45 @@
+/*==============================================================================
+
+   [x`p_VF[_[iCX^X`j [shader_vertex_depth_instanced.hlsl]
+														 Author : Tanaka Kouki
+														 Date   : 2026/02/07
+--------------------------------------------------------------------------------
+   shader_vertex_depth.hlsl ̃[hsCX^X́iWORLD0`3jɂ
+==============================================================================*/
+cbuffer VS_CONSTANT_BUFFER : register(b1)
+{
+    float4x4 view;
+};
+
+cbuffer VS_CONSTANT_BUFFER : register(b2)
+{
+    float4x4 proj;
+};
+
+struct VS_IN
+{
+    float4 posL : POSITION0;
+
+    float4 world0 : WORLD0;
+    float4 world1 : WORLD1;
+    float4 world2 : WORLD2;
+    float4 world3 : WORLD3;
+};
+
+struct VS_0UT
+{
+    float4 posH : SV_POSITION;
+    float4 posW : POSITION0;
+};
+
+VS_0UT main(VS_IN vi)
+{
+    VS_0UT vo;
+
+    const float4x4 world = float4x4(vi.world0, vi.world1, vi.world2, vi.world3);
+    vo.posW = mul(vi.posL, world);
+    float4x4 mtxVP = mul(view, proj);
+    vo.posH = mul(vo.posW, mtxVP);
+
+    return vo;
+}
@@ -0,0 +1,245 @@
+/*==============================================================================
+
+@@  wbhXs[sim_runner.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/01
+--------------------------------------------------------------------------------
+@@`ȂŃXe[WŒt[ŉ񂵂āA1b̃t[oB
+@@  sim_runner --stage simple|magma|disapear|invisible [--json path]
+@@             [--frames N] [--hz 60] [--record file | --replay file]
+@@             [--compile out.bin]
+@@--replay ̂Ƃ̓Xe[WE`[jOEeBbNL^t@CA
+@@OnbVL^ƈv邩mFisv͏IR[h3jB
+@@--compile ̓Xe[W JSON  .bin ɏoďIi񂳂ȂjB
+==============================================================================*/
+#include "sim_stage.h"
+#include "player.h"
+#include "stage01_manage.h"
+#include "stage_cube.h"
+#include "input_replay.h"
+#include "stage_binary.h"
+#include "player_camera.h"
+#include "culling.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace DirectX;
+
+namespace
+{
+    struct SimRunnerArgs
+    {
+        StageId stage = StageId::StageSimple;
+        const char* jsonPath = nullptr;
+        int frames = 6000;
+        double hz = 60.0;
+        const char* recordPath = nullptr;
+        const char* replayPath = nullptr;
+        const char* compilePath = nullptr;
+    };
+
+    bool ParseStageName(const char* s, StageId* out)
+    {
+        static const struct { const char* name; StageId id; } kNames[] =
+        {
+            { "simple",    StageId::StageSimple },
+            { "magma",     StageId::StageMagma },
+            { "disapear",  StageId::StageDisapear },
+            { "invisible", StageId::StageInvisible },
+        };
+        for (const auto& n : kNames)
+        {
+            if (std::strcmp(s, n.name) == 0) { *out = n.id; return true; }
+        }
+        return false;
+    }
+
+    bool ParseArgs(int argc, char** argv, SimRunnerArgs* args)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* a = argv[i];
+            const bool hasValue = (i + 1 < argc);
+            if (std::strcmp(a, "--stage") == 0 && hasValue)
+            {
+                if (!ParseStageName(argv[++i], &args->stage)) return false;
+            }
+            else if (std::strcmp(a, "--json") == 0 && hasValue)
+            {
+                args->jsonPath = argv[++i];
+            }
+            else if (std::strcmp(a, "--frames") == 0 && hasValue)
+            {
+                args->frames = std::atoi(argv[++i]);
+            }
+            else if (std::strcmp(a, "--hz") == 0 && hasValue)
+            {
+                args->hz = std::atof(argv[++i]);
+            }
+            else if (std::strcmp(a, "--record") == 0 && hasValue)
+            {
+                args->recordPath = argv[++i];
+            }
+            else if (std::strcmp(a, "--replay") == 0 && hasValue)
+            {
+                args->replayPath = argv[++i];
+            }
+            else if (std::strcmp(a, "--compile") == 0 && hasValue)
+            {
+                args->compilePath = argv[++i];
+            }
+            else
+            {
+                return false;
+            }
+        }
+        if (args->recordPath && args->replayPath) return false;
+        return args->frames > 0 && args->hz > 0.0;
+    }
+
+    // L^ꂽJSONpXɑΉXe[Wid|̑IpjB΃pXwSimple
+    StageId StageFromJsonPath(const char* jsonPath)
+    {
+        for (int i = 0; i < kPlayableStageCount; ++i)
+        {
+            const StageId id = static_cast<StageId>(i);
+            if (std::strcmp(GetStageInfo(id).jsonPath, jsonPath) == 0) return id;
+        }
+        return StageId::StageSimple;
+    }
+
+    // ̓t@CƂp̌ߑł́B
+    // OiȂ獶EɐUāAԊuŃWvEXsB
+    PlayerInput ScriptedInput(int frame)
+    {
+        PlayerInput in{};
+        in.moveY = 1.0f;
+        in.moveX = (float)std::sin(frame * 0.02);
+        in.jump = (frame % 90) < 12;
+        in.spin = (frame % 240) == 120;
+        in.dash = (frame / 600) % 2 == 1;
+        return in;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    SimRunnerArgs args;
+    if (!ParseArgs(argc, argv, &args))
+    {
+        std::fprintf(stderr,
+            "usage: %s [--stage simple|magma|disapear|invisible] [--json path] [--frames N] [--hz 60]\n"
+            "          [--record file | --replay file] [--compile out.bin]\n",
+            argv[0]);
+        return 2;
+    }
+
+    const bool replaying = (args.replayPath != nullptr);
+    if (replaying)
+    {
+        if (!InputReplay_Load(args.replayPath))
+        {
+            std::fprintf(stderr, "sim_runner: failed to load replay %s\n", args.replayPath);
+            return 1;
+        }
+        args.jsonPath = InputReplay_GetStageJsonPath();
+        args.stage = StageFromJsonPath(args.jsonPath);
+        args.frames = InputReplay_GetFrameCount();
+    }
+
+    const auto loadStart = std::chrono::steady_clock::now();
+    if (!SimStage_Initialize(args.stage, args.jsonPath))
+    {
+        std::fprintf(stderr, "sim_runner: failed to load stage json\n");
+        SimStage_Finalize();
+        return 1;
+    }
+    const double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+    std::printf("stage load  %.3f ms (%s)\n", loadMs, Stage01_GetCurrentJsonPath());
+
+    if (args.compilePath)
+    {
+        const char* jsonPath = args.jsonPath ? args.jsonPath : GetStageInfo(args.stage).jsonPath;
+        const bool ok = StageBinary_Compile(jsonPath, args.compilePath);
+        if (ok) std::printf("compiled    %d blocks -> %s\n", Stage01_GetCount(), args.compilePath);
+        else std::fprintf(stderr, "sim_runner: failed to compile %s\n", jsonPath);
+        SimStage_Finalize();
+        return ok ? 0 : 1;
+    }
+
+    // `̂܂Ƃߕi(kind, texId) Ƃ̃ob`jmFBGPUɂ͑Ȃ
+    Stage01_Draw();
+    const CubeDrawStats& drawStats = Cube_GetDrawStats();
+    std::printf("stage draw  %d blocks -> %d batches\n", drawStats.instances, drawStats.batches);
+
+    double dt = 1.0 / args.hz;
+    if (replaying)
+    {
+        *Player_GetTuning() = InputReplay_GetTuning();
+        dt = InputReplay_GetTickSeconds();
+    }
+    if (args.recordPath)
+    {
+        const char* jsonPath = args.jsonPath ? args.jsonPath : GetStageInfo(args.stage).jsonPath;
+        InputRecord_Begin(jsonPath, *Player_GetTuning(), dt);
+    }
+
+    uint64_t hash = INPUT_REPLAY_HASH_SEED;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < args.frames; ++frame)
+    {
+        PlayerInput in{};
+        if (replaying) InputReplay_GetFrame(frame, &in);
+        else in = ScriptedInput(frame);
+        if (args.recordPath) InputRecord_Push(in);
+
+        Player_SetInputOverride(true, &in);
+        SimStage_Update(dt);
+        hash = InputReplay_HashStep(hash, Player_GetPosition(), Player_GetVelocity());
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const double sec = std::chrono::duration<double>(end - start).count();
+    const XMFLOAT3 pos = Player_GetPosition();
+
+    std::printf("frames      %d\n", args.frames);
+    std::printf("seconds     %.6f\n", sec);
+    std::printf("frames/sec  %.1f\n", sec > 0.0 ? args.frames / sec : 0.0);
+    std::printf("final pos   %.6f %.6f %.6f\n", pos.x, pos.y, pos.z);
+    std::printf("trajectory  %016llx\n", (unsigned long long)hash);
+
+    // Ō̃Jʒu猩ubNi`͂Ȃj
+    Culling_SetView(CULL_VIEW_CAMERA,
+        XMLoadFloat4x4(&PlayerCamera_GetViewMatrix()), XMLoadFloat4x4(&PlayerCamera_GetPerspectiveMatrix()),
+        PlayerCamera_GetPosition(), CULL_DEFAULT_DRAW_DISTANCE);
+    Stage01_Draw();
+    const CullStats& cull = Culling_GetStats(CULL_VIEW_CAMERA);
+    std::printf("camera cull %d visible / %d culled\n", cull.visible, cull.culled);
+    Culling_DisableView(CULL_VIEW_CAMERA);
+
+    Player_SetInputOverride(false, nullptr);
+    SimStage_Finalize();
+
+    int result = 0;
+    if (args.recordPath)
+    {
+        InputRecord_SetTrajectoryHash(hash);
+        if (!InputRecord_Save(args.recordPath))
+        {
+            std::fprintf(stderr, "sim_runner: failed to save %s\n", args.recordPath);
+            result = 1;
+        }
+    }
+    if (replaying && InputReplay_HasTrajectoryHash())
+    {
+        const bool match = (hash == InputReplay_GetTrajectoryHash());
+        std::printf("replay      %s (recorded %016llx)\n", match ? "match" : "MISMATCH",
+            (unsigned long long)InputReplay_GetTrajectoryHash());
+        if (!match) result = 3;
+    }
+    return result;
+}
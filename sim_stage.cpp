@@ -0,0 +1,130 @@
+/*==============================================================================
+
+@@  wbhXpXe[Wis[sim_stage.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/01
+--------------------------------------------------------------------------------
+@@Xe[W̎d|QƂ Stage*Manager_* ̂AQ[isɊւ
+@@iX|[ʒuE}O}̍jŎB
+==============================================================================*/
+#include "sim_stage.h"
+#include "stage01_manage.h"
+#include "player.h"
+#include "player_camera.h"
+#include "trigger_volume.h"
+#include "stage_simple_make.h"
+#include "stage_simple_manager.h"
+#include "stage_magma_make.h"
+#include "stage_magma_manager.h"
+#include "stage_disapear_make.h"
+#include "stage_disapear_manager.h"
+
+using namespace DirectX;
+
+namespace
+{
+    StageId g_simStageId = StageId::StageSimple;
+    StageInfo g_simStageInfo{};
+    bool g_simInitialized = false;
+
+    // stage_magma_manager.cpp Ɠl
+    constexpr float SIM_MAGMA_BASE_Y = -7.0f;
+    float g_simMagmaY = SIM_MAGMA_BASE_Y;
+}
+
+bool SimStage_Initialize(StageId id, const char* jsonPath)
+{
+    if (!StageId_IsPlayable(id)) return false;
+    if (g_simInitialized) SimStage_Finalize();
+
+    g_simStageId = id;
+    g_simStageInfo = GetStageInfo(id);
+    if (jsonPath && jsonPath[0]) g_simStageInfo.jsonPath = jsonPath;
+    g_simMagmaY = SIM_MAGMA_BASE_Y;
+
+    Player_Initialize(g_simStageInfo.spawnPos, g_simStageInfo.spawnFront);
+    PlayerCamera_Initialize();
+    Stage01_Initialize(g_simStageInfo.jsonPath);
+
+    // d|̎sԂZbgĂX|[ʒuɒuiChangeStage Ɠ菇j
+    bool loaded = true;
+    switch (g_simStageId)
+    {
+    case StageId::StageSimple:
+        StageSimple_Initialize();
+        loaded = StageSimple_SetPlayerPositionAndLoadJson(g_simStageInfo.spawnPos, g_simStageInfo.jsonPath);
+        break;
+    case StageId::StageMagma:
+        StageMagma_Initialize();
+        loaded = StageMagma_SetPlayerPositionAndLoadJson(g_simStageInfo.spawnPos, g_simStageInfo.jsonPath);
+        break;
+    case StageId::StageDisapear:
+        StageDisapear_Initialize();
+        loaded = StageDisapear_SetPlayerPositionAndLoadJson(g_simStageInfo.spawnPos, g_simStageInfo.jsonPath);
+        break;
+    default:
+        loaded = Stage01_LoadStage(g_simStageInfo.jsonPath);
+        Player_DebugTeleport(g_simStageInfo.spawnPos, true);
+        break;
+    }
+
+    g_simInitialized = true;
+    return loaded;
+}
+
+void SimStage_Finalize()
+{
+    if (!g_simInitialized) return;
+
+    switch (g_simStageId)
+    {
+    case StageId::StageSimple:   StageSimple_Finalize(); break;
+    case StageId::StageMagma:    StageMagma_Finalize(); break;
+    case StageId::StageDisapear: StageDisapear_Finalize(); break;
+    default: break;
+    }
+
+    Stage01_Finalize();
+    PlayerCamera_Finalize();
+    Player_Finalize();
+    g_simInitialized = false;
+}
+
+void SimStage_Update(double elapsedTime)
+{
+    if (!g_simInitialized) return;
+
+    // Stage*Manager_Update Ɠ
+    switch (g_simStageId)
+    {
+    case StageId::StageSimple:   StageSimple_Update(elapsedTime); break;
+    case StageId::StageMagma:    StageMagma_Update(elapsedTime); break;
+    case StageId::StageDisapear: StageDisapear_Update(elapsedTime); break;
+    default: break;
+    }
+
+    Stage01_Update(elapsedTime);
+    Player_Update(elapsedTime);
+    PlayerCamera_Update((float)elapsedTime);
+    TriggerVolume_Update(Player_GetAABB());
+}
+
+StageId SimStage_GetId()
+{
+    return g_simStageId;
+}
+
+// ===== d|Ă΂ Stage*Manager_* =====
+XMFLOAT3 StageSimpleManager_GetSpawnPosition() { return g_simStageInfo.spawnPos; }
+const char* StageSimpleManager_GetStageJsonPath() { return g_simStageInfo.jsonPath; }
+void StageSimpleManager_AddSpinBreakBillboard(const XMFLOAT3&) {}
+
+XMFLOAT3 StageMagmaManager_GetSpawnPosition() { return g_simStageInfo.spawnPos; }
+const char* StageMagmaManager_GetStageJsonPath() { return g_simStageInfo.jsonPath; }
+float StageMagmaManager_GetMagmaY() { return g_simMagmaY; }
+void StageMagmaManager_AddMagmaY(float a) { g_simMagmaY += a; }
+void StageMagmaManager_SetMagmaY(float y) { g_simMagmaY = y; }
+float StageMagmaManager_GetMagmaBaseY() { return SIM_MAGMA_BASE_Y; }
+
+XMFLOAT3 StageDisapearManager_GetSpawnPosition() { return g_simStageInfo.spawnPos; }
+const char* StageDisapearManager_GetStageJsonPath() { return g_simStageInfo.jsonPath; }
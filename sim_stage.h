@@ -0,0 +1,24 @@
+/*==============================================================================
+
+@@  wbhXpXe[Wis[sim_stage.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/01
+--------------------------------------------------------------------------------
+@@Stage*Manager ̕`EEUI𔲂ŁBXe[W̎d|iStage*_UpdatejA
+@@Stage01APlayerAPlayerCamera Q[ƓԂ1t[i߂B
+==============================================================================*/
+#ifndef SIM_STAGE_H
+#define SIM_STAGE_H
+
+#include "stage_registry.h"
+
+// jsonPath  nullptr / ȂXe[Wo^̃pXg
+bool SimStage_Initialize(StageId id, const char* jsonPath = nullptr);
+void SimStage_Finalize();
+
+// 1t[i߂i͎͂O Player_SetInputOverride œnĂj
+void SimStage_Update(double elapsedTime);
+
+StageId SimStage_GetId();
+
+#endif//SIM_STAGE_H
@@ -0,0 +1,310 @@
+/*==============================================================================
+
+@@  CPU XLjO[skinning.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/19
+--------------------------------------------------------------------------------
+
+==============================================================================*/
+#include "skinning.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define SKIN_USE_SSE 1
+#include <emmintrin.h>
+#else
+#define SKIN_USE_SSE 0
+#endif
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr int SKIN_GROUP = 4;
+    constexpr int SKIN_PARALLEL_MIN = 16384;    // ȏ̒_ȂXbhɕ
+    constexpr int SKIN_THREAD_MAX = 4;
+
+    // 4 _̍s SoA ɂ́Bm[s][][_]is 3 ͕sړj
+    struct alignas(16) BlendedGroup
+    {
+        float m[4][3][SKIN_GROUP];
+    };
+
+    // e{[̍sd݂őBϊ͐`Ȃ̂ŁAϊĂ瑫̂ƓʂɂȂ
+    void BlendVertex(const SkinningStreams& s, int v, const XMMATRIX* bones, int boneCount, XMFLOAT4 rows[4])
+    {
+        const uint16_t* bi = &s.bone[(size_t)v * SKIN_MAX_INFLUENCE];
+        const float* w = &s.weight[(size_t)v * SKIN_MAX_INFLUENCE];
+
+        XMVECTOR r0 = XMVectorZero();
+        XMVECTOR r1 = XMVectorZero();
+        XMVECTOR r2 = XMVectorZero();
+        XMVECTOR r3 = XMVectorZero();
+        float sum = 0.0f;
+
+        for (int i = 0; i < SKIN_MAX_INFLUENCE; ++i)
+        {
+            if (w[i] <= 0.0f || bi[i] >= boneCount) continue;
+
+            const XMMATRIX& M = bones[bi[i]];
+            const XMVECTOR wv = XMVectorReplicate(w[i]);
+            r0 = XMVectorMultiplyAdd(M.r[0], wv, r0);
+            r1 = XMVectorMultiplyAdd(M.r[1], wv, r1);
+            r2 = XMVectorMultiplyAdd(M.r[2], wv, r2);
+            r3 = XMVectorMultiplyAdd(M.r[3], wv, r3);
+            sum += w[i];
+        }
+
+        if (sum <= 0.0f)
+        {
+            // ̖_̓oCh|[Ŷ܂
+            const XMMATRIX I = XMMatrixIdentity();
+            r0 = I.r[0]; r1 = I.r[1]; r2 = I.r[2]; r3 = I.r[3];
+        }
+
+        XMStoreFloat4(&rows[0], r0);
+        XMStoreFloat4(&rows[1], r1);
+        XMStoreFloat4(&rows[2], r2);
+        XMStoreFloat4(&rows[3], r3);
+    }
+
+    void BlendGroup(const SkinningStreams& s, int v0, const XMMATRIX* bones, int boneCount, BlendedGroup* g)
+    {
+        alignas(16) XMFLOAT4 rows[SKIN_GROUP][4];
+        for (int j = 0; j < SKIN_GROUP; ++j)
+            BlendVertex(s, v0 + j, bones, boneCount, rows[j]);
+
+#if SKIN_USE_SSE
+        for (int r = 0; r < 4; ++r)
+        {
+            __m128 a = _mm_load_ps(&rows[0][r].x);
+            __m128 b = _mm_load_ps(&rows[1][r].x);
+            __m128 c = _mm_load_ps(&rows[2][r].x);
+            __m128 d = _mm_load_ps(&rows[3][r].x);
+            _MM_TRANSPOSE4_PS(a, b, c, d);
+            _mm_store_ps(g->m[r][0], a);
+            _mm_store_ps(g->m[r][1], b);
+            _mm_store_ps(g->m[r][2], c);
+        }
+#else
+        for (int j = 0; j < SKIN_GROUP; ++j)
+            for (int r = 0; r < 4; ++r)
+                for (int c = 0; c < 3; ++c)
+                    g->m[r][c][j] = (&rows[j][r].x)[c];
+#endif
+    }
+
+    // v0  count i4 ȉj
+    void SkinGroup(const SkinningStreams& s, int v0, const BlendedGroup& g, SkinningVertex* out, int count)
+    {
+        alignas(16) float pos[3][SKIN_GROUP];
+        alignas(16) float nrm[3][SKIN_GROUP];
+
+#if SKIN_USE_SSE
+        const __m128 px = _mm_loadu_ps(&s.px[v0]);
+        const __m128 py = _mm_loadu_ps(&s.py[v0]);
+        const __m128 pz = _mm_loadu_ps(&s.pz[v0]);
+        const __m128 nx = _mm_loadu_ps(&s.nx[v0]);
+        const __m128 ny = _mm_loadu_ps(&s.ny[v0]);
+        const __m128 nz = _mm_loadu_ps(&s.nz[v0]);
+
+        __m128 n[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            const __m128 m0 = _mm_load_ps(g.m[0][c]);
+            const __m128 m1 = _mm_load_ps(g.m[1][c]);
+            const __m128 m2 = _mm_load_ps(g.m[2][c]);
+
+            __m128 p = _mm_add_ps(_mm_mul_ps(px, m0), _mm_mul_ps(py, m1));
+            p = _mm_add_ps(p, _mm_add_ps(_mm_mul_ps(pz, m2), _mm_load_ps(g.m[3][c])));
+            _mm_store_ps(pos[c], p);
+
+            n[c] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, m0), _mm_mul_ps(ny, m1)), _mm_mul_ps(nz, m2));
+        }
+
+        //  0 ̖@ 0 ̂܂
+        const __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(n[0], n[0]), _mm_mul_ps(n[1], n[1])), _mm_mul_ps(n[2], n[2]));
+        __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(len2));
+        inv = _mm_and_ps(inv, _mm_cmpgt_ps(len2, _mm_setzero_ps()));
+        for (int c = 0; c < 3; ++c)
+            _mm_store_ps(nrm[c], _mm_mul_ps(n[c], inv));
+#else
+        for (int j = 0; j < SKIN_GROUP; ++j)
+        {
+            const int v = v0 + j;
+            float n[3];
+            for (int c = 0; c < 3; ++c)
+            {
+                pos[c][j] = s.px[v] * g.m[0][c][j] + s.py[v] * g.m[1][c][j] + s.pz[v] * g.m[2][c][j] + g.m[3][c][j];
+                n[c] = s.nx[v] * g.m[0][c][j] + s.ny[v] * g.m[1][c][j] + s.nz[v] * g.m[2][c][j];
+            }
+            const float len2 = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+            const float inv = (len2 > 0.0f) ? 1.0f / std::sqrt(len2) : 0.0f;
+            for (int c = 0; c < 3; ++c) nrm[c][j] = n[c] * inv;
+        }
+#endif
+
+        // ݐp̃iMap  VBjȂ̂œǂ܂ 1 _S
+        for (int j = 0; j < count; ++j)
+        {
+            SkinningVertex& o = out[v0 + j];
+            o.position = { pos[0][j], pos[1][j], pos[2][j] };
+            o.normal = { nrm[0][j], nrm[1][j], nrm[2][j] };
+            o.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+            o.texcoord = s.uv[v0 + j];
+        }
+    }
+
+    // begin  SKIN_GROUP ̔{
+    void SkinRange(const SkinningStreams& s, const XMMATRIX* bones, int boneCount, SkinningVertex* out, int begin, int end)
+    {
+        BlendedGroup g;
+        for (int v = begin; v < end; v += SKIN_GROUP)
+        {
+            BlendGroup(s, v, bones, boneCount, &g);
+            SkinGroup(s, v, g, out, std::min(SKIN_GROUP, end - v));
+        }
+    }
+}
+
+void Skinning_Resize(SkinningStreams* s, int vertexCount)
+{
+    const size_t padded = (size_t)((vertexCount + SKIN_GROUP - 1) / SKIN_GROUP) * SKIN_GROUP;
+
+    s->vertexCount = vertexCount;
+    s->px.assign(padded, 0.0f); s->py.assign(padded, 0.0f); s->pz.assign(padded, 0.0f);
+    s->nx.assign(padded, 0.0f); s->ny.assign(padded, 0.0f); s->nz.assign(padded, 0.0f);
+    s->uv.assign((size_t)vertexCount, XMFLOAT2(0.0f, 0.0f));
+    s->bone.assign(padded * SKIN_MAX_INFLUENCE, 0);
+    s->weight.assign(padded * SKIN_MAX_INFLUENCE, 0.0f);
+}
+
+void Skinning_SetVertex(SkinningStreams* s, int v,
+    const XMFLOAT3& position, const XMFLOAT3& normal, const XMFLOAT2& uv,
+    const uint16_t* bones, const float* weights)
+{
+    s->px[v] = position.x; s->py[v] = position.y; s->pz[v] = position.z;
+    s->nx[v] = normal.x; s->ny[v] = normal.y; s->nz[v] = normal.z;
+    s->uv[v] = uv;
+    for (int i = 0; i < SKIN_MAX_INFLUENCE; ++i)
+    {
+        s->bone[(size_t)v * SKIN_MAX_INFLUENCE + i] = bones[i];
+        s->weight[(size_t)v * SKIN_MAX_INFLUENCE + i] = weights[i];
+    }
+}
+
+namespace
+{
+    // ===== `̃Xbhit[ƍEŏd̂ŁAŏɎgƂɍĎj=====
+    // Skinning_Run 1 񕪁B[J[ w  [(w + 1) * per, (w + 2) * per) 󂯎
+    struct SkinJob
+    {
+        const SkinningStreams* s = nullptr;
+        const XMMATRIX* bones = nullptr;
+        int boneCount = 0;
+        SkinningVertex* out = nullptr;
+        int count = 0;
+        int per = 0;
+    };
+
+    std::mutex g_runMutex;                  // Skinning_Run 𓯎ɌĂ΂Ă 1 
+    std::mutex g_workMutex;
+    std::condition_variable g_workWake;     // VdI
+    std::condition_variable g_workDone;     // S󂯎I
+    std::vector<std::thread> g_workers;
+    SkinJob g_job;
+    unsigned int g_jobSerial = 0;           // dƂ +1i[J[͑OɌԍƔׂj
+    int g_jobPending = 0;
+    bool g_workQuit = false;
+
+    void WorkerMain(int worker)
+    {
+        unsigned int seen = 0;
+        for (;;)
+        {
+            SkinJob job;
+            {
+                std::unique_lock<std::mutex> lock(g_workMutex);
+                g_workWake.wait(lock, [&] { return g_workQuit || g_jobSerial != seen; });
+                if (g_workQuit) return;
+                seen = g_jobSerial;
+                job = g_job;
+            }
+
+            const int begin = (worker + 1) * job.per;
+            if (begin < job.count)
+                SkinRange(*job.s, job.bones, job.boneCount, job.out, begin, std::min(begin + job.per, job.count));
+
+            std::lock_guard<std::mutex> lock(g_workMutex);
+            if (--g_jobPending == 0) g_workDone.notify_one();
+        }
+    }
+
+    // IɃ[J[~߂ig_workers Ȃǂɍ̂Őɉ󂳂j
+    struct SkinWorkerShutdown
+    {
+        ~SkinWorkerShutdown()
+        {
+            {
+                std::lock_guard<std::mutex> lock(g_workMutex);
+                g_workQuit = true;
+            }
+            g_workWake.notify_all();
+            for (std::thread& th : g_workers) th.join();
+            g_workers.clear();
+        }
+    } g_workerShutdown;
+}
+
+void Skinning_Run(const SkinningStreams& s, const XMMATRIX* bones, int boneCount, SkinningVertex* out)
+{
+    const int count = s.vertexCount;
+    if (count <= 0 || !out) return;
+
+    static const int hw = (int)std::thread::hardware_concurrency();    // t[ĂԂ̂ 1 񂾂ׂ
+    if (count < SKIN_PARALLEL_MIN || hw < 2)
+    {
+        SkinRange(s, bones, boneCount, out, 0, count);
+        return;
+    }
+
+    // O[vPʂŋϓɕBꏊʂȂ̂ŃbN͗vȂB̃Xbh擪󂯎
+    const int threads = std::min(hw, SKIN_THREAD_MAX);
+    const int groups = (count + SKIN_GROUP - 1) / SKIN_GROUP;
+    const int per = ((groups + threads - 1) / threads) * SKIN_GROUP;
+
+    std::lock_guard<std::mutex> run(g_runMutex);
+    {
+        std::lock_guard<std::mutex> lock(g_workMutex);
+        while ((int)g_workers.size() < threads - 1)
+            g_workers.emplace_back(WorkerMain, (int)g_workers.size());
+
+        g_job.s = &s;
+        g_job.bones = bones;
+        g_job.boneCount = boneCount;
+        g_job.out = out;
+        g_job.count = count;
+        g_job.per = per;
+        g_jobPending = (int)g_workers.size();
+        ++g_jobSerial;
+    }
+    g_workWake.notify_all();
+
+    SkinRange(s, bones, boneCount, out, 0, std::min(per, count));
+
+    std::unique_lock<std::mutex> lock(g_workMutex);
+    g_workDone.wait(lock, [] { return g_jobPending == 0; });
+}
+
+size_t Skinning_GetBytes(const SkinningStreams& s)
+{
+    return (s.px.capacity() + s.py.capacity() + s.pz.capacity()
+        + s.nx.capacity() + s.ny.capacity() + s.nz.capacity()
+        + s.weight.capacity()) * sizeof(float)
+        + s.uv.capacity() * sizeof(XMFLOAT2)
+        + s.bone.capacity() * sizeof(uint16_t);
+}
@@ -0,0 +1,58 @@
+/*==============================================================================
+
+@@  CPU XLjO[skinning.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/19
+--------------------------------------------------------------------------------
+@@oCh|[Y̒_ SoA ŎA{[s񂩂ό`̒_B
+@@  E_Ƃɉe{[iő 4j̍sd݂ōĂ 1 񂾂ϊ
+@@  E4 _ SSE ŌvZiʒuE@EKj
+@@  E_Ƃ̓XbhɕiXbh͍ŏɍĎj
+@@  Eo͂ Map _obt@ɒڏiWRITE_DISCARD Ȃ̂ŐFEUV 񏑂j
+@@`ɂ͐GȂ̂ SIM_HEADLESS łrhłB
+==============================================================================*/
+#ifndef SKINNING_H
+#define SKINNING_H
+
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+constexpr int SKIN_MAX_INFLUENCE = 4;
+
+// _obt@ 1 _ishader3d  InputLayout Ɠсj
+struct SkinningVertex
+{
+    DirectX::XMFLOAT3 position;
+    DirectX::XMFLOAT3 normal;
+    DirectX::XMFLOAT4 color;
+    DirectX::XMFLOAT2 texcoord;
+};
+
+// oCh|[YBz 4 ̔{܂ŋlߕilߕ͏d 0j
+struct SkinningStreams
+{
+    int vertexCount = 0;
+
+    std::vector<float> px, py, pz;
+    std::vector<float> nx, ny, nz;
+    std::vector<DirectX::XMFLOAT2> uv;
+
+    // _ v  i Ԗڂ [v * SKIN_MAX_INFLUENCE + i]Bd 0 ͔΂
+    std::vector<uint16_t> bone;
+    std::vector<float> weight;
+};
+
+void Skinning_Resize(SkinningStreams* s, int vertexCount);
+void Skinning_SetVertex(SkinningStreams* s, int v,
+    const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& normal, const DirectX::XMFLOAT2& uv,
+    const uint16_t* bones, const float* weights);   // bones / weights  SKIN_MAX_INFLUENCE 
+
+// bones[boneCount] ŕό` out[vertexCount] ɏB͈͊Õ{[͖A
+// d݂S 0 ̒_̓oCh|[Ŷ܂܁Bout ͏ݐpɎg
+void Skinning_Run(const SkinningStreams& s, const DirectX::XMMATRIX* bones, int boneCount, SkinningVertex* out);
+
+// CPU ŎĂ邨悻̃oCg
+size_t Skinning_GetBytes(const SkinningStreams& s);
+
+#endif // SKINNING_H
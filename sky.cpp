@@ -11,9 +11,13 @@
 #include "direct3d.h"
 #include "model.h"
 #include "shader3d_unlit.h"
+#include "asset_cache.h"
 
 using namespace DirectX;
 
+static constexpr const char* kSkyModelPath = "sky.fbx";
+
+static AssetHandle g_skyAsset;
 static MODEL* g_pModelSky{ nullptr };
 static ID3D11RasterizerState* g_pRasterizerStateCullNone{ nullptr };
 static XMFLOAT3 g_position{};
@@ -22,7 +26,8 @@ static XMFLOAT3 g_position{};
 void Sky_Initialize()
 {
 
-	g_pModelSky = ModelLoad("sky.fbx", 100.0f, true);
+	g_skyAsset = Asset_LoadModel(kSkyModelPath, 100.0f, true);
+	g_pModelSky = Asset_GetModel(g_skyAsset);
 
 	ID3D11Device* device = Direct3D_GetDevice();
 	if (device) {
@@ -34,9 +39,15 @@ void Sky_Initialize()
 	}
 }
 
+void Sky_CollectAssets(AssetPrefetchList* list)
+{
+	if (list) list->models.push_back(kSkyModelPath);
+}
+
 void Sky_Finalize()
 {
-	ModelRelease(g_pModelSky);
+	Asset_Release(&g_skyAsset);
+	g_pModelSky = nullptr;
 	SAFE_RELEASE(g_pRasterizerStateCullNone);
 }
 
@@ -61,6 +72,33 @@ void Sky_Draw()
 	SAFE_RELEASE(prevState);
 }
 
+// `L[Ă΂iVF[_[ƃeNX`̓L[ݒς݁jB
+// ͉sAʂ`̂ŁA̕Ő؂ւĖ߂
+static void DrawSkyMesh(const void* data, int param)
+{
+	ID3D11DeviceContext* ctx = Direct3D_GetContext();
+	ID3D11RasterizerState* prevState = nullptr;
+	if (ctx && g_pRasterizerStateCullNone) {
+		ctx->RSGetState(&prevState);
+		ctx->RSSetState(g_pRasterizerStateCullNone);
+	}
+	Direct3D_SetDepthDepthWriteDisable();
+
+	Model_DrawMesh(data, param);
+
+	Direct3D_SetDepthEnable(true);
+	if (ctx && g_pRasterizerStateCullNone) {
+		ctx->RSSetState(prevState);
+	}
+	SAFE_RELEASE(prevState);
+}
+
+void Sky_Submit()
+{
+	Model_Submit(g_pModelSky, XMMatrixTranslationFromVector(XMLoadFloat3(&g_position)),
+		RENDER_PASS_SKY, RENDER_SHADER_3D_UNLIT, 0.0f, DrawSkyMesh);
+}
+
 void Sky_SetPosition(const DirectX::XMFLOAT3& position)
 {
 	g_position = position;
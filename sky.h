@@ -12,9 +12,13 @@
 
 #include<DirectXMath.h>
 
+struct AssetPrefetchList;
+
 void Sky_Initialize();
+void Sky_CollectAssets(AssetPrefetchList* list);	// Sky_Initialize ǂނ
 void Sky_Finalize();
 void Sky_Draw();
+void Sky_Submit();	// Sky_Draw ̕`L[ŁiRENDER_PASS_SKY ɐςށj
 
 void Sky_SetPosition(const DirectX::XMFLOAT3& position);
 
@@ -159,30 +159,50 @@ m_StartPosition.x
 	);
 }
 
-void BillboardAnim_Draw(int playid, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT2& scale, const DirectX::XMFLOAT2& pivot)
+static XMUINT4 BillboardAnim_GetCut(int playid)
 {
 	int anim_pattern_id = g_AnimPlay[playid].m_PatternId;
 	AnimPatternData* pAnimPatternData = &g_AnimPattern[anim_pattern_id];
 
-	Billboard_Draw(pAnimPatternData->m_TextureId,
+	return {
+		pAnimPatternData->m_StartPosition.x
+		+ pAnimPatternData->m_PatternSize.x
+		* (g_AnimPlay[playid].m_PatternNum % pAnimPatternData->m_HPatternMax),
+
+		pAnimPatternData->m_StartPosition.y
+		+ pAnimPatternData->m_PatternSize.y
+		* (g_AnimPlay[playid].m_PatternNum / pAnimPatternData->m_HPatternMax),
+
+		pAnimPatternData->m_PatternSize.x,
+		pAnimPatternData->m_PatternSize.y,
+	};
+}
+
+void BillboardAnim_Draw(int playid, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT2& scale, const DirectX::XMFLOAT2& pivot)
+{
+	Billboard_Draw(BillboardAnim_GetTextureId(playid),
 		position, scale,
-		{
-			pAnimPatternData->m_StartPosition.x
-			+ pAnimPatternData->m_PatternSize.x
-			* (g_AnimPlay[playid].m_PatternNum % pAnimPatternData->m_HPatternMax),
-
-			pAnimPatternData->m_StartPosition.y
-			+ pAnimPatternData->m_PatternSize.y
-			* (g_AnimPlay[playid].m_PatternNum / pAnimPatternData->m_HPatternMax),
-
-			pAnimPatternData->m_PatternSize.x,
-			pAnimPatternData->m_PatternSize.y,
-		},
+		BillboardAnim_GetCut(playid),
 		{ 1.0f,1.0f,1.0f,1.0f },
 		pivot
 	);
 }
 
+void BillboardAnim_DrawBound(int playid, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT2& scale, const DirectX::XMFLOAT2& pivot)
+{
+	Billboard_DrawBound(BillboardAnim_GetTextureId(playid),
+		position, scale,
+		BillboardAnim_GetCut(playid),
+		{ 1.0f,1.0f,1.0f,1.0f },
+		pivot
+	);
+}
+
+int BillboardAnim_GetTextureId(int playid)
+{
+	return g_AnimPattern[g_AnimPlay[playid].m_PatternId].m_TextureId;
+}
+
 /*1̃Aj[Vp^[iXvCg̕jo^āAǗԍԂ֐*/
 /*֐̖ړI
 XvCgV[giL摜ł1GjA
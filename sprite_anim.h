@@ -18,6 +18,9 @@ void SpriteAnim_Update(double elapsed_time);
 void SpriteAnim_Draw(int playid,float dx,float dy,float dw,float dh);
 
 void BillboardAnim_Draw(int playid, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT2& scale, const DirectX::XMFLOAT2& pivot = { 0.0f,0.0f });
+// `L[pir{[h̃pCvCƃeNX`͐ݒς݂̑Oj
+void BillboardAnim_DrawBound(int playid, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT2& scale, const DirectX::XMFLOAT2& pivot = { 0.0f,0.0f });
+int  BillboardAnim_GetTextureId(int playid);
 
 int SpriteAnim_RegisterPattern(
 	int texid ,// gpeNX`IDi摜̊Ǘԍj
@@ -1,9 +1,16 @@
 #include "staga_system.h"
 #include "stage_simple_manager.h"
 #include "stage_magma_manager.h"
+#include "stage01_manage.h"
+#include "asset_cache.h"
+#include "debug_ostream.h"
+#include <atomic>
+#include <thread>
 
 // StageSystem routes calls to each stage manager.
 // NOTE: Only playable stages (StageId::StageSimple .. StageId::StageInvisible) are valid here.
+// ؂ւ͗Ŏ̃Xe[WǂŁiJSON/.bin ̓ǂݍ݂ BakejAǂݏIt[œւB
+// ǂłԂ̃Xe[W͓B
 
 namespace
 {
@@ -16,6 +23,14 @@ namespace
     static bool      g_inited = false;
     static StageImpl g_implCur = StageImpl::Simple;
 
+    // ł̓ǂݍ݁ig_loadData ̓XbhI܂ŃCXbhGȂj
+    static std::thread       g_loader;
+    static std::atomic<bool> g_loaderDone{ false };
+    static bool              g_loading = false;
+    static StageId           g_loadingId = StageId::StageSimple;
+    static StageLoadData     g_loadData;
+    static AssetPrefetchList g_loadAssets;      // ŃfR[hĂt@CiStage01 ȊOj
+
     static StageImpl ImplFor(StageId id)
     {
         // MagmapB̑Simplen}l[WŏiDisapear/Invisibleɓj
@@ -46,6 +61,85 @@ namespace
         }
 
         g_inited = true;
+
+        // ÕXe[WŎgĂAZbgiŎĝ͓ǂݒĂȂj
+        Asset_CollectUnused();
+    }
+
+    static void CollectAssets(StageId id, AssetPrefetchList* list)
+    {
+        switch (ImplFor(id))
+        {
+        case StageImpl::Simple: StageSimpleManager_CollectAssets(list); break;
+        case StageImpl::Magma:  StageMagmaManager_CollectAssets(list);  break;
+        }
+    }
+
+    static void StartLoad(StageId id)
+    {
+        g_loadingId = id;
+        g_loading = true;
+        g_loaderDone = false;
+        const char* jsonPath = GetStageInfo(id).jsonPath;
+
+        // ǂނ̓CXbhŌ߂iĂ͓̂ǂ܂Ȃj
+        g_loadAssets = AssetPrefetchList();
+        CollectAssets(id, &g_loadAssets);
+        Asset_SkipResident(&g_loadAssets);
+
+        // ł̓t@C̃fR[h܂ŁBD3D / XAudio ̃IuWFNg͓ւɃCXbhō
+        g_loader = std::thread([jsonPath]()
+            {
+                Stage01_PrepareLoad(jsonPath, &g_loadData);
+                Asset_Prefetch(g_loadAssets);
+                g_loaderDone = true;
+            });
+    }
+
+    static void WaitLoad()
+    {
+        if (g_loader.joinable()) g_loader.join();
+        g_loading = false;
+    }
+
+    // gȂǂݍ݌ʂ̂Ă
+    static void DiscardLoad()
+    {
+        WaitLoad();
+        Asset_DiscardPrefetched();
+    }
+
+    // ǂݏÎa id BXe[Wǂ߂ĂȂ falseiȂj
+    static bool InitializeLoaded(StageId id)
+    {
+        WaitLoad();
+
+        if (g_loadData.error[0])
+        {
+            hal::dout << "StageSystem : " << g_loadData.error << std::endl;
+            Asset_DiscardPrefetched();
+            return false;
+        }
+
+        Stage01_SetPreparedLoad(&g_loadData);
+        FinalizeCurrent();
+        g_cur = id;
+        InitializeStage(g_cur);   // Stage01_InitializeETexture_Load Ȃǂâ̂܂܎g
+        Asset_DiscardPrefetched();
+        return true;
+    }
+
+    static void SwapToLoaded()
+    {
+        // ǂłԂɕʂ̃Xe[WɕςĂ̂Ăi Update œǂݒj
+        if (g_loadingId != g_req || g_req == g_cur)
+        {
+            DiscardLoad();
+            return;
+        }
+
+        // ǂ߂Ȃ獡̃Xe[Ŵ܂
+        InitializeLoaded(g_req);
     }
 
     static void UpdateCurrent(double dt)
@@ -76,17 +170,32 @@ void StageSystem_Initialize(StageId first)
     if (!StageId_IsPlayable(first))
         first = StageId::StageSimple;
 
-    FinalizeCurrent();
-
-    g_cur = first;
     g_req = first;
     g_hasReq = false;
 
+    // StageSystem_Preload œǂł΂g
+    if (g_loading && g_loadingId == first && InitializeLoaded(first))
+        return;
+
+    DiscardLoad();
+    FinalizeCurrent();
+
+    g_cur = first;
     InitializeStage(g_cur);
 }
 
+void StageSystem_Preload(StageId id)
+{
+    if (!StageId_IsPlayable(id) || g_loading)
+        return;
+
+    StartLoad(id);
+}
+
 void StageSystem_Finalize()
 {
+    DiscardLoad();
+    g_hasReq = false;
     FinalizeCurrent();
 }
 
@@ -115,16 +224,15 @@ void StageSystem_RequestPrev()
 
 void StageSystem_Update(double dt)
 {
-    if (g_hasReq)
+    if (g_loading && g_loaderDone)
+        SwapToLoaded();
+
+    if (g_hasReq && !g_loading)
     {
         g_hasReq = false;
 
         if (g_req != g_cur)
-        {
-            FinalizeCurrent();
-            g_cur = g_req;
-            InitializeStage(g_cur);
-        }
+            StartLoad(g_req);
     }
 
     UpdateCurrent(dt);
@@ -139,3 +247,8 @@ StageId StageSystem_GetCurrent()
 {
     return g_cur;
 }
+
+bool StageSystem_IsLoading()
+{
+    return g_loading && !g_loaderDone;
+}
@@ -4,7 +4,8 @@
                                                          Author : Kouki Tanaka
                                                          Date   : 2026/01/12
 --------------------------------------------------------------------------------
-
+@@StageSystem_RequestChange ͎̃Xe[WʃXbhœǂݎn߂邾ŁA
+@@ւ͓ǂݏIt[ StageSystem_Update  1 ɍsB
 ==============================================================================*/
 
 #ifndef STAGE_SYSTEM_H
@@ -13,6 +14,8 @@
 #include "stage_registry.h"
 
 void StageSystem_Initialize(StageId first);
+// ^CgȂǂAfirst 𗠂œǂݎn߂ĂiStageSystem_Initialize ǂݏI҂Ďgj
+void StageSystem_Preload(StageId id);
 void StageSystem_Finalize();
 void StageSystem_RequestChange(StageId next);
 void StageSystem_RequestNext();
@@ -20,5 +23,6 @@ void StageSystem_RequestPrev();
 void StageSystem_Update(double dt);
 void StageSystem_Draw();
 StageId StageSystem_GetCurrent();
+bool StageSystem_IsLoading();  // ̃Xe[W𗠂œǂłiǂݏI܂ truej
 
 #endif//STAGE_SYSTEM_H
\ No newline at end of file
@@ -9,11 +9,16 @@
 #include "stage01_manage.h"
 #include "stage01_make.h"
 
-#include "cube_.h"
 #include "texture.h"
 #include "direct3d.h"
 #include"stage_cube.h"
 #include"stage_map.h"
+#include "culling.h"
+#include "stage_motion.h"
+#include "stage_binary.h"
+#include "json_reader.h"
+#include "debug_ostream.h"
+#include "asset_cache.h"
 #include <vector>
 #include <cfloat> // FLT_MAX
 #include <fstream>
@@ -24,6 +29,19 @@
 #include <iomanip>
 #include <algorithm>
 #include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define STAGE_USE_SSE 1
+#include <emmintrin.h>
+#else
+#define STAGE_USE_SSE 0
+#endif
 
 
 
@@ -32,6 +50,7 @@ using namespace DirectX;
 namespace
 {
     std::vector<StageBlock> g_blocks;
+    int g_nextBlockId = 0;      // Stage01_Add ŕt StageBlock::id
 
     struct StageRuntimeOffset
     {
@@ -65,18 +84,37 @@ namespace
 
     int g_tex[TEX_MAX];//TexSloť
 
-    char g_stageJsonPath[260] = "stage01.json";
+    // TexSlot Ƃ̉摜iStage01_Initialize ǂ݁AStage01_CollectAssets ǂ݂ɏoj
+    struct StageTexFile
+    {
+        int slot;
+        const wchar_t* path;
+    };
+    const StageTexFile k_stageTexFiles[] =
+    {
+        { TEX_BRICK, L"texture/rengaBlock.png" }, { TEX_RED, L"texture/red.png" }, { TEX_WHITE, L"white.png" },
 
+        { TEX_STONE0, L"texture/stone0.png" }, { TEX_STONE1, L"texture/stone1.png" },
+        { TEX_STONE2, L"texture/stone2.png" }, { TEX_STONE3, L"texture/stone3.png" },
+        { TEX_STONE4, L"texture/stone4.png" }, { TEX_STONE5, L"texture/stone5.png" },
+        { TEX_STONE6, L"texture/stone6.png" }, { TEX_STONE7, L"texture/stone7.png" },
+        { TEX_STONE8, L"texture/stone8.jpg" }, { TEX_STONE9, L"texture/stone9.jpg" },
 
-    const XMFLOAT3 kCorners[8] =
-    {
-        {-0.5f,-0.5f,-0.5f}, {+0.5f,-0.5f,-0.5f},
-        {-0.5f,+0.5f,-0.5f}, {+0.5f,+0.5f,-0.5f},
-        {-0.5f,-0.5f,+0.5f}, {+0.5f,-0.5f,+0.5f},
-        {-0.5f,+0.5f,+0.5f}, {+0.5f,+0.5f,+0.5f},
+        { TEX_WOOD0, L"texture/wood0.png" }, { TEX_WOOD1, L"texture/wood1.png" },
+        { TEX_WOOD2, L"texture/wood2.png" }, { TEX_WOOD3, L"texture/wood3.png" },
+
+        { TEX_V0, L"texture/v0.png" }, { TEX_V1, L"texture/v1.png" },
+        { TEX_V2, L"texture/v2.png" }, { TEX_V3, L"texture/v3.png" },
+        { TEX_V4, L"texture/v4.png" }, { TEX_V5, L"texture/v5.png" },
+        { TEX_V6, L"texture/v6.jpg" }, { TEX_V7, L"texture/v7.png" },
+
+        { TEX_CHECK0, L"texture/check0.png" }, { TEX_CHECK1, L"texture/check1.jpg" },
     };
 
-    void Bake(StageBlock& b, const StageRuntimeOffset& offset)
+    char g_stageJsonPath[260] = "stage01.json";
+
+
+    XMMATRIX ComposeWorld(const StageBlock& b, const StageRuntimeOffset& offset)
     {
         const XMFLOAT3 size{
         b.size.x + b.sizeOffset.x + offset.size.x,
@@ -97,30 +135,739 @@ namespace
         XMMATRIX S = XMMatrixScaling(size.x, size.y, size.z);
         XMMATRIX R = XMMatrixRotationRollPitchYaw(rot.x, rot.y, rot.z);
         XMMATRIX T = XMMatrixTranslation(pos.x, pos.y, pos.z);
-        XMMATRIX W = S * R * T;
+        return S * R * T;
+    }
+
+    // ===== Bakeiworld s aabb j =====
+    // Pʗ́i}0.5j W Œu aabb ́A8 _ϊȂĂ
+    //   S = W ̕sړȂ傫 = 0.5 * (|W|  3x3 ̗񂲂Ƃ̘a)
+    // ŏoBBAKE_CHUNK  SoA ɕׂ 4  SSE ŌvZB
+    constexpr int BAKE_CHUNK = 64;
+    constexpr int BAKE_PARALLEL_MIN = 4096;  // ȏ܂Ƃ߂ Bake Ƃ̓Xbhɕi[hȂǁj
+
+    void BakeExtents(const float m[9][BAKE_CHUNK], const float t[3][BAKE_CHUNK],
+        float mn[3][BAKE_CHUNK], float mx[3][BAKE_CHUNK], int count)
+    {
+        int k = 0;
+#if STAGE_USE_SSE
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        const __m128 half = _mm_set1_ps(0.5f);
+        for (; k + 4 <= count; k += 4)
+        {
+            for (int a = 0; a < 3; ++a)
+            {
+                //  aF|m[a]| + |m[3+a]| + |m[6+a]|
+                __m128 e = _mm_and_ps(_mm_load_ps(&m[a][k]), absMask);
+                e = _mm_add_ps(e, _mm_and_ps(_mm_load_ps(&m[3 + a][k]), absMask));
+                e = _mm_add_ps(e, _mm_and_ps(_mm_load_ps(&m[6 + a][k]), absMask));
+                e = _mm_mul_ps(e, half);
+
+                const __m128 c = _mm_load_ps(&t[a][k]);
+                _mm_store_ps(&mn[a][k], _mm_sub_ps(c, e));
+                _mm_store_ps(&mx[a][k], _mm_add_ps(c, e));
+            }
+        }
+#endif
+        for (; k < count; ++k)
+        {
+            for (int a = 0; a < 3; ++a)
+            {
+                const float e = (std::fabs(m[a][k]) + std::fabs(m[3 + a][k]) + std::fabs(m[6 + a][k])) * 0.5f;
+                mn[a][k] = t[a][k] - e;
+                mx[a][k] = t[a][k] + e;
+            }
+        }
+    }
+
+    // indices  BAKE_CHUNK ܂ŁBubNƂɏꏊʂȂ̂ŃXbhĂł悢B
+    // blocks / offsets  g_blocks / g_offsets Aœǂݍݒ̂́ioffsets=nullptr Ȃ瓮Ȃj
+    void BakeChunk(StageBlock* blocks, const StageRuntimeOffset* offsets, const int* indices, int count)
+    {
+        static const StageRuntimeOffset kNoOffset{};
+
+        alignas(16) float m[9][BAKE_CHUNK];
+        alignas(16) float t[3][BAKE_CHUNK];
+        alignas(16) float mn[3][BAKE_CHUNK];
+        alignas(16) float mx[3][BAKE_CHUNK];
+
+        for (int k = 0; k < count; ++k)
+        {
+            StageBlock& b = blocks[indices[k]];
+            XMStoreFloat4x4(&b.world, ComposeWorld(b, offsets ? offsets[indices[k]] : kNoOffset));
+
+            const XMFLOAT4X4& w = b.world;
+            m[0][k] = w._11; m[1][k] = w._12; m[2][k] = w._13;
+            m[3][k] = w._21; m[4][k] = w._22; m[5][k] = w._23;
+            m[6][k] = w._31; m[7][k] = w._32; m[8][k] = w._33;
+            t[0][k] = w._41; t[1][k] = w._42; t[2][k] = w._43;
+        }
+
+        BakeExtents(m, t, mn, mx, count);
+
+        for (int k = 0; k < count; ++k)
+        {
+            AABB& box = blocks[indices[k]].aabb;
+            box.min = { mn[0][k], mn[1][k], mn[2][k] };
+            box.max = { mx[0][k], mx[1][k], mx[2][k] };
+        }
+    }
+
+    void BakeBatch(StageBlock* blocks, const StageRuntimeOffset* offsets, const int* indices, int count)
+    {
+        auto run = [blocks, offsets, indices](int begin, int end)
+            {
+                for (int k = begin; k < end; k += BAKE_CHUNK)
+                    BakeChunk(blocks, offsets, indices + k, std::min(BAKE_CHUNK, end - k));
+            };
+
+        const int hw = (int)std::thread::hardware_concurrency();
+        if (count < BAKE_PARALLEL_MIN || hw < 2)
+        {
+            run(0, count);
+            return;
+        }
+
+        // `NPʂŋϓɕB̃Xbh擪̕󂯎
+        const int threads = std::min(hw, 8);
+        const int chunks = (count + BAKE_CHUNK - 1) / BAKE_CHUNK;
+        const int per = ((chunks + threads - 1) / threads) * BAKE_CHUNK;
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (int begin = per; begin < count; begin += per)
+            pool.emplace_back(run, begin, std::min(begin + per, count));
+        run(0, std::min(per, count));
+        for (std::thread& th : pool) th.join();
+    }
+
+    void Bake(int index)
+    {
+        BakeChunk(g_blocks.data(), g_offsets.data(), &index, 1);
+    }
+
+    // S Bake i[hj
+    void BakeBlocks(std::vector<StageBlock>& blocks, const StageRuntimeOffset* offsets)
+    {
+        std::vector<int> all(blocks.size());
+        for (int i = 0; i < (int)all.size(); ++i) all[i] = i;
+        BakeBatch(blocks.data(), offsets, all.data(), (int)all.size());
+    }
+}
+
+// ===== s̖ubNiꂽKȂǁj=====
+// g_blocks Ɠт̃rbgBĂubN͕`EeE蔻̌ɏoȂB
+// 1 Ƃ g_disabledCount == 0 Ŕ育Ɣ΂
+namespace
+{
+    std::vector<uint64_t> g_disabledBits;
+    int g_disabledCount = 0;
+
+    inline bool IsDisabled(int index)
+    {
+        return g_disabledCount != 0 && ((g_disabledBits[(size_t)index >> 6] >> (index & 63)) & 1u) != 0;
+    }
+
+    void DisabledResize(size_t n)
+    {
+        g_disabledBits.resize((n + 63) >> 6, 0);
+    }
+
+    // SLɖ߂iXe[Ŵ蒼pBrbg 0 Ŗ߂邾j
+    void DisabledReset()
+    {
+        if (g_disabledCount == 0) return;
+        std::fill(g_disabledBits.begin(), g_disabledBits.end(), 0ull);
+        g_disabledCount = 0;
+    }
+
+    void DisabledClear()
+    {
+        g_disabledBits.clear();
+        g_disabledCount = 0;
+    }
+
+    inline void DisabledSetBit(int index, bool disabled)
+    {
+        uint64_t& w = g_disabledBits[(size_t)index >> 6];
+        const uint64_t bit = 1ull << (index & 63);
+        if (disabled) w |= bit; else w &= ~bit;
+    }
+
+    // ilastj̈ index ɈڂĖiStage01_Remove pj
+    void DisabledRemoveSwap(int index, int last)
+    {
+        if (g_disabledCount != 0)
+        {
+            const bool removed = IsDisabled(index);
+            const bool moved = IsDisabled(last);
+            if (removed) --g_disabledCount;
+            DisabledSetBit(last, false);
+            if (index != last) DisabledSetBit(index, moved);
+        }
+        DisabledResize((size_t)last);
+    }
+}
+
+// ===== ubÑnhiXbg}bvj=====
+// g_blocks ͋l߂܂܁i`Ẽ[v͘A܂܁jɂāAƂ͖ƓւB
+// ̑CfbNX͕ς̂ŁAQƂ̓Xbgԍ{̃nhɂB
+// Xbg͏邽тɐオiނ̂ŁAÂnhʂ̃ubNwƂ͂Ȃ
+namespace
+{
+    std::vector<unsigned int> g_slotGeneration;  // XbgƂ̐i0 ͎gȂj
+    std::vector<int> g_slotDense;                // Xbg  g_blocks ̈ʒui󂫂 -1j
+    std::vector<unsigned int> g_denseSlot;       // g_blocks ̈ʒu  Xbg
+    std::vector<unsigned int> g_freeSlots;       // 󂫃Xbgi납gj
+
+    unsigned int SlotAlloc(int dense)
+    {
+        unsigned int slot;
+        if (!g_freeSlots.empty())
+        {
+            slot = g_freeSlots.back();
+            g_freeSlots.pop_back();
+        }
+        else
+        {
+            slot = (unsigned int)g_slotGeneration.size();
+            g_slotGeneration.push_back(1);
+            g_slotDense.push_back(-1);
+        }
+        g_slotDense[slot] = dense;
+        if ((int)g_denseSlot.size() <= dense) g_denseSlot.resize((size_t)dense + 1);
+        g_denseSlot[dense] = slot;
+        return slot;
+    }
+
+    void SlotRelease(unsigned int slot)
+    {
+        g_slotDense[slot] = -1;
+        if (++g_slotGeneration[slot] == 0) g_slotGeneration[slot] = 1;
+        g_freeSlots.push_back(slot);
+    }
+
+    // ilastj̃ubN index ɈڂƂɂ index ̃XbgԂ
+    void SlotRemoveSwap(int index, int last)
+    {
+        SlotRelease(g_denseSlot[index]);
+        if (index != last)
+        {
+            const unsigned int moved = g_denseSlot[last];
+            g_denseSlot[index] = moved;
+            g_slotDense[moved] = index;
+        }
+        g_denseSlot.pop_back();
+    }
+
+    // S󂫂ɂB͎ĉŁAÕXe[W̃nh͑SɂȂB
+    // ̃[hŃXbg 0, 1, 2... ̏Ɏg悤A󂫂͑傫ԍς
+    void SlotClear()
+    {
+        for (size_t slot = 0; slot < g_slotDense.size(); ++slot)
+        {
+            if (g_slotDense[slot] < 0) continue;
+            g_slotDense[slot] = -1;
+            if (++g_slotGeneration[slot] == 0) g_slotGeneration[slot] = 1;
+        }
+        g_freeSlots.resize(g_slotDense.size());
+        for (size_t k = 0; k < g_freeSlots.size(); ++k)
+            g_freeSlots[k] = (unsigned int)(g_freeSlots.size() - 1 - k);
+        g_denseSlot.clear();
+    }
+
+    inline int SlotResolve(StageBlockHandle h)
+    {
+        if (h.slot >= g_slotDense.size() || g_slotGeneration[h.slot] != h.generation) return -1;
+        return g_slotDense[h.slot];
+    }
+}
+
+// ===== u[htF[YilObh{ubNp̓IAABBc[j=====
+// aabb Zɓo^ĂA₢킹͎ӃZB
+// t[ubN̓Z̕tւd̂ŁAObhOăc[ɓB
+// g_blocks ̕т g_gridRanges / g_gridMoving / g_gridProxy ͏ɓEԂɂĂB
+namespace
+{
+    constexpr float STAGE_GRID_CELL = 4.0f;       // Z1ӁiubNj
+    constexpr int   STAGE_GRID_MAX_CELLS = 64;    // 葽̃Zɂ܂鋐ubN͏펞胊Xg
+    constexpr int   STAGE_GRID_QUERY_MAX_CELLS = 4096; // ₢킹LȂS̕
+    constexpr float STAGE_TREE_MARGIN = 0.2f;     // ubN̑点i͈̔͂̈ړȂc[͑gݑւȂj
+
+    struct StageGridRange
+    {
+        int x0 = 0, y0 = 0, z0 = 0;
+        int x1 = -1, y1 = -1, z1 = -1;
+        bool large = false;
+    };
+
+    std::unordered_map<unsigned long long, std::vector<int>> g_gridCells;
+    std::vector<StageGridRange> g_gridRanges;
+    std::vector<int> g_gridLarge;
+
+    // ubN
+    DynamicAABBTree g_movingTree(STAGE_TREE_MARGIN);
+    std::vector<unsigned char> g_gridMoving; // 1 = ubN
+    std::vector<int> g_gridProxy;            // c[ɓĂ proxyAObhȂ -1
+
+    // dpiZ܂ubN͕oĂj
+    std::vector<unsigned int> g_gridMark;
+    unsigned int g_gridStamp = 0;
+
+    // ₢킹 func 炳ɖ₢킹ĂȂ悤A[Ƃɍƃobt@
+    constexpr int STAGE_QUERY_DEPTH = 4;
+    std::vector<int> g_queryScratch[STAGE_QUERY_DEPTH];
+    int g_queryDepth = 0;
+
+    inline int GridCoord(float v)
+    {
+        // L[121bitȂ̂ł͈̔͂Ɏ߂
+        constexpr float LIMIT = (float)(1 << 20) - 1.0f;
+        const float c = std::floor(v / STAGE_GRID_CELL);
+        return (int)std::clamp(c, -LIMIT, LIMIT);
+    }
+
+    inline unsigned long long GridKey(int x, int y, int z)
+    {
+        constexpr unsigned long long MASK = (1ull << 21) - 1;
+        return ((unsigned long long)(x & MASK))
+            | ((unsigned long long)(y & MASK) << 21)
+            | ((unsigned long long)(z & MASK) << 42);
+    }
+
+    inline bool IsTouchAABB(const AABB& a, const AABB& b)
+    {
+        return a.min.x <= b.max.x && a.max.x >= b.min.x
+            && a.min.y <= b.max.y && a.max.y >= b.min.y
+            && a.min.z <= b.max.z && a.max.z >= b.min.z;
+    }
+
+    inline bool IsFiniteAABB(const AABB& a)
+    {
+        return std::isfinite(a.min.x) && std::isfinite(a.min.y) && std::isfinite(a.min.z)
+            && std::isfinite(a.max.x) && std::isfinite(a.max.y) && std::isfinite(a.max.z);
+    }
+
+    StageGridRange GridRangeOf(const AABB& a)
+    {
+        StageGridRange r{};
+
+        // BakeiFLT_MAX ̂܂܁jȂǂ͋刵ɂĎ肱ڂȂ
+        if (!IsFiniteAABB(a))
+        {
+            r.large = true;
+            return r;
+        }
+
+        r.x0 = GridCoord(a.min.x); r.x1 = GridCoord(a.max.x);
+        r.y0 = GridCoord(a.min.y); r.y1 = GridCoord(a.max.y);
+        r.z0 = GridCoord(a.min.z); r.z1 = GridCoord(a.max.z);
+
+        const long long cells =
+            (long long)(r.x1 - r.x0 + 1) * (long long)(r.y1 - r.y0 + 1) * (long long)(r.z1 - r.z0 + 1);
+        r.large = (cells > STAGE_GRID_MAX_CELLS);
+        return r;
+    }
+
+    inline bool SameRange(const StageGridRange& a, const StageGridRange& b)
+    {
+        if (a.large || b.large) return a.large == b.large;
+        return a.x0 == b.x0 && a.y0 == b.y0 && a.z0 == b.z0
+            && a.x1 == b.x1 && a.y1 == b.y1 && a.z1 == b.z1;
+    }
+
+    void GridLink(int index, const StageGridRange& r)
+    {
+        if (r.large)
+        {
+            g_gridLarge.push_back(index);
+            return;
+        }
+
+        for (int z = r.z0; z <= r.z1; ++z)
+            for (int y = r.y0; y <= r.y1; ++y)
+                for (int x = r.x0; x <= r.x1; ++x)
+                    g_gridCells[GridKey(x, y, z)].push_back(index);
+    }
+
+    void EraseIndex(std::vector<int>& v, int index)
+    {
+        for (size_t k = 0; k < v.size(); ++k)
+        {
+            if (v[k] != index) continue;
+            v[k] = v.back();
+            v.pop_back();
+            return;
+        }
+    }
+
+    void GridUnlink(int index, const StageGridRange& r)
+    {
+        if (r.large)
+        {
+            EraseIndex(g_gridLarge, index);
+            return;
+        }
+
+        for (int z = r.z0; z <= r.z1; ++z)
+            for (int y = r.y0; y <= r.y1; ++y)
+                for (int x = r.x0; x <= r.x1; ++x)
+                {
+                    auto it = g_gridCells.find(GridKey(x, y, z));
+                    if (it == g_gridCells.end()) continue;
+                    EraseIndex(it->second, index);
+                    if (it->second.empty()) g_gridCells.erase(it);
+                }
+    }
+
+    void GridClear()
+    {
+        g_gridCells.clear();
+        g_gridRanges.clear();
+        g_gridLarge.clear();
+        g_gridMark.clear();
+        g_gridStamp = 0;
+        g_movingTree.Clear();
+        g_gridMoving.clear();
+        g_gridProxy.clear();
+    }
+
+    // Obhɓo^ic[ɓĂ甲j
+    void GridAttachStatic(int index)
+    {
+        int& proxy = g_gridProxy[index];
+        if (proxy >= 0)
+        {
+            g_movingTree.DestroyProxy(proxy);
+            proxy = -1;
+        }
+        g_gridRanges[index] = GridRangeOf(g_blocks[index].aabb);
+        GridLink(index, g_gridRanges[index]);
+    }
+
+    // c[ɓo^iObhɓĂ甲jBBake O aabb ȂObhɎc
+    void GridAttachMoving(int index)
+    {
+        if (g_gridProxy[index] >= 0) return;
+        if (!IsFiniteAABB(g_blocks[index].aabb)) return;
+
+        GridUnlink(index, g_gridRanges[index]);
+        g_gridRanges[index] = StageGridRange{};
+        g_gridProxy[index] = g_movingTree.CreateProxy(g_blocks[index].aabb, index);
+    }
+
+    // ɒǉꂽubNo^
+    void GridPush(int index, bool moving = false)
+    {
+        g_gridRanges.emplace_back();
+        g_gridMark.push_back(0);
+        g_gridMoving.push_back(moving ? 1 : 0);
+        g_gridProxy.push_back(-1);
 
-        XMStoreFloat4x4(&b.world, W);
+        if (moving && IsFiniteAABB(g_blocks[index].aabb))
+            GridAttachMoving(index);
+        else
+            GridAttachStatic(index);
+    }
+
+    // Bake ubN̓o^XViZςȂΉȂj
+    void GridUpdate(int index, const XMFLOAT3& displacement = { 0,0,0 })
+    {
+        if (index < 0 || index >= (int)g_gridRanges.size()) return;
+
+        if (g_gridMoving[index])
+        {
+            const int proxy = g_gridProxy[index];
+            if (proxy >= 0)
+            {
+                if (IsFiniteAABB(g_blocks[index].aabb))
+                {
+                    g_movingTree.MoveProxy(proxy, g_blocks[index].aabb, displacement);
+                    return;
+                }
+                //  aabb ɂȂObh̋刵ɖ߂
+                g_movingTree.DestroyProxy(proxy);
+                g_gridProxy[index] = -1;
+                g_gridRanges[index] = StageGridRange{};
+                GridAttachStatic(index);
+                return;
+            }
+            if (IsFiniteAABB(g_blocks[index].aabb))
+            {
+                GridAttachMoving(index);
+                return;
+            }
+        }
+
+        const StageGridRange r = GridRangeOf(g_blocks[index].aabb);
+        StageGridRange& cur = g_gridRanges[index];
+        if (SameRange(cur, r)) return;
+
+        GridUnlink(index, cur);
+        cur = r;
+        GridLink(index, cur);
+    }
+
+    void GridSetMoving(int index, bool moving)
+    {
+        if (index < 0 || index >= (int)g_gridMoving.size()) return;
+        if ((g_gridMoving[index] != 0) == moving) return;
+
+        g_gridMoving[index] = moving ? 1 : 0;
+        if (moving)
+        {
+            GridAttachMoving(index);
+        }
+        else if (g_gridProxy[index] >= 0)
+        {
+            GridAttachStatic(index);
+        }
+    }
 
-        XMFLOAT3 mn{ +FLT_MAX, +FLT_MAX, +FLT_MAX };
-        XMFLOAT3 mx{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    // index ̃ubNOāAilastj̃ubN̓o^ index ɕtւiStage01_Remove pjB
+    // Z̕tւ 2 ubNŁAŜ̍蒼͂Ȃ
+    void GridRemoveSwap(int index, int last)
+    {
+        if (g_gridProxy[index] >= 0) g_movingTree.DestroyProxy(g_gridProxy[index]);
+        else GridUnlink(index, g_gridRanges[index]);
 
-        for (auto& c : kCorners)
+        if (index != last)
         {
-            XMVECTOR p = XMVector3TransformCoord(XMLoadFloat3(&c), W);
-            XMFLOAT3 wp{};
-            XMStoreFloat3(&wp, p);
+            if (g_gridProxy[last] >= 0)
+            {
+                g_movingTree.SetUserData(g_gridProxy[last], index);
+            }
+            else
+            {
+                GridUnlink(last, g_gridRanges[last]);
+                GridLink(index, g_gridRanges[last]);
+            }
+            g_gridRanges[index] = g_gridRanges[last];
+            g_gridMoving[index] = g_gridMoving[last];
+            g_gridProxy[index] = g_gridProxy[last];
+        }
 
-            mn.x = (wp.x < mn.x) ? wp.x : mn.x;
-            mn.y = (wp.y < mn.y) ? wp.y : mn.y;
-            mn.z = (wp.z < mn.z) ? wp.z : mn.z;
+        g_gridRanges.pop_back();
+        g_gridMoving.pop_back();
+        g_gridProxy.pop_back();
+        g_gridMark.pop_back();
+    }
 
-            mx.x = (wp.x > mx.x) ? wp.x : mx.x;
-            mx.y = (wp.y > mx.y) ? wp.y : mx.y;
-            mx.z = (wp.z > mx.z) ? wp.z : mx.z;
+    // ǂ͎̈c܂܍蒼iCfbNXꂽȂǁj
+    void GridRebuild()
+    {
+        std::vector<unsigned char> moving;
+        moving.swap(g_gridMoving);
+        moving.resize(g_blocks.size(), 0);
+
+        GridClear();
+        g_gridRanges.reserve(g_blocks.size());
+        g_gridMark.reserve(g_blocks.size());
+        g_gridMoving.reserve(g_blocks.size());
+        g_gridProxy.reserve(g_blocks.size());
+        for (int i = 0; i < (int)g_blocks.size(); ++i)
+            GridPush(i, moving[i] != 0);
+    }
+
+    // aabb ɐڂubN out ɏW߂
+    void GridCollect(const AABB& aabb, std::vector<int>& out)
+    {
+        out.clear();
+
+        const StageGridRange q = GridRangeOf(aabb);
+        const bool finite = (q.x1 >= q.x0); // Ll̂Ƃ͔͈͂ŕԂĂ
+        const long long cells = !finite ? (long long)STAGE_GRID_QUERY_MAX_CELLS + 1
+            : (long long)(q.x1 - q.x0 + 1) * (q.y1 - q.y0 + 1) * (q.z1 - q.z0 + 1);
+
+        if (cells > STAGE_GRID_QUERY_MAX_CELLS || cells > (long long)g_blocks.size())
+        {
+            // L₢킹̓Z񂷂Siʂ͂ƂƏj
+            for (int i = 0; i < (int)g_blocks.size(); ++i)
+                if (!IsDisabled(i) && IsTouchAABB(aabb, g_blocks[i].aabb)) out.push_back(i);
+            return;
         }
 
-        b.aabb.min = mn;
-        b.aabb.max = mx;
+        if (++g_gridStamp == 0)
+        {
+            std::fill(g_gridMark.begin(), g_gridMark.end(), 0u);
+            g_gridStamp = 1;
+        }
+
+        auto consider = [&](int i)
+            {
+                if (g_gridMark[i] == g_gridStamp) return;
+                g_gridMark[i] = g_gridStamp;
+                if (!IsDisabled(i) && IsTouchAABB(aabb, g_blocks[i].aabb)) out.push_back(i);
+            };
+
+        for (int z = q.z0; z <= q.z1; ++z)
+            for (int y = q.y0; y <= q.y1; ++y)
+                for (int x = q.x0; x <= q.x1; ++x)
+                {
+                    auto it = g_gridCells.find(GridKey(x, y, z));
+                    if (it == g_gridCells.end()) continue;
+                    for (int i : it->second) consider(i);
+                }
+
+        for (int i : g_gridLarge) consider(i);
+
+        g_movingTree.Query(aabb, [&](int i)
+            {
+                consider(i);
+                return true;
+            });
+
+        std::sort(out.begin(), out.end());
+    }
+}
+
+// ===== 蔻p SoA r[ =====
+// 胋[v StageBlock ŜׂȂ悤 aabb Ƃ̔zɎʂĂB
+// g_blocks ƓEԁBBake ⓮󂪕ς ColSet ŎʂB
+namespace
+{
+    std::vector<float> g_colMinX, g_colMinY, g_colMinZ;
+    std::vector<float> g_colMaxX, g_colMaxY, g_colMaxZ;
+    std::vector<int> g_colKind;
+    std::vector<unsigned char> g_colFlags;
+
+    // WߗpiStage01_OverlapsAnyj
+    std::vector<int> g_colCandidates;
+
+    void ColResize(size_t n)
+    {
+        g_colMinX.resize(n); g_colMinY.resize(n); g_colMinZ.resize(n);
+        g_colMaxX.resize(n); g_colMaxY.resize(n); g_colMaxZ.resize(n);
+        g_colKind.resize(n);
+        g_colFlags.resize(n);
+    }
+
+    void ColSet(int i)
+    {
+        if (i < 0 || i >= (int)g_blocks.size()) return;
+        if (i >= (int)g_colKind.size()) ColResize(g_blocks.size());
+
+        const StageBlock& b = g_blocks[i];
+        g_colMinX[i] = b.aabb.min.x; g_colMinY[i] = b.aabb.min.y; g_colMinZ[i] = b.aabb.min.z;
+        g_colMaxX[i] = b.aabb.max.x; g_colMaxY[i] = b.aabb.max.y; g_colMaxZ[i] = b.aabb.max.z;
+        g_colKind[i] = b.kind;
+
+        unsigned char flags = 0;
+        if (i < (int)g_gridMoving.size() && g_gridMoving[i]) flags |= STAGE_COL_MOVING;
+        g_colFlags[i] = flags;
+    }
+
+    void ColSyncAll()
+    {
+        ColResize(g_blocks.size());
+        for (int i = 0; i < (int)g_blocks.size(); ++i) ColSet(i);
+    }
+
+    void ColClear()
+    {
+        ColResize(0);
+    }
+}
+
+// ===== Bake ̒x =====
+// AddObjectTransform ̓ItZbg𑫂Ĉt邾ɂāA
+// ̕tubN Stage01_FlushBake ł܂Ƃ߂ Bake iBakeBatch ɓnjB
+// ₢킹E`̓łc肪ΐ Flush ̂ŁAĂԑ͋CɂȂĂ悢B
+namespace
+{
+    std::vector<unsigned char> g_bakeDirty;  // g_blocks Ɠ
+    std::vector<int> g_bakeList;             // ̕tubNidȂj
+    std::vector<XMFLOAT3> g_bakeMove;        // O Bake ̈ړʁic[̗\pj
+
+    void BakeDirtyResize(size_t n)
+    {
+        g_bakeDirty.resize(n, 0);
+        g_bakeMove.resize(n, XMFLOAT3{ 0,0,0 });
+    }
+
+    void BakeDirtyClear()
+    {
+        g_bakeDirty.clear();
+        g_bakeMove.clear();
+        g_bakeList.clear();
+    }
+
+    void MarkBakeDirty(int index, const XMFLOAT3& displacement)
+    {
+        if (index >= (int)g_bakeDirty.size()) BakeDirtyResize(g_blocks.size());
+
+        XMFLOAT3& m = g_bakeMove[index];
+        m.x += displacement.x; m.y += displacement.y; m.z += displacement.z;
+        if (g_bakeDirty[index]) return;
+        g_bakeDirty[index] = 1;
+        g_bakeList.push_back(index);
+    }
+
+    // SubN Bake ăObhESoA 蒼i[hȂǁj
+    void BakeAll()
+    {
+        BakeBlocks(g_blocks, g_offsets.data());
+
+        BakeDirtyClear();
+        BakeDirtyResize(g_blocks.size());
+        DisabledResize(g_blocks.size());
+        GridRebuild();
+        ColSyncAll();
+    }
+
+    inline void FlushBakeIfDirty()
+    {
+        if (!g_bakeList.empty()) Stage01_FlushBake();
+    }
+}
+
+// ===== t[Ƃ̈ړʁij =====
+// AddObjectTransform őʒu̗ʂ߂āAStage01_Update Łũt[ɓʁvƂĊm肷B
+// ĂubN̈ړʂvC[̂܂ܑ̂ŁATȂĂ悢
+namespace
+{
+    std::vector<XMFLOAT3> g_movePending;    // Stage01_Update Oɂ܂
+    std::vector<int> g_movePendingList;
+    std::vector<unsigned char> g_movePendingMark;   // g_movePendingList ɓĂ邩
+    std::vector<XMFLOAT3> g_moveFrame;      // O Stage01_Update Ŋm肵
+    std::vector<int> g_moveFrameList;
+
+    void FrameMoveClear()
+    {
+        g_movePending.clear(); g_movePendingList.clear(); g_movePendingMark.clear();
+        g_moveFrame.clear(); g_moveFrameList.clear();
+    }
+
+    void FrameMoveAdd(int index, const XMFLOAT3& d)
+    {
+        if (d.x == 0.0f && d.y == 0.0f && d.z == 0.0f) return;
+        if (index >= (int)g_movePending.size())
+        {
+            g_movePending.resize(g_blocks.size(), XMFLOAT3{ 0,0,0 });
+            g_movePendingMark.resize(g_blocks.size(), 0);
+            g_moveFrame.resize(g_blocks.size(), XMFLOAT3{ 0,0,0 });
+        }
+
+        if (!g_movePendingMark[index])
+        {
+            g_movePendingMark[index] = 1;
+            g_movePendingList.push_back(index);
+        }
+        XMFLOAT3& m = g_movePending[index];
+        m.x += d.x; m.y += d.y; m.z += d.z;
+    }
+
+    void FrameMoveCommit()
+    {
+        for (int i : g_moveFrameList) g_moveFrame[i] = XMFLOAT3{ 0,0,0 };
+        g_moveFrameList.clear();
+
+        for (int i : g_movePendingList)
+        {
+            g_moveFrame[i] = g_movePending[i];
+            g_movePending[i] = XMFLOAT3{ 0,0,0 };
+            g_movePendingMark[i] = 0;
+        }
+        g_moveFrameList.swap(g_movePendingList);
     }
 }
 
@@ -196,9 +943,10 @@ const char* Stage01_GetTexSlotName(int slot)
 void Stage01_SetCurrentJsonPath(const char* filepath)
 {
     if (!filepath || !filepath[0]) return;
+    if (filepath == g_stageJsonPath) return; // Stage01_LoadJson(Stage01_GetCurrentJsonPath()) ŎgɎʂƏ
 
-    // ͎ '\0' ɂȂB؂l߂B
-    strncpy_s(g_stageJsonPath, sizeof(g_stageJsonPath), filepath, _TRUNCATE);
+    // ͎ '\0' ɂȂB؂l߂Bistrncpy_s  MSVC pȂ̂ŎgȂj
+    std::snprintf(g_stageJsonPath, sizeof(g_stageJsonPath), "%s", filepath);
 }
 
 const char* Stage01_GetCurrentJsonPath()
@@ -258,36 +1006,27 @@ void Stage01_Initialize(const char* jsonPath)
     Map_Initialize();
 
     g_blocks.clear();
+    g_nextBlockId = 0;
     g_offsets.clear();
     g_blocks.reserve(4096);
     g_offsets.reserve(4096);
+    GridClear();
+    ColClear();
+    BakeDirtyClear();
+    FrameMoveClear();
+    DisabledClear();
+    SlotClear();
+    StageMotion_Clear();
 
     std::fill(std::begin(g_tex), std::end(g_tex), -1);
 
 
 /*==============================================*/
-    g_tex[TEX_BRICK] = Texture_Load(L"texture/rengaBlock.png");
-    g_tex[TEX_RED] = Texture_Load(L"texture/red.png");
-    g_tex[TEX_WHITE] = Texture_Load(L"white.png");
-
-    g_tex[TEX_STONE0] = Texture_Load(L"texture/stone0.png"); g_tex[TEX_STONE1] = Texture_Load(L"texture/stone1.png");
-    g_tex[TEX_STONE2] = Texture_Load(L"texture/stone2.png"); g_tex[TEX_STONE3] = Texture_Load(L"texture/stone3.png");
-    g_tex[TEX_STONE4] = Texture_Load(L"texture/stone4.png"); g_tex[TEX_STONE5] = Texture_Load(L"texture/stone5.png");
-    g_tex[TEX_STONE6] = Texture_Load(L"texture/stone6.png"); g_tex[TEX_STONE7] = Texture_Load(L"texture/stone7.png");
-    g_tex[TEX_STONE8] = Texture_Load(L"texture/stone8.jpg"); g_tex[TEX_STONE9] = Texture_Load(L"texture/stone9.jpg");
-
-    g_tex[TEX_WOOD0] = Texture_Load(L"texture/wood0.png"); g_tex[TEX_WOOD1] = Texture_Load(L"texture/wood1.png");
-    g_tex[TEX_WOOD2] = Texture_Load(L"texture/wood2.png"); g_tex[TEX_WOOD3] = Texture_Load(L"texture/wood3.png");
+    for (const StageTexFile& t : k_stageTexFiles)
+        g_tex[t.slot] = Texture_Load(t.path);
 
-    g_tex[TEX_V0] = Texture_Load(L"texture/v0.png"); g_tex[TEX_V1] = Texture_Load(L"texture/v1.png");
-    g_tex[TEX_V2] = Texture_Load(L"texture/v2.png"); g_tex[TEX_V3] = Texture_Load(L"texture/v3.png");
-    g_tex[TEX_V4] = Texture_Load(L"texture/v4.png"); g_tex[TEX_V5] = Texture_Load(L"texture/v5.png");
-    g_tex[TEX_V6] = Texture_Load(L"texture/v6.jpg"); g_tex[TEX_V7] = Texture_Load(L"texture/v7.png");
-
-    g_tex[TEX_CHECK0] = Texture_Load(L"texture/check0.png"); g_tex[TEX_CHECK1] = Texture_Load(L"texture/check1.jpg");
-
-    // ܂͎w json ǂށi: stage02.jsonj
-    if (Stage01_LoadJson(Stage01_GetCurrentJsonPath()))
+    // ܂͎w json ǂށi: stage02.jsonBV .bin ΂j
+    if (Stage01_LoadStage(Stage01_GetCurrentJsonPath()))
         return;
 
     // stage01.json ƂA]̏zu
@@ -321,24 +1060,81 @@ void Stage01_Finalize()
     Map_Finalize();
 
     g_blocks.clear();
+    g_nextBlockId = 0;
     g_offsets.clear();
+    GridClear();
+    ColClear();
+    BakeDirtyClear();
+    FrameMoveClear();
+    DisabledClear();
+    SlotClear();
+    StageMotion_Clear();
 }
 
 void Stage01_Update(double elapsedTime)
 {
     Cube_Update(elapsedTime);
+
+    // ̃t[ɓubN܂Ƃ߂ Bake
+    Stage01_FlushBake();
+    FrameMoveCommit();
 }
 
-void Stage01_Draw()
+void Stage01_FlushBake()
 {
-    for (const auto& b : g_blocks)
+    if (g_bakeList.empty()) return;
+
+    BakeBatch(g_blocks.data(), g_offsets.data(), g_bakeList.data(), (int)g_bakeList.size());
+
+    // o^̍XV 1 {̃XbhŁiObhEc[͋Lj
+    for (int i : g_bakeList)
+    {
+        GridUpdate(i, g_bakeMove[i]);
+        ColSet(i);
+        g_bakeDirty[i] = 0;
+        g_bakeMove[i] = XMFLOAT3{ 0,0,0 };
+    }
+    g_bakeList.clear();
+}
+
+// `pBakeς݂worldlߒi(kind, texId) Ƃ̂܂Ƃ߂ stage_cube j
+// view LȂ炻̃r[ŌȂubN͋l߂Ȃ
+static std::vector<CubeInstance> g_drawInstances;
+static std::vector<uint8_t> g_drawVisible;
+
+static void BuildDrawInstances(CullView view)
+{
+    FlushBakeIfDirty();
+
+    const size_t n = g_blocks.size();
+    g_drawVisible.resize(n);
+    if (Culling_IsViewActive(view))
+    {
+        // 蔻p SoA ̂܂܎g
+        Culling_TestView(view, Stage01_GetCollisionSoA().bounds, g_drawVisible.data());
+    }
+    else
     {
-        CubeBlock cb{};
-        cb.kind = b.kind;
-        cb.texId = b.texId;
-        cb.world = b.world;// Bakeς݂world̂܂܎g
-        Cube_DrawBlock(cb);
+        std::fill(g_drawVisible.begin(), g_drawVisible.end(), (uint8_t)1);
     }
+
+    g_drawInstances.clear();
+    g_drawInstances.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!g_drawVisible[i] || IsDisabled((int)i)) continue;
+        CubeInstance in;
+        in.kind = g_blocks[i].kind;
+        in.texId = g_blocks[i].texId;
+        in.world = g_blocks[i].world;
+        g_drawInstances.push_back(in);
+    }
+}
+
+void Stage01_Draw()
+{
+    BuildDrawInstances(CULL_VIEW_CAMERA);
+    Cube_DrawInstances(g_drawInstances.data(), (int)g_drawInstances.size());
     /*
     for (const auto& b : g_blocks)
     {
@@ -347,16 +1143,16 @@ void Stage01_Draw()
     }*/
 }
 
+void Stage01_Submit()
+{
+    BuildDrawInstances(CULL_VIEW_CAMERA);
+    Cube_SubmitInstances(g_drawInstances.data(), (int)g_drawInstances.size());
+}
+
 void Stage01_DepthDraw()
 {
-    for (const auto& b : g_blocks)
-    {
-        CubeBlock cb{};
-        cb.kind = b.kind;
-        cb.texId = b.texId;
-        cb.world = b.world;
-        Cube_DepthDrawBlock(cb);
-    }
+    BuildDrawInstances(CULL_VIEW_SHADOW);
+    Cube_DepthDrawInstances(g_drawInstances.data(), (int)g_drawInstances.size());
     /*
     for (const auto& b : g_blocks)
     {
@@ -370,53 +1166,116 @@ int Stage01_GetCount() { return (int)g_blocks.size(); }
 
 const StageBlock* Stage01_Get(int i)
 {
+    FlushBakeIfDirty();
     if (i < 0 || i >= (int)g_blocks.size()) return nullptr;
     return &g_blocks[i];
 }
 
 StageBlock* Stage01_GetMutable(int i)
 {
+    FlushBakeIfDirty();
     if (i < 0 || i >= (int)g_blocks.size()) return nullptr;
     return &g_blocks[i];
 }
 
+const StageBlock* Stage01_Get(StageBlockHandle h) { return Stage01_Get(SlotResolve(h)); }
+StageBlock* Stage01_GetMutable(StageBlockHandle h) { return Stage01_GetMutable(SlotResolve(h)); }
+
+StageBlockHandle Stage01_GetHandle(int i)
+{
+    if (i < 0 || i >= (int)g_blocks.size()) return StageBlockHandle{};
+    const unsigned int slot = g_denseSlot[i];
+    return StageBlockHandle{ slot, g_slotGeneration[slot] };
+}
+
+int Stage01_GetIndex(StageBlockHandle h) { return SlotResolve(h); }
+
+bool Stage01_IsValid(StageBlockHandle h) { return SlotResolve(h) >= 0; }
+
 void Stage01_RebuildObject(int i)
 {
     if (i < 0 || i >= (int)g_blocks.size()) return;
     ApplyTex(g_blocks[i]);
-    Bake(g_blocks[i], g_offsets[i]);
+    MarkBakeDirty(i, XMFLOAT3{ 0,0,0 });
+    Stage01_FlushBake();
 }
 
 void Stage01_RebuildAll()
 {
-    for (size_t i = 0; i < g_blocks.size(); ++i) {
-        Bake(g_blocks[i], g_offsets[i]);
+    for (size_t i = 0; i < g_blocks.size(); ++i)
         ApplyTex(g_blocks[i]);
+    BakeAll();
+}
+
+StageBlockHandle Stage01_FindBlockById(int id)
+{
+    if (id < 0) return StageBlockHandle{};
+    for (int i = 0; i < (int)g_blocks.size(); ++i)
+    {
+        if (g_blocks[i].id == id) return Stage01_GetHandle(i);
     }
+    return StageBlockHandle{};
 }
 
-int Stage01_Add(const StageBlock& b, bool bake)
+StageBlockHandle Stage01_Add(const StageBlock& b, bool bake)
 {
+    const unsigned int slot = SlotAlloc((int)g_blocks.size());
     g_blocks.push_back(b);
+    g_blocks.back().id = g_nextBlockId++;   // Ă id ͐Vt
     g_offsets.emplace_back();
     if (bake) {
         ApplyTex(g_blocks.back());
-        Bake(g_blocks.back(), g_offsets.back());
+        Bake((int)g_blocks.size() - 1);
     }
-    return (int)g_blocks.size() - 1;
+    GridPush((int)g_blocks.size() - 1);
+    ColSet((int)g_blocks.size() - 1);
+    BakeDirtyResize(g_blocks.size());
+    DisabledResize(g_blocks.size());
+    return StageBlockHandle{ slot, g_slotGeneration[slot] };
 }
 
 void Stage01_Remove(int i)
 {
     if (i < 0 || i >= (int)g_blocks.size()) return;
-    g_blocks.erase(g_blocks.begin() + i);
-    g_offsets.erase(g_offsets.begin() + i);
+    Stage01_FlushBake(); // ̕tCfbNXւO
+    FrameMoveClear(); // ҏWȂ̂ŁA܂Ăړʂ͎̂Ă
+
+    // ̃ubN i Ɉڂċl߂iEc[ proxyËꏏɁj
+    const int last = (int)g_blocks.size() - 1;
+    GridRemoveSwap(i, last);
+    DisabledRemoveSwap(i, last);
+    SlotRemoveSwap(i, last);
+    if (i != last)
+    {
+        g_blocks[i] = g_blocks[last];
+        g_offsets[i] = g_offsets[last];
+    }
+    g_blocks.pop_back();
+    g_offsets.pop_back();
+    g_bakeDirty.resize(g_blocks.size());
+    g_bakeMove.resize(g_blocks.size());
+
+    if (i != last) ColSet(i);
+    ColResize(g_blocks.size());
+}
+
+void Stage01_Remove(StageBlockHandle h)
+{
+    Stage01_Remove(SlotResolve(h));
 }
 
 void Stage01_Clear()
 {
     g_blocks.clear();
+    g_nextBlockId = 0;
     g_offsets.clear();
+    GridClear();
+    ColClear();
+    BakeDirtyClear();
+    FrameMoveClear();
+    DisabledClear();
+    SlotClear();
+    StageMotion_Clear();
 }
 
 bool Stage01_AddObjectTransform(int index,
@@ -436,144 +1295,597 @@ bool Stage01_AddObjectTransform(int index,
     offset.rotation.x += rotationDelta.x;
     offset.rotation.y += rotationDelta.y;
     offset.rotation.z += rotationDelta.z;
-    Stage01_RebuildObject(index);
+
+    // xłꂽubN͈Ȍc[ŊǗi aabb ŐɓĂj
+    ApplyTex(g_blocks[index]);
+    if (index < (int)g_gridMoving.size() && !g_gridMoving[index])
+        GridSetMoving(index, true);
+    MarkBakeDirty(index, positionDelta);
+    FrameMoveAdd(index, positionDelta);
     return true;
 }
 
+XMFLOAT3 Stage01_GetFrameMove(int index)
+{
+    if (index < 0 || index >= (int)g_moveFrame.size()) return XMFLOAT3{ 0,0,0 };
+    return g_moveFrame[index];
+}
 
-// ===== JSON Save/Load =====
+void Stage01_SetBlockMoving(int index, bool moving)
+{
+    FlushBakeIfDirty();
+    GridSetMoving(index, moving);
+    ColSet(index);
+}
+
+bool Stage01_IsBlockMoving(int index)
+{
+    if (index < 0 || index >= (int)g_gridMoving.size()) return false;
+    return g_gridMoving[index] != 0;
+}
+
+void Stage01_SetBlockEnabled(int index, bool enabled)
+{
+    if (index < 0 || index >= (int)g_blocks.size()) return;
+    DisabledResize(g_blocks.size());
+
+    uint64_t& w = g_disabledBits[(size_t)index >> 6];
+    const uint64_t bit = 1ull << (index & 63);
+    const bool disabled = (w & bit) != 0;
+    if (disabled == !enabled) return;
+
+    if (enabled) { w &= ~bit; --g_disabledCount; }
+    else         { w |= bit;  ++g_disabledCount; }
+}
+
+bool Stage01_IsBlockEnabled(int index)
+{
+    if (index < 0 || index >= (int)g_blocks.size()) return false;
+    return !IsDisabled(index);
+}
+
+void Stage01_EnableAllBlocks()
+{
+    DisabledReset();
+}
+
+void Stage01_ResetObjectTransforms()
+{
+    for (int i = 0; i < (int)g_offsets.size(); ++i)
+    {
+        StageRuntimeOffset& offset = g_offsets[i];
+        const XMFLOAT3 back{ -offset.position.x, -offset.position.y, -offset.position.z };
+        const bool moved =
+            offset.position.x != 0.0f || offset.position.y != 0.0f || offset.position.z != 0.0f ||
+            offset.size.x != 0.0f || offset.size.y != 0.0f || offset.size.z != 0.0f ||
+            offset.rotation.x != 0.0f || offset.rotation.y != 0.0f || offset.rotation.z != 0.0f;
+        if (!moved) continue;
+
+        offset = StageRuntimeOffset{};
+        MarkBakeDirty(i, back);
+    }
+
+    // ߂őɏĂvC[^΂Ȃ
+    FrameMoveClear();
+}
+
+int Stage01_QueryAABB(const AABB& aabb, Stage01QueryFunc func, void* user)
+{
+    if (!func || g_blocks.empty()) return 0;
+    FlushBakeIfDirty();
+
+    std::vector<int> overflow;
+    std::vector<int>& cand = (g_queryDepth < STAGE_QUERY_DEPTH) ? g_queryScratch[g_queryDepth] : overflow;
+    ++g_queryDepth;
+
+    GridCollect(aabb, cand);
+
+    int called = 0;
+    for (size_t k = 0; k < cand.size(); ++k)
+    {
+        const int i = cand[k];
+        if (i >= (int)g_blocks.size()) continue; // func  Remove ꂽ
+        ++called;
+        if (!func(i, g_blocks[i], user)) break;
+    }
+
+    --g_queryDepth;
+    return called;
+}
+
+StageCollisionSoA Stage01_GetCollisionSoA()
+{
+    FlushBakeIfDirty();
+
+    StageCollisionSoA soa;
+    soa.bounds.minX = g_colMinX.data(); soa.bounds.minY = g_colMinY.data(); soa.bounds.minZ = g_colMinZ.data();
+    soa.bounds.maxX = g_colMaxX.data(); soa.bounds.maxY = g_colMaxY.data(); soa.bounds.maxZ = g_colMaxZ.data();
+    soa.bounds.count = (int)g_colKind.size();
+    soa.kind = g_colKind.data();
+    soa.flags = g_colFlags.data();
+    return soa;
+}
+
+void Stage01_CollectAABB(const AABB& aabb, std::vector<int>& out)
+{
+    if (g_blocks.empty())
+    {
+        out.clear();
+        return;
+    }
+    FlushBakeIfDirty();
+    GridCollect(aabb, out);
+}
+
+bool Stage01_OverlapsAny(const AABB& aabb)
+{
+    if (g_blocks.empty()) return false;
+    FlushBakeIfDirty();
+
+    GridCollect(aabb, g_colCandidates);
+    const StageCollisionSoA soa = Stage01_GetCollisionSoA();
+    return Collision_FindFirstOverlapAABB(aabb, soa.bounds,
+        g_colCandidates.data(), 0, (int)g_colCandidates.size()) >= 0;
+}
+
+// ===== ɉ₢킹 =====
+// Z1ɋ؂āAŐԂZĂB
+// 肪 maxT k񂾂A艜̋Ԃ͌ȂB
 namespace
 {
-    static size_t FindMatchingBracket(const std::string& s, size_t openPos)
+    constexpr int STAGE_RAY_MAX_PIECES = 256; // ͋ԂL΂Ă̐Ɏ߂
+
+    // diGridCollect Ƃ͕ʂɎ̂ŁAfunc  Stage01_QueryAABB ĂłȂj
+    std::vector<unsigned int> g_rayMark;
+    unsigned int g_rayStamp = 0;
+    std::vector<int> g_rayPiece;
+
+    AABB RayPieceAABB(const XMFLOAT3& o, const XMFLOAT3& d, float t0, float t1, const XMFLOAT3& half)
+    {
+        const XMFLOAT3 a{ o.x + d.x * t0, o.y + d.y * t0, o.z + d.z * t0 };
+        const XMFLOAT3 b{ o.x + d.x * t1, o.y + d.y * t1, o.z + d.z * t1 };
+
+        AABB r;
+        r.min = { std::min(a.x, b.x) - half.x, std::min(a.y, b.y) - half.y, std::min(a.z, b.z) - half.z };
+        r.max = { std::max(a.x, b.x) + half.x, std::max(a.y, b.y) + half.y, std::max(a.z, b.z) + half.z };
+        return r;
+    }
+}
+
+void Stage01_QueryRay(const XMFLOAT3& origin, const XMFLOAT3& dir, float maxT,
+    const XMFLOAT3& half, Stage01RayFunc func, void* user)
+{
+    if (!func || g_blocks.empty() || !(maxT >= 0.0f)) return;
+    FlushBakeIfDirty();
+
+    const int n = (int)g_blocks.size();
+    if ((int)g_rayMark.size() < n) g_rayMark.resize(n, 0u);
+    if (++g_rayStamp == 0)
+    {
+        std::fill(g_rayMark.begin(), g_rayMark.end(), 0u);
+        g_rayStamp = 1;
+    }
+
+    bool stop = false;
+    auto visit = [&](int i)
+        {
+            if (i >= (int)g_blocks.size() || IsDisabled(i)) return; // func  Remove^ꂽ
+            const float t = func(i, maxT, user);
+            if (t < 0.0f) { stop = true; return; }
+            maxT = std::min(maxT, t);
+        };
+
+    // ubNƓubN͋؂炸ɐŜŌiȂj
+    const AABB whole = RayPieceAABB(origin, dir, 0.0f, maxT, half);
+    if (!IsFiniteAABB(whole))
+    {
+        for (int i = 0; i < n && !stop; ++i) visit(i);
+        return;
+    }
+
+    g_rayPiece.clear();
+    for (int i : g_gridLarge)
     {
-        // openPos  '[' ̈ʒu
-        int depth = 0;
-        for (size_t i = openPos; i < s.size(); ++i)
+        if (!IsTouchAABB(whole, g_blocks[i].aabb)) continue;
+        g_rayMark[i] = g_rayStamp;
+        g_rayPiece.push_back(i);
+    }
+    g_movingTree.Query(whole, [&](int i)
         {
-            const char c = s[i];
-            if (c == '[') ++depth;
-            else if (c == ']')
+            if (g_rayMark[i] == g_rayStamp || !IsTouchAABB(whole, g_blocks[i].aabb)) return true;
+            g_rayMark[i] = g_rayStamp;
+            g_rayPiece.push_back(i);
+            return true;
+        });
+    for (size_t k = 0; k < g_rayPiece.size() && !stop; ++k) visit(g_rayPiece[k]);
+
+    // Obh͎ŐԂ
+    const float len = std::sqrt(dir.x * dir.x + dir.y * dir.y + dir.z * dir.z);
+    float step = (len > 1.0e-8f) ? STAGE_GRID_CELL / len : maxT;
+    if (step * STAGE_RAY_MAX_PIECES < maxT) step = maxT / STAGE_RAY_MAX_PIECES;
+    if (step <= 0.0f) step = 1.0f; // maxT == 0Fn_
+
+    for (int piece = 0; !stop; ++piece)
+    {
+        const float t0 = step * piece;
+        if (t0 > maxT) break;
+        const float t1 = std::min(t0 + step, maxT);
+
+        const AABB box = RayPieceAABB(origin, dir, t0, t1, half);
+        const StageGridRange q = GridRangeOf(box);
+
+        g_rayPiece.clear();
+        auto consider = [&](int i)
             {
-                --depth;
-                if (depth == 0) return i; // Ή ']' 𔭌
-            }
+                if (g_rayMark[i] == g_rayStamp || !IsTouchAABB(box, g_blocks[i].aabb)) return;
+                g_rayMark[i] = g_rayStamp;
+                g_rayPiece.push_back(i);
+            };
+
+        if (q.large)
+        {
+            // 点傫FS
+            for (int i = 0; i < n; ++i) consider(i);
+        }
+        else
+        {
+            for (int z = q.z0; z <= q.z1; ++z)
+                for (int y = q.y0; y <= q.y1; ++y)
+                    for (int x = q.x0; x <= q.x1; ++x)
+                    {
+                        auto it = g_gridCells.find(GridKey(x, y, z));
+                        if (it == g_gridCells.end()) continue;
+                        for (int i : it->second) consider(i);
+                    }
         }
-        return std::string::npos;
+
+        for (size_t k = 0; k < g_rayPiece.size() && !stop; ++k) visit(g_rayPiece[k]);
+        if (t1 >= maxT) break;
+    }
+}
+
+
+// ===== JSON Save/Load =====
+namespace
+{
+    // CXbhł̃[h̍Ɨ̈ig񂷁BsẴXe[W͏Ȃj
+    StageLoadData g_loadData;
+    char g_loadError[320] = "";
+
+    // StageSystem œǂł́i Stage01_LoadStage Ŏgj
+    StageLoadData g_prepared;
+    bool g_hasPrepared = false;
+
+    bool ReadVec3(JsonReader& r, DirectX::XMFLOAT3& out)
+    {
+        float v[3];
+        if (!r.ReadFloats(v, 3)) return false;
+        out = { v[0], v[1], v[2] };
+        return true;
+    }
+
+    // "sine" Ȃǂ '\0' t name Ɏʂi閼O͒mȂOj
+    bool CopyName(const JsonStr& s, char* name, size_t nameSize)
+    {
+        if (s.len <= 0 || (size_t)s.len >= nameSize) return false;
+        std::memcpy(name, s.s, (size_t)s.len);
+        name[s.len] = '\0';
+        return true;
     }
 
-    static size_t FindMatchingBrace(const std::string& s, size_t openPos)
+    // "motion":{...} ǂށBkeys  [[t,x,y,z],...]
+    bool ReadMotionJson(JsonReader& r, StageMotionDesc& out)
     {
-        // openPos  '{' ̈ʒu
-        int depth = 0;
-        for (size_t i = openPos; i < s.size(); ++i)
+        if (!r.BeginObject()) return false;
+
+        JsonStr key, value;
+        char name[32];
+        while (r.NextMember(&key))
         {
-            const char c = s[i];
-            if (c == '{') ++depth;
-            else if (c == '}')
+            if (key == "type" || key == "target" || key == "trigger")
+            {
+                if (!r.ReadString(&value)) break;
+                bool ok = CopyName(value, name, sizeof(name));
+                if (key == "type")        ok = ok && StageMotion_ParseType(name, &out.type);
+                else if (key == "target") ok = ok && StageMotion_ParseTarget(name, &out.target);
+                else                      ok = ok && StageMotion_ParseTrigger(name, &out.trigger);
+                if (!ok) return r.Fail("unknown motion name");
+            }
+            else if (key == "amp")    ReadVec3(r, out.amp);
+            else if (key == "freq")   r.ReadFloat(&out.freq);
+            else if (key == "phase")  r.ReadFloat(&out.phase);
+            else if (key == "period") r.ReadFloat(&out.period);
+            else if (key == "loop")
             {
-                --depth;
-                if (depth == 0) return i; // Ή '}' 𔭌
+                int loop = 0;
+                if (r.ReadInt(&loop)) out.loop = (loop != 0);
             }
+            else if (key == "keys")
+            {
+                r.BeginArray();
+                while (r.NextElement())
+                {
+                    float v[4];
+                    if (!r.ReadFloats(v, 4)) break;
+
+                    StageMotionKey k;
+                    k.time = v[0];
+                    k.value = { v[1], v[2], v[3] };
+                    out.keys.push_back(k);
+                }
+            }
+            else r.Skip();
         }
-        return std::string::npos;
+        return !r.HasError();
     }
 
-    static bool ExtractVec2(const std::string& s, const char* key, DirectX::XMFLOAT2& out)
+    // "blocks"  1 vfBL[ StageBlock ̏l̂܂܁iÂ kind  json ǂ߂j
+    bool ReadBlockJson(JsonReader& r, StageBlock& b, StageMotionDesc& motion, bool& hasMotion)
     {
-        const std::string k = std::string("\"") + key + "\"";
-        size_t pos = s.find(k);
-        if (pos == std::string::npos) return false;
-        pos = s.find('[', pos);
-        if (pos == std::string::npos) return false;
+        if (!r.BeginObject()) return false;
+
+        JsonStr key;
+        while (r.NextMember(&key))
+        {
+            if (key == "id")            r.ReadInt(&b.id);
+            else if (key == "kind")     r.ReadInt(&b.kind);
+            else if (key == "texSlot")  r.ReadInt(&b.texSlot);
+            else if (key == "position") ReadVec3(r, b.position);
+            else if (key == "size")     ReadVec3(r, b.size);
+            else if (key == "rotation") ReadVec3(r, b.rotation);
+            else if (key == "motion")   hasMotion = ReadMotionJson(r, motion);
+            else r.Skip();
+        }
+        return !r.HasError();
+    }
 
-        const char* p = s.c_str() + pos + 1;
-        char* end = nullptr;
+    // "faces"  1 vfB7 ʖڈȍ~͓ǂݎ̂Ă
+    bool ReadFaceJson(JsonReader& r, CubeTemplate& tpl, int face)
+    {
+        if (!r.BeginObject()) return false;
 
-        double x = std::strtod(p, &end);
-        if (end == p) return false;
-        p = end; while (*p && (*p == ',' || std::isspace((unsigned char)*p))) ++p;
+        float uvMin[2]{}, uvMax[2]{}, col[4]{}, nor[3]{};
+        bool hasUvMin = false, hasUvMax = false, hasCol = false, hasNor = false;
+        JsonStr key;
+        while (r.NextMember(&key))
+        {
+            if (key == "uvMin")       hasUvMin = r.ReadFloats(uvMin, 2);
+            else if (key == "uvMax")  hasUvMax = r.ReadFloats(uvMax, 2);
+            else if (key == "color")  hasCol = r.ReadFloats(col, 4);
+            else if (key == "normal") hasNor = r.ReadFloats(nor, 3);
+            else r.Skip();
+        }
+        if (r.HasError()) return false;
+        if (face >= CUBE_FACE_COUNT) return true;
+
+        if (hasUvMin && hasUvMax)
+            CubeTemplate_SetFaceUV(tpl, (CubeFace)face, { uvMin[0], uvMin[1] }, { uvMax[0], uvMax[1] });
+        if (hasCol)
+            CubeTemplate_SetFaceColor(tpl, (CubeFace)face, { col[0], col[1], col[2], col[3] });
+        if (hasNor)
+            tpl.face[face].normal = { nor[0], nor[1], nor[2] };
+        return true;
+    }
 
-        double y = std::strtod(p, &end);
-        if (end == p) return false;
+    // "kinds"  1 vfB"kind" ͔̂΂
+    bool ReadKindJson(JsonReader& r, std::vector<StageLoadKind>& out)
+    {
+        if (!r.BeginObject()) return false;
 
-        out.x = (float)x; out.y = (float)y;
+        StageLoadKind e;
+        e.tpl = CubeTemplate_Unit(); // pos  unit OiUIdlɈvj
+        bool hasKind = false;
+        JsonStr key;
+        while (r.NextMember(&key))
+        {
+            if (key == "kind") hasKind = r.ReadInt(&e.kind);
+            else if (key == "faces")
+            {
+                r.BeginArray();
+                for (int face = 0; r.NextElement(); ++face)
+                    if (!ReadFaceJson(r, e.tpl, face)) break;
+            }
+            else r.Skip();
+        }
+        if (r.HasError()) return false;
+        if (hasKind) out.push_back(e);
         return true;
     }
 
-    static bool ExtractVec4(const std::string& s, const char* key, DirectX::XMFLOAT4& out)
+    // Xe[W json 𓪂 1 񂾂ǂ data ɓBs data.error ɍsE
+    bool ParseStageJson(const char* filepath, const char* text, size_t size, StageLoadData& data)
     {
-        const std::string k = std::string("\"") + key + "\"";
-        size_t pos = s.find(k);
-        if (pos == std::string::npos) return false;
-        pos = s.find('[', pos);
-        if (pos == std::string::npos) return false;
 
-        const char* p = s.c_str() + pos + 1;
-        char* end = nullptr;
+        JsonReader r(text, size);
+        bool hasBlocks = false;
+        JsonStr key;
+        r.BeginObject();
+        while (r.NextMember(&key))
+        {
+            if (key == "kinds") // CӁiÂjson݊j
+            {
+                r.BeginArray();
+                while (r.NextElement())
+                    if (!ReadKindJson(r, data.kinds)) break;
+            }
+            else if (key == "blocks")
+            {
+                hasBlocks = true;
+                r.BeginArray();
+                while (r.NextElement())
+                {
+                    StageBlock b{};
+                    StageMotionDesc motion;
+                    bool hasMotion = false;
+                    if (!ReadBlockJson(r, b, motion, hasMotion)) break;
+
+                    if (hasMotion) data.motions.emplace_back((int)data.blocks.size(), std::move(motion));
+                    data.blocks.push_back(b);
+                }
+            }
+            else r.Skip(); // "version" Ȃ
+        }
+        if (!r.HasError() && !r.IsAtEnd()) r.Fail("extra text after JSON");
+        if (!r.HasError() && !hasBlocks) r.Fail("no \"blocks\"");
 
-        double x = std::strtod(p, &end);
-        if (end == p) return false;
-        p = end; while (*p && (*p == ',' || std::isspace((unsigned char)*p))) ++p;
+        if (!r.HasError()) return true;
 
-        double y = std::strtod(p, &end);
-        if (end == p) return false;
-        p = end; while (*p && (*p == ',' || std::isspace((unsigned char)*p))) ++p;
+        int line = 0, column = 0;
+        r.GetErrorPosition(&line, &column);
+        std::snprintf(data.error, sizeof(data.error), "%s(%d:%d): %s", filepath, line, column, r.GetError());
+        return false; // ǂݍ݃XbhĂԂ̂ŁAo͂͌Ă񂾑CXbh
+
+    }
 
-        double z = std::strtod(p, &end);
-        if (end == p) return false;
-        p = end; while (*p && (*p == ',' || std::isspace((unsigned char)*p))) ++p;
+    // "id" ̖ubNiid O jsonj̓t@C̒̏Ԃ id ɂB
+    // dȂ id ͌ɕtB Stage01_Add ŕt id Ԃ
+    int AssignBlockIds(std::vector<StageBlock>& blocks)
+    {
+        int maxId = -1;
+        for (int i = 0; i < (int)blocks.size(); ++i)
+        {
+            if (blocks[i].id < 0) blocks[i].id = i;
+            maxId = (std::max)(maxId, blocks[i].id);
+        }
 
-        double w = std::strtod(p, &end);
-        if (end == p) return false;
+        std::unordered_set<int> used;
+        used.reserve(blocks.size());
+        for (StageBlock& b : blocks)
+        {
+            if (!used.insert(b.id).second)
+            {
+                b.id = ++maxId;
+                used.insert(b.id);
+            }
+        }
+        return maxId + 1;
+    }
 
-        out.x = (float)x; out.y = (float)y; out.z = (float)z; out.w = (float)w;
-        return true;
+    void ResetLoadData(StageLoadData* data)
+    {
+        data->jsonPath.clear();
+        data->kinds.clear();
+        data->blocks.clear();
+        data->motions.clear();
+        data->error[0] = '\0';
     }
 
-    static bool ExtractInt(const std::string& s, const char* key, int& out)
+    // JSON ǂ Bake ܂ŁiXe[W̏Ԃɂ͐GȂj
+    bool PrepareJson(const char* filepath, StageLoadData* data)
     {
-        const std::string k = std::string("\"") + key + "\"";
-        size_t pos = s.find(k);
-        if (pos == std::string::npos) return false;
-        pos = s.find(':', pos);
-        if (pos == std::string::npos) return false;
+        ResetLoadData(data);
+        if (!filepath || !filepath[0]) return false;
+
+        std::ifstream ifs(filepath, std::ios::binary | std::ios::ate);
+        if (!ifs)
+        {
+            std::snprintf(data->error, sizeof(data->error), "%s: cannot open", filepath);
+            return false;
+        }
 
-        const char* p = s.c_str() + pos + 1;
-        while (*p && std::isspace((unsigned char)*p)) ++p;
+        // t@C 1 œǂށi1 ĂƑ傫Xe[WŒxj
+        std::string txt((size_t)ifs.tellg(), '\0');
+        ifs.seekg(0);
+        ifs.read(&txt[0], (std::streamsize)txt.size());
 
-        char* end = nullptr;
-        long v = std::strtol(p, &end, 10);
-        if (end == p) return false;
+        if (!ParseStageJson(filepath, txt.c_str(), txt.size(), *data))
+            return false;
 
-        out = (int)v;
+        BakeBlocks(data->blocks, nullptr); // 傫Xe[W̓Xbhɕ Bake
+        data->jsonPath = filepath;
         return true;
     }
 
-    static bool ExtractVec3(const std::string& s, const char* key, DirectX::XMFLOAT3& out)
+    // .bin  Bake ς݂ world / aabb ʂišvZ͂Ȃj
+    bool PrepareBinary(const char* filepath, StageLoadData* data)
     {
-        const std::string k = std::string("\"") + key + "\"";
-        size_t pos = s.find(k);
-        if (pos == std::string::npos) return false;
-        pos = s.find('[', pos);
-        if (pos == std::string::npos) return false;
+        ResetLoadData(data);
 
-        const char* p = s.c_str() + pos + 1;
-        char* end = nullptr;
+        StageBinaryView v;
+        if (!StageBinary_Open(filepath, &v))
+        {
+            std::snprintf(data->error, sizeof(data->error), "%s: not a stage binary", filepath ? filepath : "");
+            return false;
+        }
 
-        double x = std::strtod(p, &end);
-        if (end == p) return false;
-        p = end; while (*p && (*p == ',' || std::isspace((unsigned char)*p))) ++p;
+        data->kinds.resize(v.kindCount);
+        for (int i = 0; i < v.kindCount; ++i)
+        {
+            data->kinds[i].kind = v.kinds[i].kind;
+            data->kinds[i].tpl = v.kinds[i].tpl;
+        }
 
-        double y = std::strtod(p, &end);
-        if (end == p) return false;
-        p = end; while (*p && (*p == ',' || std::isspace((unsigned char)*p))) ++p;
+        const int n = v.blockCount;
+        data->blocks.resize(n);
+        for (int i = 0; i < n; ++i)
+        {
+            StageBlock& b = data->blocks[i];
+            b.id = v.id[i];
+            b.kind = v.kind[i];
+            b.texSlot = v.texSlot[i];
+            b.position = v.position[i];
+            b.size = v.size[i];
+            b.rotation = v.rotation[i];
+            b.world = v.world[i];
+            b.aabb.min = { v.aabbMin[0][i], v.aabbMin[1][i], v.aabbMin[2][i] };
+            b.aabb.max = { v.aabbMax[0][i], v.aabbMax[1][i], v.aabbMax[2][i] };
+        }
 
-        double z = std::strtod(p, &end);
-        if (end == p) return false;
+        data->motions.resize(v.motionCount);
+        for (int i = 0; i < v.motionCount; ++i)
+        {
+            const StageBinaryMotion& m = v.motions[i];
+            StageMotionDesc& d = data->motions[i].second;
+            data->motions[i].first = m.block;
+            d.type = (StageMotionType)m.type;
+            d.target = (StageMotionTarget)m.target;
+            d.trigger = (StageMotionTrigger)m.trigger;
+            d.amp = { m.amp[0], m.amp[1], m.amp[2] };
+            d.freq = m.freq;
+            d.phase = m.phase;
+            d.period = m.period;
+            d.loop = m.loop != 0;
+            d.keys.assign(v.keys + m.keyBegin, v.keys + m.keyBegin + m.keyCount);
+        }
 
-        out.x = (float)x; out.y = (float)y; out.z = (float)z;
+        StageBinary_Close(&v);
         return true;
     }
+
+    static void WriteMotionJson(std::ofstream& ofs, const StageMotionDesc& d)
+    {
+        ofs << "\"motion\":{"
+            << "\"type\":\"" << StageMotion_TypeName(d.type) << "\","
+            << "\"target\":\"" << StageMotion_TargetName(d.target) << "\"";
+        if (d.trigger != STAGE_MOTION_ALWAYS)
+            ofs << ",\"trigger\":\"" << StageMotion_TriggerName(d.trigger) << "\"";
+
+        switch (d.type)
+        {
+        case STAGE_MOTION_SINE:
+            ofs << ",\"amp\":[" << d.amp.x << "," << d.amp.y << "," << d.amp.z << "]"
+                << ",\"freq\":" << d.freq << ",\"phase\":" << d.phase;
+            break;
+        case STAGE_MOTION_PINGPONG:
+            ofs << ",\"amp\":[" << d.amp.x << "," << d.amp.y << "," << d.amp.z << "]"
+                << ",\"period\":" << d.period;
+            break;
+        case STAGE_MOTION_KEYS:
+            ofs << ",\"keys\":[";
+            for (size_t k = 0; k < d.keys.size(); ++k)
+            {
+                const StageMotionKey& key = d.keys[k];
+                if (k) ofs << ",";
+                ofs << "[" << key.time << "," << key.value.x << "," << key.value.y << "," << key.value.z << "]";
+            }
+            ofs << "],\"loop\":" << (d.loop ? 1 : 0);
+            break;
+        default:
+            ofs << ",\"amp\":[" << d.amp.x << "," << d.amp.y << "," << d.amp.z << "]";
+            break;
+        }
+        ofs << "}";
+    }
 }
 
 static void GetFaceUvMinMax(const CubeFaceDesc& fd, DirectX::XMFLOAT2& outUvMin, DirectX::XMFLOAT2& outUvMax)
@@ -648,94 +1960,6 @@ static void WriteKindsJson(std::ofstream& ofs)
     ofs << "  ],\n";
 }
 
-static bool ParseKindsJson(const std::string& txt)
-{
-    // kinds ͔CӁiÂjson݊j
-    size_t pKinds = txt.find("\"kinds\"");
-    if (pKinds == std::string::npos) return true;
-
-    size_t lb = txt.find('[', pKinds);
-    if (lb == std::string::npos) return false;
-
-    size_t rb = FindMatchingBracket(txt, lb);
-    if (rb == std::string::npos) return false;
-
-    size_t cur = lb + 1;
-
-    while (true)
-    {
-        size_t ob = txt.find('{', cur);
-        if (ob == std::string::npos || ob > rb) break;
-
-        size_t cb = FindMatchingBrace(txt, ob);
-        if (cb == std::string::npos || cb > rb) return false;
-
-        std::string kindObj = txt.substr(ob, cb - ob + 1);
-
-        int kind = 0;
-        if (!ExtractInt(kindObj, "kind", kind))
-        {
-            cur = cb + 1;
-            continue;
-        }
-
-        CubeTemplate tpl = CubeTemplate_Unit(); // pos  unit OiUIdlɈvj
-
-        // faces
-        size_t pFaces = kindObj.find("\"faces\"");
-        if (pFaces != std::string::npos)
-        {
-            size_t flb = kindObj.find('[', pFaces);
-            size_t frb = (flb != std::string::npos) ? FindMatchingBracket(kindObj, flb) : std::string::npos;
-            if (flb == std::string::npos || frb == std::string::npos) return false;
-
-            int faceIndex = 0;
-            size_t fcur = flb + 1;
-
-            while (faceIndex < CUBE_FACE_COUNT)
-            {
-                size_t fob = kindObj.find('{', fcur);
-                if (fob == std::string::npos || fob > frb) break;
-
-                size_t fcb = FindMatchingBrace(kindObj, fob);
-                if (fcb == std::string::npos || fcb > frb) return false;
-
-                std::string faceObj = kindObj.substr(fob, fcb - fob + 1);
-
-                DirectX::XMFLOAT2 uvMin{}, uvMax{};
-                DirectX::XMFLOAT4 col{};
-                DirectX::XMFLOAT3 nor{};
-
-                bool hasUvMin = ExtractVec2(faceObj, "uvMin", uvMin);
-                bool hasUvMax = ExtractVec2(faceObj, "uvMax", uvMax);
-                bool hasCol = ExtractVec4(faceObj, "color", col);
-                bool hasNor = ExtractVec3(faceObj, "normal", nor);
-
-                if (hasUvMin && hasUvMax)
-                    CubeTemplate_SetFaceUV(tpl, (CubeFace)faceIndex, uvMin, uvMax);
-                if (hasCol)
-                    CubeTemplate_SetFaceColor(tpl, (CubeFace)faceIndex, col);
-                if (hasNor)
-                    tpl.face[faceIndex].normal = nor;
-
-                ++faceIndex;
-                fcur = fcb + 1;
-            }
-        }
-
-        // fikind UpdateAȂ Registerj
-        CubeTemplate dummy{};
-        if (Cube_TryGetKindTemplate(kind, dummy))
-            Cube_UpdateKind(kind, tpl);
-        else
-            Cube_RegisterKind(kind, tpl);
-
-        cur = cb + 1;
-    }
-
-    return true;
-}
-
 bool Stage01_SaveJson(const char* filepath)
 {
     if (!filepath || !filepath[0]) return false;
@@ -762,12 +1986,20 @@ bool Stage01_SaveJson(const char* filepath)
         if (!b) continue;
 
         ofs << "    {"
+            << "\"id\":" << b->id << ","
             << "\"kind\":" << b->kind << ","
             << "\"texSlot\":" << b->texSlot << ","
             << "\"position\":[" << b->position.x << "," << b->position.y << "," << b->position.z << "],"
             << "\"size\":[" << b->size.x << "," << b->size.y << "," << b->size.z << "],"
-            << "\"rotation\":[" << b->rotation.x << "," << b->rotation.y << "," << b->rotation.z << "]"
-            << "}";
+            << "\"rotation\":[" << b->rotation.x << "," << b->rotation.y << "," << b->rotation.z << "]";
+
+        StageMotionDesc motion;
+        if (StageMotion_Find(i, &motion))
+        {
+            ofs << ",";
+            WriteMotionJson(ofs, motion);
+        }
+        ofs << "}";
 
         if (i != n - 1) ofs << ",";
         ofs << "\n";
@@ -781,71 +2013,134 @@ bool Stage01_SaveJson(const char* filepath)
 
 bool Stage01_LoadJson(const char* filepath)
 {
-    if (!filepath || !filepath[0]) return false;
+    if (!PrepareJson(filepath, &g_loadData))
+    {
+        std::snprintf(g_loadError, sizeof(g_loadError), "%s", g_loadData.error);
+        if (g_loadError[0]) hal::dout << "Stage01_LoadJson() : " << g_loadError << std::endl;
+        return false;
+    }
+    g_loadError[0] = '\0';
+    Stage01_CommitLoad(&g_loadData);
+    return true;
+}
 
-    std::ifstream ifs(filepath, std::ios::binary);
-    if (!ifs) return false;
+const char* Stage01_GetLoadError()
+{
+    return g_loadError;
+}
 
-    std::string txt((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+bool Stage01_LoadBinary(const char* filepath)
+{
+    if (!PrepareBinary(filepath, &g_loadData)) return false;
+    Stage01_CommitLoad(&g_loadData); //  JSON pX͂̂܂
+    return true;
+}
 
-    // kinds ͔CӁBΐɔfĂ blocks ǂ
-    if (!ParseKindsJson(txt))
+bool Stage01_PrepareLoad(const char* jsonPath, StageLoadData* data)
+{
+    if (!data) return false;
+    if (!jsonPath || !jsonPath[0])
+    {
+        ResetLoadData(data);
         return false;
+    }
 
-    size_t pBlocks = txt.find("\"blocks\"");
-    if (pBlocks == std::string::npos) return false;
-
-    size_t lb = txt.find('[', pBlocks);
-    if (lb == std::string::npos) return false;
-
-    size_t rb = FindMatchingBracket(txt, lb);
-    if (rb == std::string::npos) return false;
+    char binPath[260];
+    StageBinary_MakePath(jsonPath, binPath, sizeof(binPath));
+    if (StageBinary_IsUpToDate(binPath, jsonPath) && PrepareBinary(binPath, data))
+    {
+        data->jsonPath = jsonPath; // ۑE蒼 JSON ̖Ô܂
+        return true;
+    }
+    return PrepareJson(jsonPath, data);
+}
 
-    std::vector<StageBlock> temp; // sɏȂ悤U temp ɓǂ
-    temp.reserve(1024);
+void Stage01_CommitLoad(StageLoadData* data)
+{
+    if (!data) return;
 
-    size_t cur = lb + 1;
-    while (true)
+    // kinds ɔfikind UpdateAȂ Registerj
+    for (const StageLoadKind& e : data->kinds)
     {
-        size_t ob = txt.find('{', cur);
-        if (ob == std::string::npos || ob > rb) break;
+        CubeTemplate dummy{};
+        if (Cube_TryGetKindTemplate(e.kind, dummy))
+            Cube_UpdateKind(e.kind, e.tpl);
+        else
+            Cube_RegisterKind(e.kind, e.tpl);
+    }
 
-        size_t cb = FindMatchingBrace(txt, ob);
-        if (cb == std::string::npos || cb > rb) return false;
+    // Bake ς݂̔zƓւiÂz data ɎcĎ̃[hŎg񂳂j
+    Stage01_Clear();
+    g_nextBlockId = AssignBlockIds(data->blocks);
+    g_blocks.swap(data->blocks);
+    data->blocks.clear();
+    g_offsets.assign(g_blocks.size(), StageRuntimeOffset{});
+    for (int i = 0; i < (int)g_blocks.size(); ++i)
+    {
+        ApplyTex(g_blocks[i]);
+        SlotAlloc(i);
+    }
 
-        std::string obj = txt.substr(ob, cb - ob + 1);
+    BakeDirtyResize(g_blocks.size());
+    DisabledResize(g_blocks.size());
+    GridRebuild();
+    ColSyncAll();
 
-        StageBlock b{};
-        int kind = 0, slot = 0;
-        DirectX::XMFLOAT3 v{};
+    for (const auto& m : data->motions)
+        StageMotion_Add(m.first, m.second);
 
-        if (ExtractInt(obj, "kind", kind)) b.kind = kind;
-        if (ExtractInt(obj, "texSlot", slot)) b.texSlot = slot;
+    if (!data->jsonPath.empty())
+        Stage01_SetCurrentJsonPath(data->jsonPath.c_str());
 
-        if (ExtractVec3(obj, "position", v)) b.position = v;
-        if (ExtractVec3(obj, "size", v))     b.size = v;
-        if (ExtractVec3(obj, "rotation", v)) b.rotation = v;
+    data->kinds.clear();
+    data->motions.clear();
+}
 
-        temp.push_back(b);
-        cur = cb + 1;
-    }
+void Stage01_SetPreparedLoad(StageLoadData* data)
+{
+    if (!data) return;
+    std::swap(g_prepared, *data);
+    g_hasPrepared = !g_prepared.jsonPath.empty();
+}
 
-    Stage01_Clear();
-    for (auto& b : temp)
-        Stage01_Add(b, true); // ApplyTex + Bake
+bool Stage01_LoadStage(const char* jsonPath)
+{
+    if (!jsonPath || !jsonPath[0]) return false;
 
-    Stage01_SetCurrentJsonPath(filepath);
+    // œǂݏIĂ΃fBXNǂ܂ɓւ邾
+    const bool usePrepared = g_hasPrepared && g_prepared.jsonPath == jsonPath;
+    g_hasPrepared = false;
+    if (usePrepared)
+    {
+        Stage01_CommitLoad(&g_prepared);
+        return true;
+    }
 
+    if (!Stage01_PrepareLoad(jsonPath, &g_loadData))
+    {
+        std::snprintf(g_loadError, sizeof(g_loadError), "%s", g_loadData.error);
+        if (g_loadError[0]) hal::dout << "Stage01_LoadStage() : " << g_loadError << std::endl;
+        return false;
+    }
+    g_loadError[0] = '\0';
+    Stage01_CommitLoad(&g_loadData);
     return true;
 }
 
+void Stage01_CollectAssets(AssetPrefetchList* list)
+{
+    if (!list) return;
+    for (const StageTexFile& t : k_stageTexFiles)
+        list->textures.push_back(t.path);
+}
+
 StageSwitchResult Stage01_SwitchStage(const char* jsonPath, bool createEmptyIfMissing)
 {
     if (!jsonPath || !jsonPath[0])
         return STAGE_SWITCH_FAILED;
 
     // ܂̓[hi炻ŏIj
-    if (Stage01_LoadJson(jsonPath))
+    if (Stage01_LoadStage(jsonPath))
     {
         // LoadJson SetCurrentJsonPath ĂȂsvAیŌĂOK
         Stage01_SetCurrentJsonPath(jsonPath);
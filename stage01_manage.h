@@ -11,7 +11,13 @@
 #define STAGE01_MANAGE_H
 
 #include "collision.h"
+#include "stage_cube.h"
+#include "stage_motion.h"
 #include <DirectXMath.h>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 
 // ImGuiŒڂgҏWΏہh
@@ -21,6 +27,7 @@ struct StageBlock
     int kind = 0;     // L[uށiUV/F/@̃evj0OK
     int texSlot = 0;
     int texId = -1;
+    int id = -1;      // Xe[WŕςȂԍiJSON  "id"jBۑEǂݒŕтςĂubNw
 
 
     DirectX::XMFLOAT3 position{ 0,0,0 }; // S
@@ -33,6 +40,20 @@ struct StageBlock
     DirectX::XMFLOAT4X4 world{};
     AABB aabb{};
 };
+// ubNƂ̎QƁBXbgԍ{ŁAꂽubÑnh͖ɂȂ
+// iXbgėpĂオႤ̂ŕʂ̃ubNwȂjBl͏ɖ
+struct StageBlockHandle
+{
+    unsigned int slot = 0xffffffffu;
+    unsigned int generation = 0;
+};
+
+inline bool operator==(const StageBlockHandle& a, const StageBlockHandle& b)
+{
+    return a.slot == b.slot && a.generation == b.generation;
+}
+inline bool operator!=(const StageBlockHandle& a, const StageBlockHandle& b) { return !(a == b); }
+
 int Stage01_GetTexSlotCount();
 const char* Stage01_GetTexSlotName(int slot);
 
@@ -47,18 +68,30 @@ void Stage01_Initialize(const char* jsonPath);
 void Stage01_Finalize();
 void Stage01_Update(double elapsedTime);
 void Stage01_Draw();
+void Stage01_Submit();    // Stage01_Draw ̕`L[ŁieNX`Ƃ̃ob`Őςށj
 void Stage01_DepthDraw(); // epigȂj
 
 // ===== ImGuig߂̍Œ =====
+// CfbNXi0..Count-1j͖t[̃[vpBStage01_Remove Ŗ̃ubN
+// ʒuɈڂ̂ŁAt[܂ŎȂnhɂ
 int  Stage01_GetCount();
 const StageBlock* Stage01_Get(int i);
 StageBlock* Stage01_GetMutable(int i);
+const StageBlock* Stage01_Get(StageBlockHandle h);
+StageBlock* Stage01_GetMutable(StageBlockHandle h);
+
+StageBlockHandle Stage01_GetHandle(int i);      // ͈͊OȂ疳nh
+int  Stage01_GetIndex(StageBlockHandle h);      // ̃CfbNXBȂ -1
+bool Stage01_IsValid(StageBlockHandle h);
+// StageBlock::id ŒTi`Ȃ̂Ń[hȂǂ 1 񂾂jBΖnh
+StageBlockHandle Stage01_FindBlockById(int id);
 
 void Stage01_RebuildObject(int i);   // ҏWɌĂ
 void Stage01_RebuildAll();           // ܂Ƃ߂ďĂ
 
-int  Stage01_Add(const StageBlock& b, bool bake = true);
-void Stage01_Remove(int i);
+StageBlockHandle Stage01_Add(const StageBlock& b, bool bake = true);   // ɒǉ
+void Stage01_Remove(int i);                 // ̃ubN i Ɉڂċl߂iO(1)j
+void Stage01_Remove(StageBlockHandle h);
 void Stage01_Clear();
 
 bool Stage01_AddObjectTransform(int index,
@@ -66,8 +99,131 @@ bool Stage01_AddObjectTransform(int index,
     const DirectX::XMFLOAT3& sizeDelta,
     const DirectX::XMFLOAT3& rotationDelta);
 
+// AddObjectTransform œubN͈t邾ŁAł܂Ƃ߂ Bake B
+// Stage01_Update ̍ŌɌĂ΂B₢킹E`̑Oɂc肪ΎŌĂ΂
+void Stage01_FlushBake();
+
+// O Stage01_Update ܂ł 1 t[ŃubNʁiAddObjectTransform ̈ʒu̍vjB
+// ̑xƂĎgivC[͗ĂubN̗̂ʂꏏɓj
+DirectX::XMFLOAT3 Stage01_GetFrameMove(int index);
+
+// ubN̈B̕tubN̓Obhł͂ȂIAABBc[ŊǗ
+// iStage01_AddObjectTransform œubNɂ͎ŕtj
+void Stage01_SetBlockMoving(int index, bool moving);
+bool Stage01_IsBlockMoving(int index);
+
+// s̗L^iꂽKȂǁjBȃubN͕`EeE蔻̖₢킹ɏoĂȂB
+// CfbNX aabb ͂̂܂܂Ȃ̂ŁALɖ߂ΌʂB[hEClear őSLɖ߂
+void Stage01_SetBlockEnabled(int index, bool enabled);
+bool Stage01_IsBlockEnabled(int index);
+void Stage01_EnableAllBlocks();    // Xe[Ŵ蒼pirbg𖄂ߒj
+// AddObjectTransform ő̂ĂāAǂݍ񂾂Ƃ̈ʒuɖ߂i蒼pBǂݒȂj
+void Stage01_ResetObjectTransforms();
+
+// ===== 蔻̃u[htF[YilObh{IAABBc[j=====
+// aabb ƏdȂiڂĂ̂܂ށjubNCfbNXŗ񋓂B
+// SƓԂŕԂ̂ŁAuĂ茋ʂ͕ςȂB
+// func  false Ԃ炻őł؂B߂l func Ă񂾉񐔁B
+// func ̒ŃubN𓮂薳ɂ肵ĂOKi͐Ɋm肵ĂjB
+//   Ɩ̃ubNւ̂ŁAfunc ̒ł Stage01_Remove Ȃ
+typedef bool (*Stage01QueryFunc)(int index, const StageBlock& block, void* user);
+int Stage01_QueryAABB(const AABB& aabb, Stage01QueryFunc func, void* user);
+
+// _ŁF Stage01_QueryAABB(box, [&](int i, const StageBlock& b) { ...; return true; });
+template<class Fn>
+inline int Stage01_QueryAABB(const AABB& aabb, Fn&& fn)
+{
+    using FnType = std::remove_reference_t<Fn>;
+    return Stage01_QueryAABB(aabb,
+        [](int index, const StageBlock& block, void* user) -> bool
+        {
+            return (*static_cast<FnType*>(user))(index, block);
+        },
+        const_cast<void*>(static_cast<const void*>(&fn)));
+}
+
+// ===== 蔻p SoA r[ =====
+// aabb Ƃ̔ziminX[] ... maxZ[]jɎʂ́Bg_blocks ƓԁEB
+// ubN̒ǉE폜Ń|C^͕ς̂ŁAgтɎ蒼
+enum StageCollisionFlag : unsigned char
+{
+    STAGE_COL_MOVING = 1 << 0,   // IAABBc[̃ubN
+};
+
+struct StageCollisionSoA
+{
+    AABBSoAView bounds;
+    const int* kind = nullptr;
+    const unsigned char* flags = nullptr;
+};
+
+StageCollisionSoA Stage01_GetCollisionSoA();
+
+// aabb ɐڂubN out ɓiStage01_QueryAABB Ɠj
+void Stage01_CollectAABB(const AABB& aabb, std::vector<int>& out);
+
+// aabb ƏdȂiڂ邾͏jubN邩
+bool Stage01_OverlapsAny(const AABB& aabb);
+
+// ===== ɉ₢킹 =====
+// origin + dir * ti0 <= t <= maxTj half 点͈͂ɂubNAO珇 func ɓnB
+// ubN1񂾂Bfunc ̖߂lFȂł؂AȊO͈ȍ~ maxTik߂Ή͌ȂjB
+// func ̒ Stage01_QueryRay Ă΂ȂƁiStage01_QueryAABB  OKj
+typedef float (*Stage01RayFunc)(int index, float maxT, void* user);
+void Stage01_QueryRay(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir, float maxT,
+    const DirectX::XMFLOAT3& half, Stage01RayFunc func, void* user);
+
+// _ŁF Stage01_QueryRay(o, d, maxT, half, [&](int i, float maxT) { ...; return maxT; });
+template<class Fn>
+inline void Stage01_QueryRay(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir, float maxT,
+    const DirectX::XMFLOAT3& half, Fn&& fn)
+{
+    using FnType = std::remove_reference_t<Fn>;
+    Stage01_QueryRay(origin, dir, maxT, half,
+        [](int index, float t, void* user) -> float
+        {
+            return (*static_cast<FnType*>(user))(index, t);
+        },
+        const_cast<void*>(static_cast<const void*>(&fn)));
+}
+
 bool Stage01_SaveJson(const char* filepath);
 bool Stage01_LoadJson(const char* filepath);
+// O Stage01_LoadJson sRi"path(s:): e"jBĂ ""
+const char* Stage01_GetLoadError();
+// StageBinary_Write ŏ .bin ǂށiJSON ̉́EBake Ȃj
+bool Stage01_LoadBinary(const char* filepath);
+// jsonPath Ɠ .bin  JSON V΂A JSON ǂ
+bool Stage01_LoadStage(const char* jsonPath);
+
+// ===== ł̓ǂݍ݁iXe[W؂ւpj=====
+struct StageLoadKind
+{
+    int kind = 0;
+    CubeTemplate tpl{};
+};
+
+// Stage01_PrepareLoad ũXe[WvBBake ܂ōςłāÃXe[WƂ͉LȂ
+struct StageLoadData
+{
+    std::string jsonPath;                               // Stage01_GetCurrentJsonPath ɂȂpX
+    std::vector<StageLoadKind> kinds;
+    std::vector<StageBlock> blocks;                     // world / aabb  Bake ς݁itexId ͂܂j
+    std::vector<std::pair<int, StageMotionDesc>> motions;   // (ubNԍ, )
+    char error[320] = "";
+};
+
+// Xe[W̏ԂɐGȂ̂ŁAǂ̃XbhĂł悢iV .bin ΂j
+bool Stage01_PrepareLoad(const char* jsonPath, StageLoadData* data);
+// CXbhŁB̃Xe[W data ̒gƓւidata ͋ɂȂj
+void Stage01_CommitLoad(StageLoadData* data);
+// pӂ̂aB Stage01_LoadStage(pX) fBXNǂ܂ɂg
+// ipXႦΎ̂Ăĕʂɓǂށj
+void Stage01_SetPreparedLoad(StageLoadData* data);
+
+struct AssetPrefetchList;
+// Stage01_Initialize ǂމ摜 list ɑiStageSystem ŐɃfR[hĂj
+void Stage01_CollectAssets(AssetPrefetchList* list);
 
 enum StageSwitchResult
 {
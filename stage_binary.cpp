@@ -0,0 +1,397 @@
+/*==============================================================================
+
+@@  Xe[W̃oCi[stage_binary.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/16
+--------------------------------------------------------------------------------
+
+==============================================================================*/
+#include "stage_binary.h"
+#include "stage01_manage.h"
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr char BIN_MAGIC[4] = { 'L', 'M', 'S', 'B' };
+    constexpr uint32_t BIN_ALIGN = 16;
+
+    struct SectionEntry
+    {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t fileSize;
+        uint32_t blockCount;
+        uint32_t kindCount;
+        uint32_t motionCount;
+        uint32_t keyCount;
+        uint32_t sectionCount;
+        SectionEntry sections[STAGE_BIN_SECTION_COUNT];
+    };
+
+    // t@C̒ĝ܂ܔzƂēǂނ̂ŁAʂ^ɂĂ
+    static_assert(std::is_trivially_copyable<StageBinaryKind>::value, "StageBinaryKind must be POD-like");
+    static_assert(std::is_trivially_copyable<StageBinaryMotion>::value, "StageBinaryMotion must be POD-like");
+    static_assert(std::is_trivially_copyable<StageMotionKey>::value, "StageMotionKey must be POD-like");
+    static_assert(sizeof(StageMotionKey) == sizeof(float) * 4, "StageMotionKey layout");
+    static_assert(sizeof(XMFLOAT4X4) == sizeof(float) * 16, "XMFLOAT4X4 layout");
+
+    // ZNVƂ̗vf̑傫ƌiwb_ count j
+    uint32_t SectionElemSize(uint32_t s)
+    {
+        switch (s)
+        {
+        case STAGE_BIN_KINDS:       return (uint32_t)sizeof(StageBinaryKind);
+        case STAGE_BIN_BLOCK_KIND:
+        case STAGE_BIN_BLOCK_TEX:
+        case STAGE_BIN_BLOCK_ID:    return (uint32_t)sizeof(int32_t);
+        case STAGE_BIN_POSITION:
+        case STAGE_BIN_SIZE:
+        case STAGE_BIN_ROTATION:    return (uint32_t)sizeof(XMFLOAT3);
+        case STAGE_BIN_WORLD:       return (uint32_t)sizeof(XMFLOAT4X4);
+        case STAGE_BIN_MOTIONS:     return (uint32_t)sizeof(StageBinaryMotion);
+        case STAGE_BIN_MOTION_KEYS: return (uint32_t)sizeof(StageMotionKey);
+        default:                    return (uint32_t)sizeof(float);    // AABB_*
+        }
+    }
+
+    uint32_t SectionCount(uint32_t s, const Header& h)
+    {
+        switch (s)
+        {
+        case STAGE_BIN_KINDS:       return h.kindCount;
+        case STAGE_BIN_MOTIONS:     return h.motionCount;
+        case STAGE_BIN_MOTION_KEYS: return h.keyCount;
+        default:                    return h.blockCount;
+        }
+    }
+
+    // ===== t@C̃}bv =====
+    struct Mapping
+    {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+#if defined(_WIN32)
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE map = nullptr;
+#else
+        int fd = -1;
+#endif
+    };
+
+    void Unmap(Mapping& m)
+    {
+#if defined(_WIN32)
+        if (m.data) UnmapViewOfFile(m.data);
+        if (m.map) CloseHandle(m.map);
+        if (m.file != INVALID_HANDLE_VALUE) CloseHandle(m.file);
+#else
+        if (m.data) munmap(const_cast<uint8_t*>(m.data), m.size);
+        if (m.fd >= 0) close(m.fd);
+#endif
+        m = Mapping{};
+    }
+
+    bool Map(const char* path, Mapping& m)
+    {
+        m = Mapping{};
+#if defined(_WIN32)
+        m.file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m.file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(m.file, &size) || size.QuadPart <= 0 || size.QuadPart > 0x7fffffff)
+        {
+            Unmap(m);
+            return false;
+        }
+        m.size = (size_t)size.QuadPart;
+
+        m.map = CreateFileMappingA(m.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m.map) { Unmap(m); return false; }
+        m.data = static_cast<const uint8_t*>(MapViewOfFile(m.map, FILE_MAP_READ, 0, 0, 0));
+        if (!m.data) { Unmap(m); return false; }
+#else
+        m.fd = open(path, O_RDONLY);
+        if (m.fd < 0) return false;
+
+        struct stat st {};
+        if (fstat(m.fd, &st) != 0 || st.st_size <= 0 || st.st_size > 0x7fffffff)
+        {
+            Unmap(m);
+            return false;
+        }
+        m.size = (size_t)st.st_size;
+
+        void* p = mmap(nullptr, m.size, PROT_READ, MAP_PRIVATE, m.fd, 0);
+        if (p == MAP_FAILED) { Unmap(m); return false; }
+        m.data = static_cast<const uint8_t*>(p);
+#endif
+        return true;
+    }
+
+    template<class T>
+    const T* SectionPtr(const uint8_t* base, const Header& h, uint32_t s)
+    {
+        return reinterpret_cast<const T*>(base + h.sections[s].offset);
+    }
+
+    // ===== o =====
+    void AppendSection(std::vector<uint8_t>& buf, Header& h, uint32_t s, const void* data, size_t bytes)
+    {
+        const size_t offset = (buf.size() + (BIN_ALIGN - 1)) & ~(size_t)(BIN_ALIGN - 1);
+        buf.resize(offset + bytes, 0);
+        if (bytes) std::memcpy(buf.data() + offset, data, bytes);
+        h.sections[s].offset = (uint32_t)offset;
+        h.sections[s].size = (uint32_t)bytes;
+    }
+
+    template<class T>
+    void AppendSection(std::vector<uint8_t>& buf, Header& h, uint32_t s, const std::vector<T>& v)
+    {
+        AppendSection(buf, h, s, v.data(), v.size() * sizeof(T));
+    }
+}
+
+bool StageBinary_Open(const char* path, StageBinaryView* out)
+{
+    if (!path || !path[0] || !out) return false;
+
+    Mapping m;
+    if (!Map(path, m)) return false;
+
+    // wb_ƃZNV͈̔͂Sm߂Ăgiꂽt@CŔ͈͊Oǂ܂Ȃj
+    Header h;
+    bool ok = (m.size >= sizeof(Header));
+    if (ok)
+    {
+        std::memcpy(&h, m.data, sizeof(Header));
+        ok = std::memcmp(h.magic, BIN_MAGIC, 4) == 0
+            && h.version == STAGE_BINARY_VERSION
+            && h.fileSize == (uint32_t)m.size
+            && h.sectionCount == STAGE_BIN_SECTION_COUNT
+            && h.blockCount <= 0x00ffffffu && h.kindCount <= 0xffffu
+            && h.motionCount <= 0x00ffffffu && h.keyCount <= 0x00ffffffu;
+    }
+    for (uint32_t s = 0; ok && s < STAGE_BIN_SECTION_COUNT; ++s)
+    {
+        const SectionEntry& e = h.sections[s];
+        ok = (e.offset % 4) == 0
+            && e.offset >= sizeof(Header)
+            && (uint64_t)e.offset + e.size <= m.size
+            && (uint64_t)e.size == (uint64_t)SectionElemSize(s) * SectionCount(s, h);
+    }
+    if (!ok)
+    {
+        Unmap(m);
+        return false;
+    }
+
+    StageBinaryView v;
+    v.blockCount = (int)h.blockCount;
+    v.kindCount = (int)h.kindCount;
+    v.motionCount = (int)h.motionCount;
+    v.keyCount = (int)h.keyCount;
+    v.kinds = SectionPtr<StageBinaryKind>(m.data, h, STAGE_BIN_KINDS);
+    v.kind = SectionPtr<int32_t>(m.data, h, STAGE_BIN_BLOCK_KIND);
+    v.texSlot = SectionPtr<int32_t>(m.data, h, STAGE_BIN_BLOCK_TEX);
+    v.id = SectionPtr<int32_t>(m.data, h, STAGE_BIN_BLOCK_ID);
+    v.position = SectionPtr<XMFLOAT3>(m.data, h, STAGE_BIN_POSITION);
+    v.size = SectionPtr<XMFLOAT3>(m.data, h, STAGE_BIN_SIZE);
+    v.rotation = SectionPtr<XMFLOAT3>(m.data, h, STAGE_BIN_ROTATION);
+    v.world = SectionPtr<XMFLOAT4X4>(m.data, h, STAGE_BIN_WORLD);
+    for (int a = 0; a < 3; ++a)
+    {
+        v.aabbMin[a] = SectionPtr<float>(m.data, h, STAGE_BIN_AABB_MIN_X + a);
+        v.aabbMax[a] = SectionPtr<float>(m.data, h, STAGE_BIN_AABB_MAX_X + a);
+    }
+    v.motions = SectionPtr<StageBinaryMotion>(m.data, h, STAGE_BIN_MOTIONS);
+    v.keys = SectionPtr<StageMotionKey>(m.data, h, STAGE_BIN_MOTION_KEYS);
+
+    // L[͈̔͂ŌĂ
+    for (int i = 0; i < v.motionCount; ++i)
+    {
+        const StageBinaryMotion& mo = v.motions[i];
+        if (mo.keyBegin < 0 || mo.keyCount < 0 || (int64_t)mo.keyBegin + mo.keyCount > v.keyCount)
+        {
+            Unmap(m);
+            return false;
+        }
+    }
+
+    v.mapping = new Mapping(m);
+    *out = v;
+    return true;
+}
+
+void StageBinary_Close(StageBinaryView* view)
+{
+    if (!view || !view->mapping) return;
+    Mapping* m = static_cast<Mapping*>(view->mapping);
+    Unmap(*m);
+    delete m;
+    *view = StageBinaryView{};
+}
+
+bool StageBinary_Write(const char* path)
+{
+    if (!path || !path[0]) return false;
+
+    // ubNOi[hj world / aabb ̂܂܏
+    const int n = Stage01_GetCount();
+    std::vector<int32_t> kind(n), tex(n), id(n);
+    std::vector<XMFLOAT3> position(n), size(n), rotation(n);
+    std::vector<XMFLOAT4X4> world(n);
+    std::vector<float> aabb[6];
+    for (auto& a : aabb) a.resize(n);
+
+    std::vector<StageBinaryMotion> motions;
+    std::vector<StageMotionKey> keys;
+
+    for (int i = 0; i < n; ++i)
+    {
+        const StageBlock* b = Stage01_Get(i);
+        if (!b) return false;
+
+        kind[i] = b->kind;
+        tex[i] = b->texSlot;
+        id[i] = b->id;
+        position[i] = b->position;
+        size[i] = b->size;
+        rotation[i] = b->rotation;
+        world[i] = b->world;
+        aabb[0][i] = b->aabb.min.x; aabb[1][i] = b->aabb.min.y; aabb[2][i] = b->aabb.min.z;
+        aabb[3][i] = b->aabb.max.x; aabb[4][i] = b->aabb.max.y; aabb[5][i] = b->aabb.max.z;
+
+        StageMotionDesc d;
+        if (!StageMotion_Find(i, &d)) continue;
+
+        StageBinaryMotion mo{};
+        mo.block = i;
+        mo.type = d.type;
+        mo.target = d.target;
+        mo.trigger = d.trigger;
+        mo.amp[0] = d.amp.x; mo.amp[1] = d.amp.y; mo.amp[2] = d.amp.z;
+        mo.freq = d.freq;
+        mo.phase = d.phase;
+        mo.period = d.period;
+        mo.loop = d.loop ? 1 : 0;
+        mo.keyBegin = (int32_t)keys.size();
+        mo.keyCount = (int32_t)d.keys.size();
+        keys.insert(keys.end(), d.keys.begin(), d.keys.end());
+        motions.push_back(mo);
+    }
+
+    // kind ̃ev[g SaveJson Ɠo^ς݂̂̑S
+    int kindIds[512];
+    const int kindTotal = Cube_GetKindList(kindIds, 512);
+    std::vector<StageBinaryKind> kinds;
+    kinds.reserve((size_t)kindTotal);
+    for (int i = 0; i < kindTotal; ++i)
+    {
+        StageBinaryKind k{};
+        k.kind = kindIds[i];
+        if (Cube_TryGetKindTemplate(kindIds[i], k.tpl)) kinds.push_back(k);
+    }
+
+    Header h{};
+    std::memcpy(h.magic, BIN_MAGIC, 4);
+    h.version = STAGE_BINARY_VERSION;
+    h.blockCount = (uint32_t)n;
+    h.kindCount = (uint32_t)kinds.size();
+    h.motionCount = (uint32_t)motions.size();
+    h.keyCount = (uint32_t)keys.size();
+    h.sectionCount = STAGE_BIN_SECTION_COUNT;
+
+    std::vector<uint8_t> buf(sizeof(Header), 0);
+    AppendSection(buf, h, STAGE_BIN_KINDS, kinds);
+    AppendSection(buf, h, STAGE_BIN_BLOCK_KIND, kind);
+    AppendSection(buf, h, STAGE_BIN_BLOCK_TEX, tex);
+    AppendSection(buf, h, STAGE_BIN_BLOCK_ID, id);
+    AppendSection(buf, h, STAGE_BIN_POSITION, position);
+    AppendSection(buf, h, STAGE_BIN_SIZE, size);
+    AppendSection(buf, h, STAGE_BIN_ROTATION, rotation);
+    AppendSection(buf, h, STAGE_BIN_WORLD, world);
+    for (int a = 0; a < 6; ++a)
+        AppendSection(buf, h, STAGE_BIN_AABB_MIN_X + a, aabb[a]);
+    AppendSection(buf, h, STAGE_BIN_MOTIONS, motions);
+    AppendSection(buf, h, STAGE_BIN_MOTION_KEYS, keys);
+
+    h.fileSize = (uint32_t)buf.size();
+    std::memcpy(buf.data(), &h, sizeof(Header));
+
+    // ̃t@Cǂ܂Ȃ悤AʖŏĂu
+    const std::string tmp = std::string(path) + ".tmp";
+    {
+        std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write(reinterpret_cast<const char*>(buf.data()), (std::streamsize)buf.size());
+        if (!ofs) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool StageBinary_Compile(const char* jsonPath, const char* binPath)
+{
+    if (!Stage01_LoadJson(jsonPath)) return false;
+    return StageBinary_Write(binPath);
+}
+
+void StageBinary_MakePath(const char* jsonPath, char* out, size_t outSize)
+{
+    if (!out || outSize == 0) return;
+    out[0] = '\0';
+    if (!jsonPath) return;
+
+    const char* dot = std::strrchr(jsonPath, '.');
+    const char* slash = std::strrchr(jsonPath, '/');
+    const char* backslash = std::strrchr(jsonPath, '\\');
+    if (backslash > slash) slash = backslash;
+    const size_t stem = (dot && (!slash || dot > slash)) ? (size_t)(dot - jsonPath) : std::strlen(jsonPath);
+
+    std::snprintf(out, outSize, "%.*s.bin", (int)stem, jsonPath);
+}
+
+bool StageBinary_IsUpToDate(const char* binPath, const char* jsonPath)
+{
+    if (!binPath || !binPath[0]) return false;
+
+    std::error_code ec;
+    const auto binTime = std::filesystem::last_write_time(binPath, ec);
+    if (ec) return false;
+    if (!jsonPath || !jsonPath[0]) return true;
+
+    const auto jsonTime = std::filesystem::last_write_time(jsonPath, ec);
+    if (ec) return true; // json Ȃ bin g
+    return binTime >= jsonTime;
+}
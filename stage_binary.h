@@ -0,0 +1,118 @@
+/*==============================================================================
+
+@@  Xe[W̃oCi[stage_binary.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/16
+--------------------------------------------------------------------------------
+@@Xe[W JSON û܂܎g`vɏói.binjB
+@@JSON ̉͂ Bake Ȃ̂ŁA[h̓t@C}bvĔzʂB
+@@t@C`igGfBAAeZNV 16 oCgEj
+@@  "LMSB" u32 version u32 fileSize
+@@  u32 blockCount u32 kindCount u32 motionCount u32 keyCount
+@@  u32 sectionCount, (u32 offset u32 size) x sectionCount
+@@  ZNV StageBinarySection ̏F
+@@    KINDS        (i32 kind, CubeTemplate) x kindCount
+@@    KIND/TEX/ID  i32 x blockCount
+@@    POSITION/SIZE/ROTATION   f32x3 x blockCountiJSON ̒lj
+@@    WORLD        f32x16 x blockCountiBake ς݁j
+@@    AABB_MIN_X .. AABB_MAX_Z f32 x blockCountiBake ς݁B蔻 SoA Ɠсj
+@@    MOTIONS      StageBinaryMotion x motionCount
+@@    MOTION_KEYS  (f32 time, f32x3 value) x keyCount
+@@u[htF[YiObh̃nbV\Ec[j̓|C^̉Ȃ̂œȂB
+@@[h AABB 蒼iubNɔႷ邾ŌyjB
+==============================================================================*/
+#ifndef STAGE_BINARY_H
+#define STAGE_BINARY_H
+
+#include "stage_cube.h"
+#include "stage_motion.h"
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+
+constexpr uint32_t STAGE_BINARY_VERSION = 2;   // 2: BLOCK_ID ǉ
+
+enum StageBinarySection : uint32_t
+{
+    STAGE_BIN_KINDS = 0,
+    STAGE_BIN_BLOCK_KIND,
+    STAGE_BIN_BLOCK_TEX,
+    STAGE_BIN_BLOCK_ID,
+    STAGE_BIN_POSITION,
+    STAGE_BIN_SIZE,
+    STAGE_BIN_ROTATION,
+    STAGE_BIN_WORLD,
+    STAGE_BIN_AABB_MIN_X,
+    STAGE_BIN_AABB_MIN_Y,
+    STAGE_BIN_AABB_MIN_Z,
+    STAGE_BIN_AABB_MAX_X,
+    STAGE_BIN_AABB_MAX_Y,
+    STAGE_BIN_AABB_MAX_Z,
+    STAGE_BIN_MOTIONS,
+    STAGE_BIN_MOTION_KEYS,
+
+    STAGE_BIN_SECTION_COUNT
+};
+
+struct StageBinaryKind
+{
+    int32_t kind;
+    CubeTemplate tpl;
+};
+
+// StageMotionDesc ̃L[ȊOiL[ MOTION_KEYS  keyBegin  keyCount j
+struct StageBinaryMotion
+{
+    int32_t block;
+    int32_t type;
+    int32_t target;
+    int32_t trigger;
+    float amp[3];
+    float freq;
+    float phase;
+    float period;
+    int32_t loop;
+    int32_t keyBegin;
+    int32_t keyCount;
+};
+
+// }bvt@C̒𒼐ڎwBStageBinary_Close ܂ŗLB
+// view Ƃɕʂ̃}bvȂ̂ŁAʃXbhŕʂ view JĂ悢
+struct StageBinaryView
+{
+    int blockCount = 0;
+    int kindCount = 0;
+    int motionCount = 0;
+    int keyCount = 0;
+
+    const StageBinaryKind* kinds = nullptr;
+    const int32_t* kind = nullptr;
+    const int32_t* texSlot = nullptr;
+    const int32_t* id = nullptr;
+    const DirectX::XMFLOAT3* position = nullptr;
+    const DirectX::XMFLOAT3* size = nullptr;
+    const DirectX::XMFLOAT3* rotation = nullptr;
+    const DirectX::XMFLOAT4X4* world = nullptr;
+    const float* aabbMin[3] = {};   // x, y, z
+    const float* aabbMax[3] = {};
+    const StageBinaryMotion* motions = nullptr;
+    const StageMotionKey* keys = nullptr;
+
+    void* mapping = nullptr;        // StageBinary_Close ŕ
+};
+
+// ǂݍ݁i`ETCYȂ false ŉJȂj
+bool StageBinary_Open(const char* path, StageBinaryView* out);
+void StageBinary_Close(StageBinaryView* view);
+
+// ǂݍłXe[WiStage01jo
+bool StageBinary_Write(const char* path);
+// JSON ǂ .bin ɂĩXe[W͂ JSON ɒuj
+bool StageBinary_Compile(const char* jsonPath, const char* binPath);
+
+// "stage_simple.json" -> "stage_simple.bin"igqΕtj
+void StageBinary_MakePath(const char* jsonPath, char* out, size_t outSize);
+// bin  json Vijson Ƃ bin  truej
+bool StageBinary_IsUpToDate(const char* binPath, const char* jsonPath);
+
+#endif // STAGE_BINARY_H
@@ -9,14 +9,20 @@
 #include "stage_cube.h"
 
 #include "direct3d.h"
+#include "texture.h"
+#ifndef SIM_HEADLESS
 #include "shader3d.h"
 #include "shader_depth.h"
-#include "texture.h"
+#include "render_queue.h"
+#endif
 
 #include <DirectXMath.h>
+#include <algorithm>
 #include <cfloat>
 #include <cstring>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace DirectX;
 
@@ -48,6 +54,17 @@ struct KindGpu
 
 static std::unordered_map<int, KindGpu> g_kinds;
 
+// ===== CX^X` =====
+static constexpr UINT INSTANCE_BUFFER_MIN = 256;
+
+static ID3D11Buffer* g_pInstanceBuffer = nullptr;
+static UINT g_instanceCapacity = 0;
+
+static std::vector<std::pair<uint64_t, int>> g_batchOrder; // (key, ͂̓Y)
+static std::vector<CubeBatch> g_batches;
+static std::vector<XMFLOAT4X4> g_batchWorlds;
+static CubeDrawStats g_drawStats{};
+
 static void buildVerticesFromTemplate(
     const CubeTemplate& tpl,
     std::array<Vertex3d, CUBE_VERTEX_COUNT>& outVerts,
@@ -68,8 +85,13 @@ static void buildVerticesFromTemplate(
     }
 }
 
+// SIM_HEADLESSiLinux̃V~[VprhjłGPUG炸Aނ̃ev[g
 static ID3D11Buffer* createDynamicVertexBuffer(const void* initialData, size_t byteSize)
 {
+#ifdef SIM_HEADLESS
+    (void)initialData; (void)byteSize;
+    return nullptr;
+#else
     if (!g_pDevice) return nullptr;
 
     D3D11_BUFFER_DESC bd{};
@@ -84,7 +106,46 @@ static ID3D11Buffer* createDynamicVertexBuffer(const void* initialData, size_t b
     ID3D11Buffer* vb = nullptr;
     g_pDevice->CreateBuffer(&bd, &sd, &vb);
     return vb;
+#endif
+}
+
+static void releaseBuffer(ID3D11Buffer*& buffer)
+{
+#ifdef SIM_HEADLESS
+    buffer = nullptr;
+#else
+    SAFE_RELEASE(buffer);
+#endif
+}
+
+#ifndef SIM_HEADLESS
+// Ȃ2{L΂č蒼
+static bool ensureInstanceBuffer(UINT count)
+{
+    if (!g_pDevice) return false;
+    if (g_pInstanceBuffer && count <= g_instanceCapacity) return true;
+
+    UINT capacity = g_instanceCapacity ? g_instanceCapacity : INSTANCE_BUFFER_MIN;
+    while (capacity < count) capacity *= 2;
+
+    releaseBuffer(g_pInstanceBuffer);
+
+    D3D11_BUFFER_DESC bd{};
+    bd.Usage = D3D11_USAGE_DYNAMIC;
+    bd.ByteWidth = static_cast<UINT>(sizeof(XMFLOAT4X4) * capacity);
+    bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    if (FAILED(g_pDevice->CreateBuffer(&bd, nullptr, &g_pInstanceBuffer)))
+    {
+        g_pInstanceBuffer = nullptr;
+        g_instanceCapacity = 0;
+        return false;
+    }
+    g_instanceCapacity = capacity;
+    return true;
 }
+#endif
 
 static KindGpu* findKind(int kind)
 {
@@ -99,6 +160,9 @@ static KindGpu* findKind(int kind)
 
 static void drawKindInternal(int kind, int texId, const XMMATRIX& world, bool depth)
 {
+#ifdef SIM_HEADLESS
+    (void)kind; (void)texId; (void)world; (void)depth;
+#else
     KindGpu* k = findKind(kind);
     if (!k || !k->vb || !g_pIndexBuffer) return;
 
@@ -126,6 +190,7 @@ static void drawKindInternal(int kind, int texId, const XMMATRIX& world, bool de
     Texture_SetTexture(texId);
 
     g_pContext->DrawIndexed(NUM_INDEX, 0, 0);
+#endif
 }
 
 CubeTemplate CubeTemplate_Unit()
@@ -191,7 +256,9 @@ void CubeTemplate_SetFaceColor(CubeTemplate& t, CubeFace face, const XMFLOAT4& c
 
 void Cube_RegisterKind(int kind, const CubeTemplate& tpl)
 {
+#ifndef SIM_HEADLESS
     if (!g_pDevice || !g_pContext) return;
+#endif
 
     std::array<Vertex3d, CUBE_VERTEX_COUNT> verts{};
     std::array<XMFLOAT3, CUBE_VERTEX_COUNT> pos{};
@@ -200,7 +267,7 @@ void Cube_RegisterKind(int kind, const CubeTemplate& tpl)
     auto& k = g_kinds[kind];
     if (k.vb)
     {
-        SAFE_RELEASE(k.vb);
+        releaseBuffer(k.vb);
     }
 
     k.vb = createDynamicVertexBuffer(verts.data(), sizeof(Vertex3d) * verts.size());
@@ -210,6 +277,14 @@ void Cube_RegisterKind(int kind, const CubeTemplate& tpl)
 
 void Cube_UpdateKind(int kind, const CubeTemplate& tpl)
 {
+#ifdef SIM_HEADLESS
+    auto it = g_kinds.find(kind);
+    if (it == g_kinds.end())
+    {
+        Cube_RegisterKind(kind, tpl);
+        return;
+    }
+#else
     if (!g_pDevice || !g_pContext) return;
 
     auto it = g_kinds.find(kind);
@@ -218,6 +293,7 @@ void Cube_UpdateKind(int kind, const CubeTemplate& tpl)
         Cube_RegisterKind(kind, tpl);
         return;
     }
+#endif
 
     KindGpu& k = it->second;
 
@@ -225,12 +301,14 @@ void Cube_UpdateKind(int kind, const CubeTemplate& tpl)
     std::array<XMFLOAT3, CUBE_VERTEX_COUNT> pos{};
     buildVerticesFromTemplate(tpl, verts, pos);
 
+#ifndef SIM_HEADLESS
     D3D11_MAPPED_SUBRESOURCE ms{};
     if (SUCCEEDED(g_pContext->Map(k.vb, 0, D3D11_MAP_WRITE_DISCARD, 0, &ms)))
     {
         memcpy(ms.pData, verts.data(), sizeof(Vertex3d) * verts.size());
         g_pContext->Unmap(k.vb, 0);
     }
+#endif
 
     k.tpl = tpl;
     k.localPos = pos;
@@ -306,6 +384,223 @@ void Cube_DepthDrawBlock(const CubeBlock& block)
     drawKindInternal(block.kind, block.texId, world, true);
 }
 
+// ===== CX^X` =====
+uint64_t Cube_MakeBatchKey(int kind, int texId)
+{
+    // t̂܂܏/32bitցi-1 ӂȃL[ɂȂj
+    return (static_cast<uint64_t>(static_cast<uint32_t>(kind)) << 32) |
+        static_cast<uint64_t>(static_cast<uint32_t>(texId));
+}
+
+int Cube_BuildBatches(const CubeInstance* instances, int count)
+{
+    g_batchOrder.clear();
+    g_batches.clear();
+    g_batchWorlds.clear();
+    if (!instances || count <= 0) return 0;
+
+    g_batchOrder.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const int texId = (instances[i].texId < 0) ? g_defaultTexId : instances[i].texId;
+        g_batchOrder.emplace_back(Cube_MakeBatchKey(instances[i].kind, texId), i);
+    }
+
+    // Yrɓ̂ŁAL[͓͏̂܂
+    std::sort(g_batchOrder.begin(), g_batchOrder.end());
+
+    g_batchWorlds.reserve(count);
+    for (const auto& e : g_batchOrder)
+    {
+        const CubeInstance& in = instances[e.second];
+        if (g_batches.empty() || g_batches.back().key != e.first)
+        {
+            CubeBatch b{};
+            b.key = e.first;
+            b.kind = in.kind;
+            b.texId = (in.texId < 0) ? g_defaultTexId : in.texId;
+            b.first = static_cast<int>(g_batchWorlds.size());
+            g_batches.push_back(b);
+        }
+        g_batchWorlds.push_back(in.world);
+        ++g_batches.back().count;
+    }
+
+    return static_cast<int>(g_batches.size());
+}
+
+int Cube_GetBatchCount()
+{
+    return static_cast<int>(g_batches.size());
+}
+
+const CubeBatch* Cube_GetBatches()
+{
+    return g_batches.data();
+}
+
+const XMFLOAT4X4* Cube_GetBatchWorlds()
+{
+    return g_batchWorlds.data();
+}
+
+static void drawInstancesInternal(const CubeInstance* instances, int count, bool depth)
+{
+    g_drawStats = CubeDrawStats{};
+    const int batchCount = Cube_BuildBatches(instances, count);
+    g_drawStats.instances = (count > 0) ? count : 0;
+    g_drawStats.batches = batchCount;
+    if (batchCount == 0) return;
+
+#ifdef SIM_HEADLESS
+    (void)depth;
+    g_drawStats.drawCalls = batchCount;
+    g_drawStats.instanced = true;
+#else
+    const bool begun = depth ? ShaderDepth_BeginInstanced() : Shader3D_BeginInstanced();
+    if (!begun || !g_pIndexBuffer || !ensureInstanceBuffer(static_cast<UINT>(g_batchWorlds.size())))
+    {
+        // CX^X`悪gȂƂ1iт͂܂Ƃ߂Ȃ̂ŃeNX`̐؂ւ͌j
+        for (const CubeBatch& b : g_batches)
+        {
+            for (int i = 0; i < b.count; ++i)
+            {
+                drawKindInternal(b.kind, b.texId, XMLoadFloat4x4(&g_batchWorlds[b.first + i]), depth);
+            }
+        }
+        g_drawStats.drawCalls = static_cast<int>(g_batchWorlds.size());
+        return;
+    }
+
+    // [hs͍sxNg`̂܂܁iVF[_[ WORLD0`3 sƂđgށj
+    D3D11_MAPPED_SUBRESOURCE ms{};
+    if (FAILED(g_pContext->Map(g_pInstanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &ms))) return;
+    memcpy(ms.pData, g_batchWorlds.data(), sizeof(XMFLOAT4X4) * g_batchWorlds.size());
+    g_pContext->Unmap(g_pInstanceBuffer, 0);
+
+    g_pContext->IASetIndexBuffer(g_pIndexBuffer, DXGI_FORMAT_R16_UINT, 0);
+    g_pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    if (!depth) Shader3d_SetColor({ 1,1,1,1 });
+
+    const UINT strides[2] = { sizeof(Vertex3d), sizeof(XMFLOAT4X4) };
+    const UINT offsets[2] = { 0, 0 };
+    int boundKind = INT32_MIN;
+    int boundTex = INT32_MIN;
+
+    for (const CubeBatch& b : g_batches)
+    {
+        KindGpu* k = findKind(b.kind);
+        if (!k || !k->vb) continue;
+
+        if (b.kind != boundKind)
+        {
+            ID3D11Buffer* vbs[2] = { k->vb, g_pInstanceBuffer };
+            g_pContext->IASetVertexBuffers(0, 2, vbs, strides, offsets);
+            boundKind = b.kind;
+        }
+        if (!depth && b.texId != boundTex)
+        {
+            Texture_SetTexture(b.texId);
+            boundTex = b.texId;
+        }
+
+        g_pContext->DrawIndexedInstanced(NUM_INDEX, static_cast<UINT>(b.count), 0, 0, static_cast<UINT>(b.first));
+        ++g_drawStats.drawCalls;
+    }
+    g_drawStats.instanced = true;
+#endif
+}
+
+#ifndef SIM_HEADLESS
+// `L[Ă΂BVF[_[ƃeNX`̓L[ݒς
+// param  1 ȂCX^X`悪gȂ̂ŁA1[hsĕ`
+static void drawBatchCommand(const void* data, int param)
+{
+    const CubeBatch& b = *static_cast<const CubeBatch*>(data);
+    KindGpu* k = findKind(b.kind);
+    if (!k || !k->vb) return;
+
+    g_pContext->IASetIndexBuffer(g_pIndexBuffer, DXGI_FORMAT_R16_UINT, 0);
+    g_pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    Shader3d_SetColor({ 1,1,1,1 });
+
+    if (param != 0)
+    {
+        const UINT stride = sizeof(Vertex3d);
+        const UINT offset = 0;
+        g_pContext->IASetVertexBuffers(0, 1, &k->vb, &stride, &offset);
+        for (int i = 0; i < b.count; ++i)
+        {
+            Shader3D_SetWorldMatrix(XMLoadFloat4x4(&g_batchWorlds[b.first + i]));
+            g_pContext->DrawIndexed(NUM_INDEX, 0, 0);
+        }
+        return;
+    }
+
+    const UINT strides[2] = { sizeof(Vertex3d), sizeof(XMFLOAT4X4) };
+    const UINT offsets[2] = { 0, 0 };
+    ID3D11Buffer* vbs[2] = { k->vb, g_pInstanceBuffer };
+    g_pContext->IASetVertexBuffers(0, 2, vbs, strides, offsets);
+    g_pContext->DrawIndexedInstanced(NUM_INDEX, static_cast<UINT>(b.count), 0, 0, static_cast<UINT>(b.first));
+}
+#endif
+
+void Cube_SubmitInstances(const CubeInstance* instances, int count)
+{
+    g_drawStats = CubeDrawStats{};
+    const int batchCount = Cube_BuildBatches(instances, count);
+    g_drawStats.instances = (count > 0) ? count : 0;
+    g_drawStats.batches = batchCount;
+    if (batchCount == 0) return;
+
+#ifdef SIM_HEADLESS
+    g_drawStats.drawCalls = batchCount;
+    g_drawStats.instanced = true;
+#else
+    if (!g_pIndexBuffer) return;
+
+    // [hs͐ςނƂɋl߂ĂiL[ Execute ܂ŏȂj
+    bool instanced = Shader3D_CanInstance() && ensureInstanceBuffer(static_cast<UINT>(g_batchWorlds.size()));
+    if (instanced)
+    {
+        D3D11_MAPPED_SUBRESOURCE ms{};
+        instanced = SUCCEEDED(g_pContext->Map(g_pInstanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &ms));
+        if (instanced)
+        {
+            memcpy(ms.pData, g_batchWorlds.data(), sizeof(XMFLOAT4X4) * g_batchWorlds.size());
+            g_pContext->Unmap(g_pInstanceBuffer, 0);
+        }
+    }
+
+    const RenderShader shader = instanced ? RENDER_SHADER_3D_INSTANCED : RENDER_SHADER_3D;
+    for (const CubeBatch& b : g_batches)
+    {
+        KindGpu* k = findKind(b.kind);
+        if (!k || !k->vb) continue;
+
+        RenderQueue_SubmitCopy(RenderQueue_MakeKey(RENDER_PASS_OPAQUE, shader, b.texId, 0.0f),
+            drawBatchCommand, &b, sizeof(b), instanced ? 0 : 1);
+        g_drawStats.drawCalls += instanced ? 1 : b.count;
+    }
+    g_drawStats.instanced = instanced;
+#endif
+}
+
+void Cube_DrawInstances(const CubeInstance* instances, int count)
+{
+    drawInstancesInternal(instances, count, false);
+}
+
+void Cube_DepthDrawInstances(const CubeInstance* instances, int count)
+{
+    drawInstancesInternal(instances, count, true);
+}
+
+const CubeDrawStats& Cube_GetDrawStats()
+{
+    return g_drawStats;
+}
+
 static CubeTemplate makeLegacyTemplate()
 {
     CubeTemplate t = CubeTemplate_Unit();
@@ -377,6 +672,7 @@ void Cube_Initialize(ID3D11Device* pDevice, ID3D11DeviceContext* pContext)
     g_pDevice = pDevice;
     g_pContext = pContext;
 
+#ifndef SIM_HEADLESS
     D3D11_BUFFER_DESC bd{};
     bd.Usage = D3D11_USAGE_DEFAULT;
     bd.ByteWidth = sizeof(unsigned short) * NUM_INDEX;
@@ -386,6 +682,7 @@ void Cube_Initialize(ID3D11Device* pDevice, ID3D11DeviceContext* pContext)
     sd.pSysMem = g_CubeIndex;
 
     g_pDevice->CreateBuffer(&bd, &sd, &g_pIndexBuffer);
+#endif
 
     g_defaultTexId = Texture_Load(L"white.png");
 
@@ -402,11 +699,13 @@ void Cube_Finalize()
 {
     for (auto& kv : g_kinds)
     {
-        SAFE_RELEASE(kv.second.vb);
+        releaseBuffer(kv.second.vb);
     }
     g_kinds.clear();
 
-    SAFE_RELEASE(g_pIndexBuffer);
+    releaseBuffer(g_pIndexBuffer);
+    releaseBuffer(g_pInstanceBuffer);
+    g_instanceCapacity = 0;
 }
 
 void Cube_Update(double)
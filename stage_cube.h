@@ -14,6 +14,7 @@
 #include <d3d11.h>
 #include <DirectXMath.h>
 #include <array>
+#include <cstdint>
 
 struct Vertex3d
 {
@@ -102,6 +103,49 @@ void Cube_DrawBlock(const CubeBlock& block);
 
 void Cube_DepthDrawBlock(const CubeBlock& block);
 
+// ===== CX^X` =====
+// (kind, texId) Ƃɂ܂Ƃ߂ă[hsCX^Xobt@ɋl߁A
+// 1O[v1 DrawIndexedInstanced ŕ`B
+// ܂Ƃ߂鏈GPUGȂ̂ SIM_HEADLESS łi`悾΂j
+struct CubeInstance
+{
+    int kind = 0;
+    int texId = -1;
+    DirectX::XMFLOAT4X4 world{};
+};
+
+struct CubeBatch
+{
+    uint64_t key = 0;   // Cube_MakeBatchKey(kind, texId)
+    int kind = 0;
+    int texId = -1;     // eNX`ς
+    int first = 0;      // Cube_GetBatchWorlds() ̐擪
+    int count = 0;
+};
+
+struct CubeDrawStats
+{
+    int instances = 0;
+    int batches = 0;
+    int drawCalls = 0;  // ۂɔsiwbhXł͔s͂́j`施ߐ
+    bool instanced = false;
+};
+
+uint64_t Cube_MakeBatchKey(int kind, int texId);
+
+// L[iL[͓͏jɕׂĂ܂Ƃ߂B߂l̓ob`
+int Cube_BuildBatches(const CubeInstance* instances, int count);
+int Cube_GetBatchCount();
+const CubeBatch* Cube_GetBatches();
+const DirectX::XMFLOAT4X4* Cube_GetBatchWorlds();
+
+void Cube_DrawInstances(const CubeInstance* instances, int count);
+void Cube_DepthDrawInstances(const CubeInstance* instances, int count);
+// `L[Ƀob`1ςށiL[ RENDER_PASS_OPAQUE Ǝۂ̃VF[_[EeNX`jB
+// s͂ŋl߂̂ŁAL[ Execute ܂łɑ Cube_*Instances Ă΂Ȃ
+void Cube_SubmitInstances(const CubeInstance* instances, int count);
+const CubeDrawStats& Cube_GetDrawStats();   // ߂ Cube_(Depth)DrawInstances / Cube_SubmitInstances
+
 void Cube_Initialize(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
 void Cube_Finalize();
 void Cube_Update(double elapsedTime);
@@ -31,12 +31,14 @@
 #include"map_camera.h"
 #include"light_camera.h"
 #include"stage01_manage.h"
+#include "trigger_volume.h"
 #include "imgui_manager.h"
 #include "imgui.h"
 #include"item.h"
 #include"sky.h"
 #include "goal.h"
 #include"Audio.h"
+#include "asset_cache.h"
 #include <type_traits>
 #include <utility>
 #include <cmath>
@@ -44,8 +46,11 @@
 
 using namespace DirectX;
 
+static AssetHandle g_disBgmAsset;
 static int disBgm = -1;
 
+// p^[̓Av̏I܂ŎĉŁAeNX`ŏɓǂ񂾂̂
+static AssetHandle g_testTexAsset;
 static int testTex = -1;
 static int g_animId = -1;
 static int g_animPlayId = -1;
@@ -183,12 +188,15 @@ void StageDisapearManager_Initialize(const StageInfo& info)
 	Sky_Initialize();
 	//Billboard_Initialize();
 	//BulletHitEffect_Initialize();
-	testTex = Texture_Load(L"runningman001.png");
-	g_animId = SpriteAnim_RegisterPattern(testTex, 10, 5, 0.1, { 140,200 }, { 0,0, });
+	if (!Asset_IsValid(g_testTexAsset))
+	{
+		g_testTexAsset = Asset_LoadTexture(L"runningman001.png");
+		testTex = Asset_GetTexture(g_testTexAsset);
+		g_animId = SpriteAnim_RegisterPattern(testTex, 10, 5, 0.1, { 140,200 }, { 0,0, });
+		g_animPlayId = SpriteAnim_CreatePlayer(g_animId);
+	}
 	LightCamera_Initialize({ -1.0f,-1.0f,1.0f }, { 0.0f,20.0f,-0.0f });
 
-	g_animPlayId = SpriteAnim_CreatePlayer(g_animId);
-
 	//Enemy_Create({ 1.0f,0.0f,1.0f });
 	//Enemy_Create({ 1.0f,5.0f,1.0f });
 
@@ -198,6 +206,7 @@ void StageDisapearManager_Initialize(const StageInfo& info)
 
 	Stage01_Initialize(g_stageJsonPath);
 	Goal_Init();
+	StageDisapear_Initialize();
 	Goal_SetPosition({ 0.0f, 0.0f,-100.0f });
 
 	/*Item_Initialize();
@@ -208,7 +217,8 @@ void StageDisapearManager_Initialize(const StageInfo& info)
 	Item_Add({ 0.0f, 0.8f, 0.0f }, { 0.0f, 0.0f, 0.0f }, musicNoteModel);
 	*/
 
-	disBgm = LoadAudio("title.wav");
+	g_disBgmAsset = Asset_LoadAudio("title.wav");
+	disBgm = Asset_GetAudio(g_disBgmAsset);
 	PlayAudio(disBgm, true);
 
 }
@@ -221,7 +231,8 @@ void StageDisapearManager_ChangeStage(const StageInfo& info)
 
 void StageDisapearManager_Finalize()
 {
-	UnloadAudio(disBgm);
+	Asset_Release(&g_disBgmAsset);
+	disBgm = -1;
 	Goal_Uninit();
 	//BulletHitEffect_Finalize();
 		//Enemy_Finalize();
@@ -233,6 +244,7 @@ void StageDisapearManager_Finalize()
 
 
 
+	StageDisapear_Finalize();
 	Stage01_Finalize();
 	Item_Finalize();
 }
@@ -326,6 +338,9 @@ void StageDisapearManager_Update(double elapsedTime)
 	Player_Update(elapsedTime);
 	PlayerCamera_Update(elapsedTime);
 
+	// S[EACeEȂǂ̗̈i^oƂĂ΂j
+	TriggerVolume_Update(Player_GetAABB());
+
 	Item_Update();
 
 	Goal_Update(elapsedTime);
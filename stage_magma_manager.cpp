@@ -30,12 +30,16 @@
 #include"map_camera.h"
 #include"light_camera.h"
 #include"stage01_manage.h"
+#include "trigger_volume.h"
 #include "imgui_manager.h"
 #include "imgui.h"
 #include"item.h"
 #include"sky.h"
+#include "render_queue.h"
+#include "culling.h"
 #include"goal.h"
 #include"Audio.h"
+#include "asset_cache.h"
 #include <type_traits>
 #include <utility>
 #include <cmath>
@@ -43,8 +47,13 @@
 
 using namespace DirectX;
 
+static constexpr const char* kBgmPath = "magma.wav";
+static constexpr const wchar_t* kAnimTexPath = L"runningman001.png";
+static AssetHandle g_magmaBgmAsset;
 static int magmaBgm = -1;
 
+// p^[̓Av̏I܂ŎĉŁAeNX`ŏɓǂ񂾂̂
+static AssetHandle g_testTexAsset;
 static int testTex = -1;
 static int g_animId = -1;
 static int g_animPlayId = -1;
@@ -151,6 +160,9 @@ static void lightRendering() {
 	// JɊւsVF[_[ɐݒ肷
 	Camera_SetMatrix(view, proj);
 
+	// e𗎂Ƃ̂̓Cg̎Ő؂
+	Culling_SetView(CULL_VIEW_SHADOW, view, proj, { 0.0f, 0.0f, 0.0f });
+
 	ShaderDepth_SetViewMatrix(view);
 	ShaderDepth_SetProjectionMatrix(proj);
 
@@ -160,6 +172,7 @@ static void lightRendering() {
 	//LXg(e𗎂ƂIuWFNg)
 	//Enemy_DepthDraw();
 	Player_DepthDraw();
+	Stage01_DepthDraw();	// Cg̎ɓubN
 	//Map_Draw();
 }
 
@@ -193,6 +206,21 @@ float StageMagmaManager_GetMagmaBaseY()
 	}
 
 
+void StageMagmaManager_CollectAssets(AssetPrefetchList* list)
+{
+	if (!list) return;
+	Player_CollectAssets(list);
+	Sky_CollectAssets(list);
+	Stage01_CollectAssets(list);
+	// Goal_Init ǂނ
+	list->models.push_back("goal.fbx");
+	list->textures.push_back(L"stage_clear.png");
+	list->audio.push_back("clear.wav");
+
+	list->textures.push_back(kAnimTexPath);
+	list->audio.push_back(kBgmPath);
+}
+
 void StageMagmaManager_Initialize(const StageInfo& info)
 {
 	StageMagmaManager_SetStageInfo(info);
@@ -205,12 +233,15 @@ void StageMagmaManager_Initialize(const StageInfo& info)
 	Sky_Initialize();
 	//Billboard_Initialize();
 	//BulletHitEffect_Initialize();
-	testTex = Texture_Load(L"runningman001.png");
-	g_animId = SpriteAnim_RegisterPattern(testTex, 10, 5, 0.1, { 140,200 }, { 0,0, });
+	if (!Asset_IsValid(g_testTexAsset))
+	{
+		g_testTexAsset = Asset_LoadTexture(kAnimTexPath);
+		testTex = Asset_GetTexture(g_testTexAsset);
+		g_animId = SpriteAnim_RegisterPattern(testTex, 10, 5, 0.1, { 140,200 }, { 0,0, });
+		g_animPlayId = SpriteAnim_CreatePlayer(g_animId);
+	}
 	LightCamera_Initialize({ -1.0f,-1.0f,1.0f }, { 0.0f,20.0f,-0.0f });
 
-	g_animPlayId = SpriteAnim_CreatePlayer(g_animId);
-
 	//Enemy_Create({ 1.0f,0.0f,1.0f });
 	//Enemy_Create({ 1.0f,5.0f,1.0f });
 
@@ -218,9 +249,11 @@ void StageMagmaManager_Initialize(const StageInfo& info)
 
 	Stage01_Initialize(g_stageJsonPath);
 	Goal_Init();
+	StageMagma_Initialize();
 	Goal_SetPosition({ 6.0f, 22.0f, 42.0f });
 
-	magmaBgm = LoadAudio("magma.wav");
+	g_magmaBgmAsset = Asset_LoadAudio(kBgmPath);
+	magmaBgm = Asset_GetAudio(g_magmaBgmAsset);
 	PlayAudio(magmaBgm, true);
 
 }
@@ -233,7 +266,8 @@ void StageMagmaManager_ChangeStage(const StageInfo& info)
 
 void StageMagmaManager_Finalize()
 {
-	UnloadAudio(magmaBgm);
+	Asset_Release(&g_magmaBgmAsset);
+	magmaBgm = -1;
 	Goal_Uninit();
 	//BulletHitEffect_Finalize();
 		//Enemy_Finalize();
@@ -245,6 +279,7 @@ void StageMagmaManager_Finalize()
 
 
 
+	StageMagma_Finalize();
 	Stage01_Finalize();
 	Item_Finalize();
 }
@@ -347,6 +382,9 @@ void StageMagmaManager_Update(double elapsedTime)
 	Player_Update(elapsedTime);
 	PlayerCamera_Update(elapsedTime);
 
+	// S[EACeEȂǂ̗̈i^oƂĂ΂j
+	TriggerVolume_Update(Player_GetAABB());
+
 	Item_Update();
 
 	Goal_Update(elapsedTime);
@@ -416,6 +454,9 @@ void StageMagmaManager_Draw()
 	//JɊւsVF[_ɐݒ肷
 	Camera_SetMatrix(view, proj);
 
+	// Xe[WEACeEr{[h̕`OJO
+	Culling_SetView(CULL_VIEW_CAMERA, view, proj, camera_position, CULL_DEFAULT_DRAW_DISTANCE);
+
 	//
 	//ShaderBillboard_SetViewMatrix(view);
 	//ShaderBillboard_SetProjectionMatrix(proj);
@@ -424,10 +465,12 @@ void StageMagmaManager_Draw()
 	//eNX`Tv[̐ݒ
 	Sampler_SetFilterAnisotropic();
 
+	// ͕`L[ɐςŁAŌɃ\[gĂ܂Ƃ߂ĕ`
+	RenderQueue_Begin();
+	const XMFLOAT3 cameraFront = { mtxView._13, mtxView._23, mtxView._33 };
+
 	//̕\
-	Direct3D_SetDepthDepthWriteDisable();
-	Sky_Draw();
-	Direct3D_SetDepthEnable(true);
+	Sky_Submit();
 
 	//e탉Cg̐ݒ
 	float ambientColor = 0.8f;
@@ -462,7 +505,12 @@ void StageMagmaManager_Draw()
 	float w2_offset = MeshField_GetHalf(); 
 	W2 = XMMatrixTranslation(-w2_offset, meshFieldPosY, -w2_offset+45.0f);
 	Direct3D_SetDepthShadowTexture(2);
-	MeshField_Draw(W2);
+	RenderQueue_Submit(RenderQueue_MakeKey(RENDER_PASS_OPAQUE, RENDER_SHADER_NONE, -1, 0.0f),
+		[](const void* data, int) {
+			XMMATRIX world = *static_cast<const XMMATRIX*>(data);
+			MeshField_Draw(world);
+		},
+		&W2, 0, RENDER_CMD_BINDS_OWN_STATE);
 
 	/*Sampler_SetFilterAnisotropic();
 	XMMATRIX theWorld = XMMatrixTranslation(3.0f, 0.5f, 2.0f);
@@ -472,8 +520,9 @@ void StageMagmaManager_Draw()
 
 
 	//Enemy_Draw();
-	Player_Draw();
-	Goal_Draw3D();
+	Player_Submit(RenderQueue_ViewDepth(camera_position, cameraFront, Player_GetPosition()));
+	RenderQueue_Submit(RenderQueue_MakeKey(RENDER_PASS_OPAQUE, RENDER_SHADER_NONE, -1, 0.0f),
+		[](const void*, int) { Goal_Draw3D(); }, nullptr, 0, RENDER_CMD_BINDS_OWN_STATE);
 	//Map_Draw();
 
 	//Bullet_Draw();
@@ -483,16 +532,19 @@ void StageMagmaManager_Draw()
 
 
 	if (g_isDebug) {
-		Camera_DebugDraw();
+		RenderQueue_Submit(RenderQueue_MakeKey(RENDER_PASS_OVERLAY, RENDER_SHADER_NONE, -1, 0.0f),
+			[](const void*, int) { Camera_DebugDraw(); }, nullptr, 0, RENDER_CMD_BINDS_OWN_STATE);
 	}
 
 
 
 
 
-	Camera_SetMatrix(view, proj);//Kv
-	Stage01_Draw();
-	Item_Draw();
+	Stage01_Submit();
+	Item_Submit(camera_position, cameraFront);
+
+	// fobO\̓I[o[CȂ̂ŁAXe[WɉiȑO Camera_SetMatrix Đݒ͕svj
+	RenderQueue_Execute();
 
 }
 
@@ -14,6 +14,9 @@
 #include <DirectXMath.h>
 
 void StageMagmaManager_Initialize(const StageInfo& info);
+// Initialize ǂރt@CiStageSystem ŐɃfR[hĂj
+struct AssetPrefetchList;
+void StageMagmaManager_CollectAssets(AssetPrefetchList* list);
 void StageMagmaManager_ChangeStage(const StageInfo& info);
 void StageMagmaManager_Finalize();
 void StageMagmaManager_Update(double elapsedTime);
@@ -0,0 +1,256 @@
+/*==============================================================================
+
+@@  Xe[WubN̓[stage_motion.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/13
+--------------------------------------------------------------------------------
+
+==============================================================================*/
+#include "stage_motion.h"
+#include "stage01_manage.h"
+#include <cmath>
+#include <cstring>
+
+using namespace DirectX;
+
+namespace
+{
+    // 1 gbNB][vŐĜl߂āAz 1 {Ŏ
+    // iL[ g_keys ɂ܂Ƃ߂ĒuA擪ƌj
+    struct Track
+    {
+        StageBlockHandle block;     // ubNꂽ疳ɂȂāAȌ͔΂
+        StageMotionType type;
+        StageMotionTarget target;
+        StageMotionTrigger trigger;
+
+        XMFLOAT3 amp;
+        float freq;
+        float phase;
+        float period;
+        int keyBegin;
+        int keyCount;
+        bool loop;
+
+        bool started;       // ON_RIDE ͏܂ false
+        float startTime;
+        XMFLOAT3 prev;      // Ot[܂łɑ
+    };
+
+    std::vector<Track> g_tracks;
+    std::vector<StageMotionKey> g_keys;
+    std::vector<StageMotionDelta> g_deltas;
+    float g_time = 0.0f;    // [ȟoߎ
+
+    XMFLOAT3 SampleKeys(const Track& tr, float t)
+    {
+        const StageMotionKey* keys = g_keys.data() + tr.keyBegin;
+        const int n = tr.keyCount;
+        if (n <= 0) return { 0,0,0 };
+        if (n == 1) return keys[0].value;
+
+        const float last = keys[n - 1].time;
+        if (tr.loop && last > 0.0f) t = std::fmod(t, last);
+        if (t <= keys[0].time) return keys[0].value;
+        if (t >= last) return keys[n - 1].value;
+
+        int k = 1;
+        while (k < n - 1 && keys[k].time < t) ++k;
+
+        const StageMotionKey& a = keys[k - 1];
+        const StageMotionKey& b = keys[k];
+        const float span = b.time - a.time;
+        const float u = (span > 0.0f) ? (t - a.time) / span : 1.0f;
+        return {
+            a.value.x + (b.value.x - a.value.x) * u,
+            a.value.y + (b.value.y - a.value.y) * u,
+            a.value.z + (b.value.z - a.value.z) * u
+        };
+    }
+
+    XMFLOAT3 EvaluateTrack(const Track& tr, float t)
+    {
+        float w = 0.0f;
+        switch (tr.type)
+        {
+        case STAGE_MOTION_LINEAR:
+            w = t;
+            break;
+        case STAGE_MOTION_SINE:
+            w = sinf(tr.freq * t + tr.phase);
+            break;
+        case STAGE_MOTION_PINGPONG:
+        {
+            if (tr.period <= 0.0f) break;
+            const float u = std::fmod(t / tr.period, 2.0f);
+            w = (u <= 1.0f) ? u : 2.0f - u;
+            break;
+        }
+        case STAGE_MOTION_KEYS:
+            return SampleKeys(tr, t);
+        }
+        return { tr.amp.x * w, tr.amp.y * w, tr.amp.z * w };
+    }
+
+    const char* const k_typeNames[] = { "linear", "sine", "pingpong", "keys" };
+    const char* const k_targetNames[] = { "position", "size", "rotation" };
+    const char* const k_triggerNames[] = { "always", "ride" };
+
+    template <typename E, int N>
+    bool ParseName(const char* name, const char* const (&names)[N], E* out)
+    {
+        if (!name) return false;
+        for (int i = 0; i < N; ++i)
+        {
+            if (std::strcmp(name, names[i]) == 0)
+            {
+                if (out) *out = (E)i;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+void StageMotion_Clear()
+{
+    g_tracks.clear();
+    g_keys.clear();
+    g_deltas.clear();
+    g_time = 0.0f;
+}
+
+void StageMotion_Restart()
+{
+    for (Track& tr : g_tracks)
+    {
+        tr.started = (tr.trigger == STAGE_MOTION_ALWAYS);
+        tr.startTime = 0.0f;
+        tr.prev = { 0,0,0 };
+    }
+    g_deltas.clear();
+    g_time = 0.0f;
+}
+
+int StageMotion_Add(int blockIndex, const StageMotionDesc& desc)
+{
+    const StageBlockHandle block = Stage01_GetHandle(blockIndex);
+    if (!Stage01_IsValid(block)) return -1;
+
+    Track tr{};
+    tr.block = block;
+    tr.type = desc.type;
+    tr.target = desc.target;
+    tr.trigger = desc.trigger;
+    tr.amp = desc.amp;
+    tr.freq = desc.freq;
+    tr.phase = desc.phase;
+    tr.period = desc.period;
+    tr.loop = desc.loop;
+    tr.keyBegin = (int)g_keys.size();
+    tr.keyCount = (int)desc.keys.size();
+    g_keys.insert(g_keys.end(), desc.keys.begin(), desc.keys.end());
+
+    // ē̂́Ao 0 ƂĐ
+    tr.started = (desc.trigger == STAGE_MOTION_ALWAYS);
+    tr.startTime = 0.0f;
+    tr.prev = { 0,0,0 };
+
+    g_tracks.push_back(tr);
+    return (int)g_tracks.size() - 1;
+}
+
+bool StageMotion_Find(int blockIndex, StageMotionDesc* outDesc)
+{
+    if (blockIndex < 0) return false;
+    for (const Track& tr : g_tracks)
+    {
+        if (Stage01_GetIndex(tr.block) != blockIndex) continue;
+        if (outDesc)
+        {
+            outDesc->type = tr.type;
+            outDesc->target = tr.target;
+            outDesc->trigger = tr.trigger;
+            outDesc->amp = tr.amp;
+            outDesc->freq = tr.freq;
+            outDesc->phase = tr.phase;
+            outDesc->period = tr.period;
+            outDesc->loop = tr.loop;
+            outDesc->keys.assign(g_keys.begin() + tr.keyBegin, g_keys.begin() + tr.keyBegin + tr.keyCount);
+        }
+        return true;
+    }
+    return false;
+}
+
+int StageMotion_GetCount()
+{
+    return (int)g_tracks.size();
+}
+
+void StageMotion_Evaluate(double elapsedTime, int rideBlock)
+{
+    g_time += (float)elapsedTime;
+
+    g_deltas.clear();
+    for (Track& tr : g_tracks)
+    {
+        // ubN̍̃CfbNXiStage01_Remove œւĂǂj
+        const int blockIndex = Stage01_GetIndex(tr.block);
+        if (blockIndex < 0) continue;
+
+        // ꂽ瓮o
+        if (!tr.started && blockIndex == rideBlock)
+        {
+            tr.started = true;
+            tr.startTime = g_time;
+        }
+        if (!tr.started) continue;
+
+        const XMFLOAT3 cur = EvaluateTrack(tr, g_time - tr.startTime);
+        const XMFLOAT3 d{ cur.x - tr.prev.x, cur.y - tr.prev.y, cur.z - tr.prev.z };
+        tr.prev = cur;
+
+        if (d.x == 0.0f && d.y == 0.0f && d.z == 0.0f) continue;
+        g_deltas.push_back({ blockIndex, tr.target, d });
+    }
+}
+
+int StageMotion_GetDeltas(const StageMotionDelta** outDeltas)
+{
+    if (outDeltas) *outDeltas = g_deltas.data();
+    return (int)g_deltas.size();
+}
+
+void StageMotion_Apply()
+{
+    const XMFLOAT3 zero{ 0,0,0 };
+    for (const StageMotionDelta& d : g_deltas)
+    {
+        switch (d.target)
+        {
+        case STAGE_MOTION_POSITION: Stage01_AddObjectTransform(d.blockIndex, d.delta, zero, zero); break;
+        case STAGE_MOTION_SIZE:     Stage01_AddObjectTransform(d.blockIndex, zero, d.delta, zero); break;
+        case STAGE_MOTION_ROTATION: Stage01_AddObjectTransform(d.blockIndex, zero, zero, d.delta); break;
+        }
+    }
+}
+
+const char* StageMotion_TypeName(StageMotionType type)
+{
+    return (type >= 0 && type <= STAGE_MOTION_KEYS) ? k_typeNames[type] : "sine";
+}
+
+const char* StageMotion_TargetName(StageMotionTarget target)
+{
+    return (target >= 0 && target <= STAGE_MOTION_ROTATION) ? k_targetNames[target] : "position";
+}
+
+const char* StageMotion_TriggerName(StageMotionTrigger trigger)
+{
+    return (trigger >= 0 && trigger <= STAGE_MOTION_ON_RIDE) ? k_triggerNames[trigger] : "always";
+}
+
+bool StageMotion_ParseType(const char* name, StageMotionType* out) { return ParseName(name, k_typeNames, out); }
+bool StageMotion_ParseTarget(const char* name, StageMotionTarget* out) { return ParseName(name, k_targetNames, out); }
+bool StageMotion_ParseTrigger(const char* name, StageMotionTrigger* out) { return ParseName(name, k_triggerNames, out); }
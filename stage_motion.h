@@ -0,0 +1,91 @@
+/*==============================================================================
+
+@@  Xe[WubN̓[stage_motion.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/13
+--------------------------------------------------------------------------------
+@@Xe[W JSON ̃ubNɏ "motion" ǂŁAubN
+@@܂Ƃ߂ēBt[SgbN 1 Ȃ߂āAOt[
+@@ωʁiStageMotionDeltajɍB
+@@  "motion":{"type":"sine","target":"position","amp":[0,3,0],"freq":1,"phase":0}
+@@  "motion":{"type":"linear","target":"position","amp":[0.4,-0.4,0],"trigger":"ride"}
+@@  "motion":{"type":"pingpong","target":"position","amp":[4,0,0],"period":2}
+@@  "motion":{"type":"keys","target":"rotation","keys":[[0,0,0,0],[1,0,3.14,0]],"loop":1}
+==============================================================================*/
+#ifndef STAGE_MOTION_H
+#define STAGE_MOTION_H
+
+#include <DirectXMath.h>
+#include <vector>
+
+enum StageMotionType : int
+{
+    STAGE_MOTION_LINEAR = 0,    // amp * tiamp  1 bj
+    STAGE_MOTION_SINE,          // amp * sin(freq * t + phase)
+    STAGE_MOTION_PINGPONG,      // 0  amp  0  period bŉ
+    STAGE_MOTION_KEYS,          // keys `ԁiloop ȂŌ̃L[̎ŌJԂj
+};
+
+enum StageMotionTarget : int
+{
+    STAGE_MOTION_POSITION = 0,
+    STAGE_MOTION_SIZE,
+    STAGE_MOTION_ROTATION,
+};
+
+enum StageMotionTrigger : int
+{
+    STAGE_MOTION_ALWAYS = 0,    // [hォ瓮
+    STAGE_MOTION_ON_RIDE,       // vC[瓮o
+};
+
+struct StageMotionKey
+{
+    float time = 0.0f;
+    DirectX::XMFLOAT3 value{ 0,0,0 };
+};
+
+struct StageMotionDesc
+{
+    StageMotionType type = STAGE_MOTION_SINE;
+    StageMotionTarget target = STAGE_MOTION_POSITION;
+    StageMotionTrigger trigger = STAGE_MOTION_ALWAYS;
+
+    DirectX::XMFLOAT3 amp{ 0,0,0 };
+    float freq = 1.0f;      // SINE
+    float phase = 0.0f;     // SINE
+    float period = 1.0f;    // PINGPONG
+    bool loop = false;      // KEYS
+    std::vector<StageMotionKey> keys;
+};
+
+// ̃t[ɃubN𓮂
+struct StageMotionDelta
+{
+    int blockIndex;
+    StageMotionTarget target;
+    DirectX::XMFLOAT3 delta;
+};
+
+void StageMotion_Clear();   // Stage01_LoadJson / Stage01_Clear Ă΂
+void StageMotion_Restart(); // gbN͂̂܂܂ŁAԂƏꂽԂ[hɖ߂iubN͓Ȃj
+int  StageMotion_Add(int blockIndex, const StageMotionDesc& desc);   // ubN̓nhŊo
+bool StageMotion_Find(int blockIndex, StageMotionDesc* outDesc);
+int  StageMotion_GetCount();
+
+// Ԃi߂đSgbN̕ωʂiubN͂܂ȂjB
+// rideBlockivC[ĂubNAȂ -1j ON_RIDE gbN͂œo
+void StageMotion_Evaluate(double elapsedTime, int rideBlock);
+// O Evaluate œubNiω 0 ͓̂̂ȂjBgbN̓o^
+int  StageMotion_GetDeltas(const StageMotionDelta** outDeltas);
+// ωʂ Stage01_AddObjectTransform ŃubNɑiBake  Stage01_FlushBake ł܂Ƃ߂āj
+void StageMotion_Apply();
+
+const char* StageMotion_TypeName(StageMotionType type);
+const char* StageMotion_TargetName(StageMotionTarget target);
+const char* StageMotion_TriggerName(StageMotionTrigger trigger);
+bool StageMotion_ParseType(const char* name, StageMotionType* out);
+bool StageMotion_ParseTarget(const char* name, StageMotionTarget* out);
+bool StageMotion_ParseTrigger(const char* name, StageMotionTrigger* out);
+
+#endif // STAGE_MOTION_H
@@ -30,12 +30,16 @@
 #include"map_camera.h"
 #include"light_camera.h"
 #include"stage01_manage.h"
+#include "trigger_volume.h"
 #include "imgui_manager.h"
 #include "imgui.h"
 #include"item.h"
 #include"sky.h"
+#include "render_queue.h"
+#include "culling.h"
 #include "goal.h"
 #include"Audio.h"
+#include "asset_cache.h"
 #include <vector>
 #include <type_traits>
 #include <utility>
@@ -45,8 +49,13 @@
 
 using namespace DirectX;
 
+static constexpr const char* kBgmPath = "simple.wav";
+static constexpr const wchar_t* kAnimTexPath = L"brickHitEffect.png";
+static AssetHandle g_simpleBgmAsset;
 static int simpleBgm = -1;
 
+// p^[̓Av̏I܂ŎĉŁAeNX`ŏɓǂ񂾂̂
+static AssetHandle g_brickHitTexAsset;
 static int g_brickHitTex = -1;
 static int g_animBrickHitId = -1;
 static int g_playAnimBrickId = -1;
@@ -60,6 +69,19 @@ struct SpinBreakBillboard
 
 static std::vector<SpinBreakBillboard> g_spinBreakBillboardPositions;
 static constexpr double kSpinBreakBillboardLifetime = 1.0;
+static constexpr DirectX::XMFLOAT2 kSpinBreakBillboardScale = { 5.0f, 5.0f };
+static constexpr DirectX::XMFLOAT2 kSpinBreakBillboardPivot = { 0.0f, 2.0f };
+
+// JȂ̂ŁAǂ̌ł܂锠is{bgƉŝ炵 1.0 ܂߂j
+static AABB SpinBreakBillboardBounds(const SpinBreakBillboard& billboard)
+{
+	const float r = 0.5f * std::sqrt(kSpinBreakBillboardScale.x * kSpinBreakBillboardScale.x
+		+ kSpinBreakBillboardScale.y * kSpinBreakBillboardScale.y)
+		+ std::sqrt(kSpinBreakBillboardPivot.x * kSpinBreakBillboardPivot.x
+			+ kSpinBreakBillboardPivot.y * kSpinBreakBillboardPivot.y + 1.0f);
+	const DirectX::XMFLOAT3& p = billboard.position;
+	return { { p.x - r, p.y - r, p.z - r }, { p.x + r, p.y + r, p.z + r } };
+}
 
 static bool g_isDebug = false;
 
@@ -159,6 +181,9 @@ static void lightRendering() {
 	// JɊւsVF[_[ɐݒ肷
 	Camera_SetMatrix(view, proj);
 
+	// e𗎂Ƃ̂̓Cg̎Ő؂
+	Culling_SetView(CULL_VIEW_SHADOW, view, proj, { 0.0f, 0.0f, 0.0f });
+
 	ShaderDepth_SetViewMatrix(view);
 	ShaderDepth_SetProjectionMatrix(proj);
 
@@ -168,6 +193,7 @@ static void lightRendering() {
 	//LXg(e𗎂ƂIuWFNg)
 	//Enemy_DepthDraw();
 	Player_DepthDraw();
+	Stage01_DepthDraw();	// Cg̎ɓubN
 	//Map_Draw();
 }
 
@@ -186,6 +212,21 @@ void StageSimpleManager_AddSpinBreakBillboard(const DirectX::XMFLOAT3& position)
 	g_spinBreakBillboardPositions.push_back({ position, 0.0 });
 }
 
+void StageSimpleManager_CollectAssets(AssetPrefetchList* list)
+{
+	if (!list) return;
+	Player_CollectAssets(list);
+	Sky_CollectAssets(list);
+	Stage01_CollectAssets(list);
+	// Goal_Init ǂނ
+	list->models.push_back("goal.fbx");
+	list->textures.push_back(L"stage_clear.png");
+	list->audio.push_back("clear.wav");
+
+	list->textures.push_back(kAnimTexPath);
+	list->audio.push_back(kBgmPath);
+}
+
 void StageSimpleManager_Initialize(const StageInfo& info)
 {
 	StageSimpleManager_SetStageInfo(info);
@@ -199,12 +240,10 @@ void StageSimpleManager_Initialize(const StageInfo& info)
 	Sky_Initialize();
 	Billboard_Initialize();
 	//BulletHitEffect_Initialize();
-	g_brickHitTex = Texture_Load(L"brickHitEffect.png");
-	g_animBrickHitId = SpriteAnim_RegisterPattern(g_brickHitTex, 10, 10, 0.1, { 140,200 }, { 0,0 }, true);
-	g_playAnimBrickId = SpriteAnim_CreatePlayer(g_animBrickHitId);
-	if (g_brickHitTex < 0)
+	if (!Asset_IsValid(g_brickHitTexAsset))
 		 {
-		g_brickHitTex = Texture_Load(L"brickHitEffect.png");
+		g_brickHitTexAsset = Asset_LoadTexture(kAnimTexPath);
+		g_brickHitTex = Asset_GetTexture(g_brickHitTexAsset);
 		}
 	if (g_animBrickHitId < 0 && g_brickHitTex >= 0)
 		 {
@@ -226,6 +265,7 @@ void StageSimpleManager_Initialize(const StageInfo& info)
 
 	Stage01_Initialize(g_stageJsonPath);
 	Goal_Init();
+	StageSimple_Initialize();
 	Goal_SetPosition({ -30.0f, 15.0f, 187.0f });
 
 	/*Item_Initialize();
@@ -235,7 +275,8 @@ void StageSimpleManager_Initialize(const StageInfo& info)
 	Item_Add({ 2.0f, 1.5f, 2.0f }, { 90.0f, 0.0f, 0.0f }, coinModel);
 	Item_Add({ 0.0f, 0.8f, 0.0f }, { 0.0f, 0.0f, 0.0f }, musicNoteModel);
 	*/
-	simpleBgm = LoadAudio("simple.wav");
+	g_simpleBgmAsset = Asset_LoadAudio(kBgmPath);
+	simpleBgm = Asset_GetAudio(g_simpleBgmAsset);
 	PlayAudio(simpleBgm, true);   // [v
 }
 
@@ -248,7 +289,8 @@ void StageSimpleManager_ChangeStage(const StageInfo& info)
 
 void StageSimpleManager_Finalize()
 {
-	if (simpleBgm >= 0) { UnloadAudio(simpleBgm); simpleBgm = -1; }
+	Asset_Release(&g_simpleBgmAsset);   // ~߂邾B̃Xe[Włg΂̂܂܎c
+	simpleBgm = -1;
 	g_spinBreakBillboardPositions.clear();
 	Goal_Uninit();
 	//BulletHitEffect_Finalize();
@@ -261,6 +303,7 @@ void StageSimpleManager_Finalize()
 
 
 
+	StageSimple_Finalize();
 	Stage01_Finalize();
 	Item_Finalize();
 }
@@ -365,6 +408,9 @@ void StageSimpleManager_Update(double elapsedTime)
 	Player_Update(elapsedTime);
 	PlayerCamera_Update(elapsedTime);
 
+	// S[EACeEȂǂ̗̈i^oƂĂ΂j
+	TriggerVolume_Update(Player_GetAABB());
+
 	Item_Update();
 
 	Goal_Update(elapsedTime);
@@ -435,14 +481,19 @@ void StageSimpleManager_Draw()
 	//JɊւsVF[_ɐݒ肷
 	Camera_SetMatrix(view, proj);
 
+	// Xe[WEACeEr{[h̕`OJO
+	Culling_SetView(CULL_VIEW_CAMERA, view, proj, camera_position, CULL_DEFAULT_DRAW_DISTANCE);
+
 
 	//eNX`Tv[̐ݒ
 	Sampler_SetFilterAnisotropic();
 
+	// ͕`L[ɐςŁAŌɃ\[gĂ܂Ƃ߂ĕ`
+	RenderQueue_Begin();
+	const XMFLOAT3 cameraFront = { mtxView._13, mtxView._23, mtxView._33 };
+
 	//̕\
-	Direct3D_SetDepthDepthWriteDisable();
-	Sky_Draw();
-	Direct3D_SetDepthEnable(true);
+	Sky_Submit();
 
 	//e탉Cg̐ݒ
 	float ambientColor = 0.8f;
@@ -486,8 +537,9 @@ void StageSimpleManager_Draw()
 
 
 	//Enemy_Draw();
-	Player_Draw();
-	Goal_Draw3D();
+	Player_Submit(RenderQueue_ViewDepth(camera_position, cameraFront, Player_GetPosition()));
+	RenderQueue_Submit(RenderQueue_MakeKey(RENDER_PASS_OPAQUE, RENDER_SHADER_NONE, -1, 0.0f),
+		[](const void*, int) { Goal_Draw3D(); }, nullptr, 0, RENDER_CMD_BINDS_OWN_STATE);
 	//Map_Draw();
 
 	//Bullet_Draw();
@@ -500,23 +552,35 @@ void StageSimpleManager_Draw()
 	//BillboardAnim_Draw(g_animPlayId, { -3.0f,2.0f,0.0f }, { 5.0f, 5.0f }, { 0.0f,2.0f });
 	if (g_animBrickHitId >= 0 && !g_spinBreakBillboardPositions.empty())
 		 {
+		const int texId = BillboardAnim_GetTextureId(g_animBrickHitId);
 		for (const auto& billboard : g_spinBreakBillboardPositions)
 			 {
-			BillboardAnim_Draw(g_animBrickHitId, billboard.position, { 5.0f, 5.0f }, { 0.0f,2.0f });
+			if (!Culling_TestViewAABB(CULL_VIEW_CAMERA, SpinBreakBillboardBounds(billboard)))
+				continue;
+			RenderQueue_Submit(RenderQueue_MakeKey(RENDER_PASS_TRANSPARENT, RENDER_SHADER_BILLBOARD, texId,
+				RenderQueue_ViewDepth(camera_position, cameraFront, billboard.position)),
+				[](const void* data, int) {
+					const SpinBreakBillboard* bb = static_cast<const SpinBreakBillboard*>(data);
+					BillboardAnim_DrawBound(g_animBrickHitId, bb->position,
+						kSpinBreakBillboardScale, kSpinBreakBillboardPivot);
+				}, &billboard);
 			}
 		 }
 
 	if (g_isDebug) {
-		Camera_DebugDraw();
+		RenderQueue_Submit(RenderQueue_MakeKey(RENDER_PASS_OVERLAY, RENDER_SHADER_NONE, -1, 0.0f),
+			[](const void*, int) { Camera_DebugDraw(); }, nullptr, 0, RENDER_CMD_BINDS_OWN_STATE);
 	}
 
 
 
 
 
-	Camera_SetMatrix(view, proj);//Kv
-	Stage01_Draw();
-	Item_Draw();
+	Stage01_Submit();
+	Item_Submit(camera_position, cameraFront);
+
+	// fobO\̓I[o[CȂ̂ŁAXe[WɉiȑO Camera_SetMatrix Đݒ͕svj
+	RenderQueue_Execute();
 }
 
 
@@ -15,6 +15,9 @@
 
 //void StageSimpleManager_Initialize();
 void StageSimpleManager_Initialize(const StageInfo& info);
+// Initialize ǂރt@CiStageSystem ŐɃfR[hĂj
+struct AssetPrefetchList;
+void StageSimpleManager_CollectAssets(AssetPrefetchList* list);
 void StageSimpleManager_ChangeStage(const StageInfo& info);
 void StageSimpleManager_Finalize();
 void StageSimpleManager_Update(double elapsedTime);
@@ -13,6 +13,8 @@
 #include "direct3d.h"
 #include"WICTextureLoader11.h"
 #include<string>
+#include<vector>
+#include<mutex>
 
 using namespace DirectX;
 
@@ -26,12 +28,21 @@ struct Texture {
 	ID3D11ShaderResourceView* pTextureView;//VF[_[ANZXł郊\[XieNX`obt@jv\
 	unsigned int width;
 	unsigned int height;
+	int refCount = 0;//Texture_Load ̉񐔁BTexture_Release  0 ɂȂ
 };
 
 
 static Texture g_Textures[TEXTURE_MAX]{};
 static  int g_SetTextureIndex = -1;
 
+// ǂݍ݃XbhŃfR[h܂ōς܂摜BTexture_Load Ȃǂ GPU ɍڂ邾ɂ
+struct PrefetchedImage {
+	std::wstring name;
+	WICDecodedImage image;
+};
+static std::vector<PrefetchedImage> g_Prefetched;
+static std::mutex g_PrefetchMutex;
+
 // ӁIŊOݒ肳́BReleasesvB
 static ID3D11Device* g_pDevice = nullptr;
 static ID3D11DeviceContext* g_pContext = nullptr;
@@ -74,6 +85,7 @@ int Texture_Load(const wchar_t* pFilename)
 	//łɓǂݍ񂾃t@C͓ǂݍ܂Ȃ
 	for (int i = 0;i < TEXTURE_MAX;i++) {
 		if (g_Textures[i].filename == pFilename) {//i͊Ǘԍ
+			g_Textures[i].refCount++;
 			return i;
 		}
 	}
@@ -86,7 +98,11 @@ int Texture_Load(const wchar_t* pFilename)
 		//eNX`̓ǂݍ
 		HRESULT hr;
 
-	    hr = CreateWICTextureFromFile(g_pDevice, g_pContext, pFilename, &g_Textures[i].pTexture, &g_Textures[i].pTextureView);
+		//ŃfR[hĂ΍邾
+		if (Texture_CreatePrefetched(pFilename, &g_Textures[i].pTexture, &g_Textures[i].pTextureView))
+			hr = S_OK;
+		else
+			hr = CreateWICTextureFromFile(g_pDevice, g_pContext, pFilename, &g_Textures[i].pTexture, &g_Textures[i].pTextureView);
 	
 		/*̂悤ɂāAhr ̒gs`FbNĂ܂B
 		*/
@@ -103,6 +119,7 @@ int Texture_Load(const wchar_t* pFilename)
 		
 
 		g_Textures[i].filename = pFilename;
+		g_Textures[i].refCount = 1;
 
 
 		return i;
@@ -110,10 +127,100 @@ int Texture_Load(const wchar_t* pFilename)
 	return -1;
 }
 
+bool Texture_IsLoaded(const wchar_t* pFilename)
+{
+	if (!pFilename)return false;
+	for (const Texture& t : g_Textures) {
+		if (t.pTextureView && t.filename == pFilename)return true;
+	}
+	return false;
+}
+
+static bool IsPrefetched(const std::wstring& name)
+{
+	for (const PrefetchedImage& p : g_Prefetched) {
+		if (p.name == name)return true;
+	}
+	return false;
+}
+
+static void AddPrefetched(const wchar_t* name, WICDecodedImage&& image)
+{
+	std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+	if (IsPrefetched(name))return;
+	g_Prefetched.push_back({ name, std::move(image) });
+}
+
+void Texture_Prefetch(const wchar_t* pFilename)
+{
+	if (!pFilename || !g_pDevice)return;
+	{
+		std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+		if (IsPrefetched(pFilename))return;
+	}
+
+	//ŝ͒uȂiTexture_Load ǂǂŃG[oj
+	WICDecodedImage image;
+	if (FAILED(DecodeWICImageFromFile(g_pDevice, pFilename, image)))return;
+	AddPrefetched(pFilename, std::move(image));
+}
+
+void Texture_PrefetchMemory(const wchar_t* name, const void* data, size_t size)
+{
+	if (!name || !data || !g_pDevice)return;
+	{
+		std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+		if (IsPrefetched(name))return;
+	}
+
+	WICDecodedImage image;
+	if (FAILED(DecodeWICImageFromMemory(g_pDevice, (const uint8_t*)data, size, image)))return;
+	AddPrefetched(name, std::move(image));
+}
+
+bool Texture_CreatePrefetched(const wchar_t* name, ID3D11Resource** ppTexture, ID3D11ShaderResourceView** ppView)
+{
+	if (!name)return false;
+
+	WICDecodedImage image;
+	{
+		std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+		auto it = g_Prefetched.begin();
+		while (it != g_Prefetched.end() && it->name != name) ++it;
+		if (it == g_Prefetched.end())return false;
+		image = std::move(it->image);
+		g_Prefetched.erase(it);
+	}
+
+	return SUCCEEDED(CreateWICTextureFromDecoded(g_pDevice, g_pContext, image, ppTexture, ppView));
+}
+
+void Texture_DiscardPrefetched()
+{
+	std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+	g_Prefetched.clear();
+}
+
+void Texture_Release(int texid)
+{
+	if (texid < 0 || texid >= TEXTURE_MAX)return;
+
+	Texture& t = g_Textures[texid];
+	if (!t.pTextureView)return;
+	if (--t.refCount > 0)return;//܂NgĂ
+
+	t.filename.clear();
+	t.refCount = 0;
+	SAFE_RELEASE(t.pTexture);
+	SAFE_RELEASE(t.pTextureView);
+	if (g_SetTextureIndex == texid) g_SetTextureIndex = -1;
+}
+
 void Texture_AllRelease()
 {
 	for (Texture& t : g_Textures) {
 		t.filename.clear();
+		t.refCount = 0;
 		SAFE_RELEASE(t.pTexture);
 		SAFE_RELEASE(t.pTextureView);
 	}
@@ -141,3 +248,31 @@ unsigned int Texture_Height(int texid)
 	if (texid < 0)return 0;
 	return g_Textures[texid].height;
 }
+
+size_t Texture_GetBytes(int texid)
+{
+	if (texid < 0 || texid >= TEXTURE_MAX)return 0;
+	return Texture_GetViewBytes(g_Textures[texid].pTextureView);
+}
+
+size_t Texture_GetViewBytes(ID3D11ShaderResourceView* pView)
+{
+	if (!pView)return 0;
+
+	ID3D11Resource* pResource = nullptr;
+	pView->GetResource(&pResource);
+	if (!pResource)return 0;
+
+	size_t bytes = 0;
+	D3D11_RESOURCE_DIMENSION dim;
+	pResource->GetType(&dim);
+	if (dim == D3D11_RESOURCE_DIMENSION_TEXTURE2D) {
+		D3D11_TEXTURE2D_DESC desc;
+		((ID3D11Texture2D*)pResource)->GetDesc(&desc);
+		// WIC œǂމ摜͂ق 32bitB~bv 4/3 {ɂȂ
+		bytes = (size_t)desc.Width * desc.Height * 4 * desc.ArraySize;
+		if (desc.MipLevels != 1) bytes = bytes * 4 / 3;
+	}
+	pResource->Release();
+	return bytes;
+}
@@ -13,6 +13,7 @@
 
 
 #include<d3d11.h>
+#include<cstddef>
 
 
 void Texture_Initialize(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
@@ -23,13 +24,28 @@ void Texture_Finalize(void);
 // ߂lFǗԍBǂݍ߂Ȃꍇ-1B
 //
 int Texture_Load(const wchar_t* pFilename);
+// Texture_Load 1 ɂ 1 Bt@Cǂ񂾑S
+void Texture_Release(int texid);
 
 void Texture_AllRelease();
+bool Texture_IsLoaded(const wchar_t* pFilename);
+
+// ɉ摜fR[hĂiǂ̃XbhłjBname ͎oƂ̖O
+// Texture_Load ͓t@Ĉ̂΂ GPU ̃eNX`
+void Texture_Prefetch(const wchar_t* pFilename);
+void Texture_PrefetchMemory(const wchar_t* name, const void* data, size_t size);
+// fR[hς݂̂̂΃eNX` trueiô͏jBCXbh
+bool Texture_CreatePrefetched(const wchar_t* name, ID3D11Resource** ppTexture, ID3D11ShaderResourceView** ppView);
+// gȂ̂̂Ă
+void Texture_DiscardPrefetched();
 
 void Texture_SetTexture(int texid, int slot = 0);
 //eNX`[̕
 unsigned int Texture_Width(int texid);
 unsigned int Texture_Height(int texid);
+//GPU ̂悻̃oCgiAZbg̏풓ʂ̕\pj
+size_t Texture_GetBytes(int texid);
+size_t Texture_GetViewBytes(ID3D11ShaderResourceView* pView);
 
 /*Texture_Initialize(...)FeNX`Ǘ̏BfoCXۑB
 
@@ -41,6 +57,8 @@ Texture_SetTexture(...)
 
 TextureWidth() / TextureHeight()Fǂݍ񂾃eNX`̃TCY擾B
 
+Texture_Release(...)F1 BŌ 1 ŉB
+
 Texture_AllRelease()FSB*/
 
 
@@ -16,9 +16,13 @@
 #include "texture.h"
 #include "debug_text.h"
 #include"Audio.h"
+#include "asset_cache.h"
+#include "staga_system.h"
 
 static int space = -1;
 static int titleBgm = -1;
+static AssetHandle g_spaceAsset;
+static AssetHandle g_titleBgmAsset;
 
 namespace
 {
@@ -55,6 +59,8 @@ namespace
 
     int g_titleLogoTex = -1;
     int g_stageIconTex = -1;
+    AssetHandle g_titleLogoAsset;
+    AssetHandle g_stageIconAsset;
     hal::DebugText* g_titleText = nullptr;
     TitleState g_state = TitleState::Logo;
     int g_selectedStage = 0;
@@ -115,8 +121,10 @@ namespace
 
 void Title_Initialize()
 {
-    g_titleLogoTex = Texture_Load(kTitleLogoPath);
-    g_stageIconTex = Texture_Load(kStageIconPath);
+    g_titleLogoAsset = Asset_LoadTexture(kTitleLogoPath);
+    g_stageIconAsset = Asset_LoadTexture(kStageIconPath);
+    g_titleLogoTex = Asset_GetTexture(g_titleLogoAsset);
+    g_stageIconTex = Asset_GetTexture(g_stageIconAsset);
     g_state = TitleState::Logo;
     g_selectedStage = 0;
     g_prevPadA = false;
@@ -129,8 +137,10 @@ void Title_Initialize()
     g_finished = false;
     g_selectedStage = 0;
 
-    titleBgm = LoadAudio("title.wav");
-    space = Texture_Load(L"space1.png");
+    g_titleBgmAsset = Asset_LoadAudio("title.wav");
+    titleBgm = Asset_GetAudio(g_titleBgmAsset);
+    g_spaceAsset = Asset_LoadTexture(L"space1.png");
+    space = Asset_GetTexture(g_spaceAsset);
 
     const float screenW = (float)Direct3D_GetBackBufferWidth();
     const float screenH = (float)Direct3D_GetBackBufferHeight();
@@ -153,7 +163,16 @@ void Title_Finalize()
 {
     delete g_titleText;
     g_titleText = nullptr;
-    UnloadAudio(titleBgm);
+
+    // ͎̂̉ʂ̏̌iAsset_CollectUnusedjB̂gΓǂݒȂ
+    Asset_Release(&g_titleBgmAsset);
+    Asset_Release(&g_spaceAsset);
+    Asset_Release(&g_titleLogoAsset);
+    Asset_Release(&g_stageIconAsset);
+    titleBgm = -1;
+    space = -1;
+    g_titleLogoTex = -1;
+    g_stageIconTex = -1;
 }
 
 void Title_Update(double elapsed_time)
@@ -161,6 +180,10 @@ void Title_Update(double elapsed_time)
     
     angle += 1.0f * (float)elapsed_time;
 
+    // 肵Ƃ̓Xe[WǂݏI܂ő҂
+    if (g_finished)
+        return;
+
     GamepadState pad{};
     const bool padConnected = Gamepad_GetState(0, &pad);
 
@@ -229,7 +252,7 @@ void Title_Update(double elapsed_time)
     // ---- StageSelect:  ----
     if (padBTrigger || enterTrigger)
     {
-        UnloadAudio(titleBgm);
+        StopAudio(titleBgm);
         g_finished = true;
     }
 }
@@ -259,7 +282,11 @@ void Title_Draw()
 
     if (g_titleText)
     {
-        if (g_state == TitleState::Logo)
+        if (g_finished && StageSystem_IsLoading())
+        {
+            g_titleText->SetText("Now Loading...", { 1.0f, 1.0f, 1.0f, 1.0f });
+        }
+        else if (g_state == TitleState::Logo)
         {
             g_titleText->SetText("Press B or Enter", { 1.0f, 1.0f, 1.0f, 1.0f });
         }
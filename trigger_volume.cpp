@@ -0,0 +1,227 @@
+/*==============================================================================
+
+@@  gK[̈[trigger_volume.cpp]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/14
+--------------------------------------------------------------------------------
+
+==============================================================================*/
+#include "trigger_volume.h"
+#include <vector>
+#include <algorithm>
+
+using namespace DirectX;
+
+namespace
+{
+    // ɍLʂc[ɓ̂ŁA点ĂӂȂ傫Ŏ~߂
+    constexpr float TRIGGER_FAR = 1.0e6f;
+
+    struct Volume
+    {
+        AABB aabb{};
+        unsigned int layer = 0;
+        TriggerFunc onEnter = nullptr;
+        TriggerFunc onStay = nullptr;
+        TriggerFunc onExit = nullptr;
+        void* user = nullptr;
+
+        int proxy = -1;             // -1 Ȃ󂫃Xbg
+        unsigned int serial = 0;    // Add ƂɕςiXbgւ̃CxĝĂj
+        bool inside = false;        // O Update  actor ƏdȂĂ
+    };
+
+    struct PendingEvent
+    {
+        int volume;
+        unsigned int serial;
+        TriggerEvent ev;
+    };
+
+    std::vector<Volume> g_volumes;
+    std::vector<int> g_freeSlots;
+    int g_volumeCount = 0;
+    unsigned int g_serial = 0;
+
+    // Xe[W g_movingTree Ƃ͕ʁi蒼̃^C~Oƒg̔ԍႤBtrigger_volume.hj
+    DynamicAABBTree g_tree(0.5f);
+
+    std::vector<int> g_inside;      // O񒆂ɂ̈
+    std::vector<int> g_hits;        // dȂ̈
+    std::vector<unsigned int> g_hitMark;
+    unsigned int g_hitStamp = 0;
+    std::vector<PendingEvent> g_events;
+
+    AABB ClampFar(const AABB& a)
+    {
+        AABB r;
+        r.min = { (std::max)(a.min.x, -TRIGGER_FAR), (std::max)(a.min.y, -TRIGGER_FAR), (std::max)(a.min.z, -TRIGGER_FAR) };
+        r.max = { (std::min)(a.max.x, TRIGGER_FAR), (std::min)(a.max.y, TRIGGER_FAR), (std::min)(a.max.z, TRIGGER_FAR) };
+        return r;
+    }
+
+    bool IsAlive(int volume)
+    {
+        return volume >= 0 && volume < (int)g_volumes.size() && g_volumes[volume].proxy >= 0;
+    }
+
+    TriggerFunc FuncOf(const Volume& v, TriggerEvent ev)
+    {
+        switch (ev)
+        {
+        case TRIGGER_ENTER: return v.onEnter;
+        case TRIGGER_STAY:  return v.onStay;
+        case TRIGGER_EXIT:  return v.onExit;
+        }
+        return nullptr;
+    }
+}
+
+int TriggerVolume_Add(const TriggerVolumeDesc& desc)
+{
+    int slot;
+    if (!g_freeSlots.empty())
+    {
+        slot = g_freeSlots.back();
+        g_freeSlots.pop_back();
+    }
+    else
+    {
+        slot = (int)g_volumes.size();
+        g_volumes.emplace_back();
+        g_hitMark.push_back(0);
+    }
+
+    Volume& v = g_volumes[slot];
+    v.aabb = ClampFar(desc.aabb);
+    v.layer = desc.layer;
+    v.onEnter = desc.onEnter;
+    v.onStay = desc.onStay;
+    v.onExit = desc.onExit;
+    v.user = desc.user;
+    v.serial = ++g_serial;
+    v.inside = false;
+    v.proxy = g_tree.CreateProxy(v.aabb, slot);
+
+    ++g_volumeCount;
+    return slot;
+}
+
+void TriggerVolume_Remove(int volume)
+{
+    if (!IsAlive(volume)) return;
+
+    Volume& v = g_volumes[volume];
+    g_tree.DestroyProxy(v.proxy);
+    v.proxy = -1;
+    v.onEnter = v.onStay = v.onExit = nullptr;
+    v.user = nullptr;
+
+    if (v.inside)
+    {
+        v.inside = false;
+        for (size_t k = 0; k < g_inside.size(); ++k)
+        {
+            if (g_inside[k] != volume) continue;
+            g_inside[k] = g_inside.back();
+            g_inside.pop_back();
+            break;
+        }
+    }
+
+    g_freeSlots.push_back(volume);
+    --g_volumeCount;
+}
+
+void TriggerVolume_SetAABB(int volume, const AABB& aabb)
+{
+    if (!IsAlive(volume)) return;
+
+    Volume& v = g_volumes[volume];
+    const AABB next = ClampFar(aabb);
+    const XMFLOAT3 displacement{
+        (next.min.x + next.max.x - v.aabb.min.x - v.aabb.max.x) * 0.5f,
+        (next.min.y + next.max.y - v.aabb.min.y - v.aabb.max.y) * 0.5f,
+        (next.min.z + next.max.z - v.aabb.min.z - v.aabb.max.z) * 0.5f
+    };
+    v.aabb = next;
+    g_tree.MoveProxy(v.proxy, v.aabb, displacement);
+}
+
+void TriggerVolume_Clear()
+{
+    g_volumes.clear();
+    g_freeSlots.clear();
+    g_tree.Clear();
+    g_inside.clear();
+    g_hits.clear();
+    g_hitMark.clear();
+    g_events.clear();
+    g_volumeCount = 0;
+}
+
+int TriggerVolume_GetCount()
+{
+    return g_volumeCount;
+}
+
+void TriggerVolume_Update(const AABB& actor, unsigned int mask)
+{
+    if (g_volumeCount == 0 && g_inside.empty()) return;
+
+    // dȂĂ̈ic[͑Ȃ̂Ŗ{̔Ŕ肵j
+    ++g_hitStamp;
+    g_hits.clear();
+    g_tree.Query(actor, [&](int slot)
+        {
+            const Volume& v = g_volumes[slot];
+            if ((v.layer & mask) && Collision_IsOverlapAABB(actor, v.aabb))
+            {
+                g_hits.push_back(slot);
+                g_hitMark[slot] = g_hitStamp;
+            }
+            return true;
+        });
+
+    // ɃCxgS߂ďԂXVĂĂԁiR[obNőĂ悢悤Ɂj
+    g_events.clear();
+    for (int slot : g_inside)
+    {
+        Volume& v = g_volumes[slot];
+        if (g_hitMark[slot] == g_hitStamp)
+        {
+            g_events.push_back({ slot, v.serial, TRIGGER_STAY });
+        }
+        else
+        {
+            v.inside = false;
+            g_events.push_back({ slot, v.serial, TRIGGER_EXIT });
+        }
+    }
+    for (int slot : g_hits)
+    {
+        Volume& v = g_volumes[slot];
+        if (v.inside) continue;
+        v.inside = true;
+        g_events.push_back({ slot, v.serial, TRIGGER_ENTER });
+    }
+    g_inside.swap(g_hits);
+
+    for (size_t k = 0; k < g_events.size(); ++k)
+    {
+        const PendingEvent e = g_events[k];
+        if (!IsAlive(e.volume) || g_volumes[e.volume].serial != e.serial) continue;
+
+        const Volume& v = g_volumes[e.volume];
+        TriggerFunc func = FuncOf(v, e.ev);
+        if (func) func(e.volume, e.ev, v.user);
+    }
+}
+
+AABB TriggerVolume_BelowY(float y)
+{
+    AABB r;
+    r.min = { -TRIGGER_FAR, -TRIGGER_FAR, -TRIGGER_FAR };
+    r.max = { TRIGGER_FAR, y, TRIGGER_FAR };
+    return r;
+}
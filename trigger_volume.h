@@ -0,0 +1,63 @@
+/*==============================================================================
+
+@@  gK[̈[trigger_volume.h]
+                                                         Author : Kouki Tanaka
+                                                         Date   : 2026/02/14
+--------------------------------------------------------------------------------
+@@S[EACeEE}O}Ȃǁu牽Nv̈B
+@@o^ 1 񂾂ŁAt[ TriggerVolume_Update IAABBc[
+@@iXe[W̓ubNƓ DynamicAABBTreejŃvC[̋߂
+@@ׂB^oƂ onEnter / onExit ĂԁionStay ͒ɂԖjB
+@@c[̓Xe[W̃u[htF[YƂ͕ʂɎBXe[W͓ǂݍ݂
+@@GfB^̕ҏŴтɍ蒼Ag̓ubN̔ԍȂ̂ŁA
+@@S[ACeo^̈ƏAubN̔
+@@肷BE}O}̗̈ }1e6 ܂ōL̂ŁAc[
+@@ubNւ̖₢킹i1 t[ɉxĂ΂j񂻂ʂ邱ƂɂȂB
+==============================================================================*/
+#ifndef TRIGGER_VOLUME_H
+#define TRIGGER_VOLUME_H
+
+#include "collision.h"
+
+enum TriggerLayer : unsigned int
+{
+    TRIGGER_LAYER_GOAL   = 1u << 0,
+    TRIGGER_LAYER_ITEM   = 1u << 1,
+    TRIGGER_LAYER_HAZARD = 1u << 2,     // }O}EȂ
+    TRIGGER_LAYER_ALL    = 0xffffffffu,
+};
+
+enum TriggerEvent : int
+{
+    TRIGGER_ENTER = 0,
+    TRIGGER_STAY,
+    TRIGGER_EXIT,
+};
+
+// volume  TriggerVolume_Add ̖߂lBR[obN̒ Add / Remove / SetAABB Ă悢
+typedef void (*TriggerFunc)(int volume, TriggerEvent ev, void* user);
+
+struct TriggerVolumeDesc
+{
+    AABB aabb{};
+    unsigned int layer = TRIGGER_LAYER_ALL;
+    TriggerFunc onEnter = nullptr;
+    TriggerFunc onStay = nullptr;
+    TriggerFunc onExit = nullptr;
+    void* user = nullptr;
+};
+
+int  TriggerVolume_Add(const TriggerVolumeDesc& desc);     // s -1
+void TriggerVolume_Remove(int volume);                     // ɂĂ onExit ͌Ă΂Ȃ
+void TriggerVolume_SetAABB(int volume, const AABB& aabb);  // ̈iS[̈ړE}O}̏㏸j
+void TriggerVolume_Clear();
+int  TriggerVolume_GetCount();
+
+// actorivC[ AABBjƏdȂ̈̂ layer & mask Ă̂ɂ
+// OƂ̍ŃCxgoB1 t[ 1 
+void TriggerVolume_Update(const AABB& actor, unsigned int mask = TRIGGER_LAYER_ALL);
+
+// y 艺SiE}O}pjBCollision_IsOverlapAABB Łu < yvƓ
+AABB TriggerVolume_BelowY(float y);
+
+#endif // TRIGGER_VOLUME_H